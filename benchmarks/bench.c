@@ -0,0 +1,557 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif /* __linux__ */
+#include "easyqueue.h"
+
+#ifndef EZQ_BENCH_VERSION
+ #define EZQ_BENCH_VERSION "unknown"
+#endif /* EZQ_BENCH_VERSION */
+
+/* Number of queue operations each scenario performs unless told otherwise. */
+#define BENCH_DEFAULT_OPS (10000000UL)
+
+/* Number of items queued at once by the overflow-heavy scenario. */
+#define BENCH_OVERFLOW_DEPTH (EZQ_FIXED_BUFFER_CAPACITY * 4)
+
+/* Largest number of items pushed by a single burst. */
+#define BENCH_MAX_BURST (EZQ_FIXED_BUFFER_CAPACITY * 4)
+
+/* Number of hardware counters read around each scenario. */
+#define BENCH_COUNTER_COUNT (4)
+
+#define PRINT_FAILURE(func_name, status) \
+    do { \
+        fprintf( \
+            stderr, \
+            "[!] " #func_name "() failed with status==%u\n", \
+            (unsigned int)(status) \
+        ); \
+    } while (0)
+
+/*!
+ * @struct bench_scenario
+ * @brief Structure describing one pattern of queue operations to time.
+ */
+struct bench_scenario
+{
+    const char *p_name; /* name reported in the results */
+    unsigned int capacity; /* capacity given to ezq_init; 0 means no limit */
+
+    /* function performing about ops operations on an empty queue */
+    unsigned long (*run_fn)(
+        ezq_queue *p_queue,
+        unsigned long ops,
+        ezq_status *p_status
+    );
+};
+
+/*!
+ * @struct bench_counters
+ * @brief Structure holding the hardware counters read around a scenario.
+ * Counters that cannot be read (e.g. without permission, or off Linux) are
+ * reported as \c null .
+ */
+struct bench_counters
+{
+    int fds[BENCH_COUNTER_COUNT]; /* perf_event_open descriptors, or -1 */
+    int counted[BENCH_COUNTER_COUNT]; /* non-zero if values was read */
+    unsigned long long values[BENCH_COUNTER_COUNT]; /* last readings */
+};
+
+/* Names under which each hardware counter is reported, per operation. */
+static const char * const bench_counter_names[BENCH_COUNTER_COUNT] =
+{
+    "instructions_per_op",
+    "cycles_per_op",
+    "cache_misses_per_op",
+    "branch_misses_per_op"
+};
+
+#if defined(__linux__)
+/* Generalized hardware events read for each counter, in the same order. */
+static const unsigned long long bench_counter_events[BENCH_COUNTER_COUNT] =
+{
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+#endif /* __linux__ */
+
+/* Receives every popped item so that the work cannot be optimized away. */
+static void * volatile g_sink;
+
+/*!
+ * @brief Repeatedly fills the fixed-size buffer and empties it again, so
+ * that no item is ever placed in the linked list.
+ *
+ * @param[in,out] p_queue Address of an empty \c ezq_queue to operate on.
+ * @param[in] ops Number of operations to perform, rounded up to a whole
+ * number of fills.
+ * @param[out] p_status Address in which to place \c EZQ_STATUS_SUCCESS if
+ * every operation succeeds, otherwise the status of the first that failed.
+ *
+ * @return The number of operations performed.
+ */
+static unsigned long
+bench_fixed_only(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+);
+
+/*!
+ * @brief Repeatedly queues \c BENCH_OVERFLOW_DEPTH items and removes them
+ * again, so that most items pass through the linked list.
+ *
+ * @param[in,out] p_queue Address of an empty \c ezq_queue to operate on.
+ * @param[in] ops Number of operations to perform, rounded up to a whole
+ * number of fills.
+ * @param[out] p_status Address in which to place \c EZQ_STATUS_SUCCESS if
+ * every operation succeeds, otherwise the status of the first that failed.
+ *
+ * @return The number of operations performed.
+ */
+static unsigned long
+bench_overflow_heavy(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+);
+
+/*!
+ * @brief Fills a queue bounded to its fixed-size buffer, then alternately
+ * pops and pushes one item so that it stays at capacity.
+ *
+ * @param[in,out] p_queue Address of an empty \c ezq_queue to operate on.
+ * @param[in] ops Number of operations to perform before the queue is
+ * drained, which adds as many pops as it holds.
+ * @param[out] p_status Address in which to place \c EZQ_STATUS_SUCCESS if
+ * every operation succeeds, otherwise the status of the first that failed.
+ *
+ * @return The number of operations performed.
+ */
+static unsigned long
+bench_steady_at_capacity(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+);
+
+/*!
+ * @brief Pushes bursts of between one and \c BENCH_MAX_BURST items, of
+ * pseudo-random size, each of which is drained before the next.
+ *
+ * @param[in,out] p_queue Address of an empty \c ezq_queue to operate on.
+ * @param[in] ops Number of operations to perform, rounded up to a whole
+ * number of bursts.
+ * @param[out] p_status Address in which to place \c EZQ_STATUS_SUCCESS if
+ * every operation succeeds, otherwise the status of the first that failed.
+ *
+ * @return The number of operations performed.
+ */
+static unsigned long
+bench_burst(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+);
+
+/*!
+ * @brief Opens and starts whichever hardware counters are available.
+ *
+ * @param[out] p_counters Address of the counters to start.
+ */
+static void
+bench_counters_start(struct bench_counters *p_counters);
+
+/*!
+ * @brief Stops and reads the counters started by \c bench_counters_start ,
+ * closing their descriptors.
+ *
+ * @param[in,out] p_counters Address of the counters to stop.
+ */
+static void
+bench_counters_stop(struct bench_counters *p_counters);
+
+/*!
+ * @brief Gets the current reading of the monotonic clock.
+ *
+ * @return The monotonic time in nanoseconds.
+ */
+static double
+bench_now_ns(void);
+
+/* Patterns of operations timed by the benchmark, in the order reported. */
+static const struct bench_scenario bench_scenarios[] =
+{
+    { "fixed_only", 0, bench_fixed_only },
+    { "overflow_heavy", 0, bench_overflow_heavy },
+    {
+        "steady_at_capacity",
+        EZQ_FIXED_BUFFER_CAPACITY,
+        bench_steady_at_capacity
+    },
+    { "burst", 0, bench_burst }
+};
+
+int
+main(int argc, char **argv)
+{
+    ezq_status estat = EZQ_STATUS_SUCCESS;
+    ezq_queue queue = { 0 };
+    struct bench_counters counters;
+    unsigned long ops = BENCH_DEFAULT_OPS;
+    unsigned long done_ops = 0;
+    double start = 0.0;
+    double elapsed = 0.0;
+    size_t i = 0;
+    size_t j = 0;
+
+    /* The number of operations per scenario may be given as an argument. */
+    if (argc > 1)
+    {
+        ops = strtoul(argv[1], NULL, 10);
+        if (ops < 1)
+        {
+            fprintf(stderr, "usage: %s [operations per scenario]\n", argv[0]);
+            estat = EZQ_STATUS_UNKNOWN;
+            goto done;
+        }
+    }
+
+    printf("{\n");
+    printf("  \"library\": \"easyqueue\",\n");
+    printf("  \"version\": \"%s\",\n", EZQ_BENCH_VERSION);
+    printf(
+        "  \"fixed_buffer_capacity\": %u,\n",
+        (unsigned int)EZQ_FIXED_BUFFER_CAPACITY
+    );
+    printf(
+        "  \"list_node_capacity\": %u,\n",
+        (unsigned int)EZQ_LIST_NODE_CAPACITY
+    );
+    printf("  \"results\": [");
+    for (i = 0; i < sizeof(bench_scenarios) / sizeof(*bench_scenarios); ++i)
+    {
+        estat = ezq_init(&queue, bench_scenarios[i].capacity, malloc, free);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            PRINT_FAILURE(ezq_init, estat);
+            goto done;
+        }
+
+        /* Warm the caches and the queue's node cache before timing. The
+         * scenarios round up to whole rounds, so results are per operation
+         * actually performed.
+         * */
+        (void)bench_scenarios[i].run_fn(&queue, ops / 10 + 1, &estat);
+        if (EZQ_STATUS_SUCCESS == estat)
+        {
+            bench_counters_start(&counters);
+            start = bench_now_ns();
+            done_ops = bench_scenarios[i].run_fn(&queue, ops, &estat);
+            elapsed = bench_now_ns() - start;
+            bench_counters_stop(&counters);
+        }
+        (void)ezq_destroy(&queue, NULL, NULL);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            fprintf(
+                stderr,
+                "[!] scenario %s failed with status==%u\n",
+                bench_scenarios[i].p_name,
+                (unsigned int)estat
+            );
+            goto done;
+        }
+
+        printf("%s\n    {\n", 0 == i ? "" : ",");
+        printf("      \"scenario\": \"%s\",\n", bench_scenarios[i].p_name);
+        printf("      \"ops\": %lu,\n", done_ops);
+        printf("      \"ns_per_op\": %.3f,\n", elapsed / (double)done_ops);
+        printf(
+            "      \"ops_per_sec\": %.0f",
+            elapsed > 0.0 ? (double)done_ops * 1e9 / elapsed : 0.0
+        );
+        for (j = 0; j < BENCH_COUNTER_COUNT; ++j)
+        {
+            if (!counters.counted[j])
+            {
+                printf(",\n      \"%s\": null", bench_counter_names[j]);
+            }
+            else
+            {
+                printf(
+                    ",\n      \"%s\": %.3f",
+                    bench_counter_names[j],
+                    (double)counters.values[j] / (double)done_ops
+                );
+            }
+        }
+        printf("\n    }");
+    }
+    printf("\n  ]\n}\n");
+
+done:
+    return EZQ_STATUS_SUCCESS == estat ? EXIT_SUCCESS : (int)estat;
+} /* main */
+
+static unsigned long
+bench_fixed_only(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_SUCCESS;
+    void *p_item = NULL;
+    unsigned long done_ops = 0;
+    unsigned int i = 0;
+
+    while (done_ops < ops)
+    {
+        for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+        {
+            estat = ezq_push(p_queue, (void *)&g_sink);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            ++done_ops;
+        }
+        for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+        {
+            estat = ezq_pop(p_queue, &p_item);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            g_sink = p_item;
+            ++done_ops;
+        }
+    }
+
+done:
+    *p_status = estat;
+    return done_ops;
+} /* bench_fixed_only */
+
+static unsigned long
+bench_overflow_heavy(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_SUCCESS;
+    void *p_item = NULL;
+    unsigned long done_ops = 0;
+    unsigned int i = 0;
+
+    while (done_ops < ops)
+    {
+        for (i = 0; i < BENCH_OVERFLOW_DEPTH; ++i)
+        {
+            estat = ezq_push(p_queue, (void *)&g_sink);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            ++done_ops;
+        }
+        for (i = 0; i < BENCH_OVERFLOW_DEPTH; ++i)
+        {
+            estat = ezq_pop(p_queue, &p_item);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            g_sink = p_item;
+            ++done_ops;
+        }
+    }
+
+done:
+    *p_status = estat;
+    return done_ops;
+} /* bench_overflow_heavy */
+
+static unsigned long
+bench_steady_at_capacity(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_SUCCESS;
+    void *p_item = NULL;
+    unsigned long done_ops = 0;
+    unsigned int i = 0;
+
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(p_queue, (void *)&g_sink);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+        ++done_ops;
+    }
+
+    /* Every push refills the slot freed by the pop before it. */
+    while (done_ops < ops)
+    {
+        estat = ezq_pop(p_queue, &p_item);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+        g_sink = p_item;
+        estat = ezq_push(p_queue, p_item);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+        done_ops += 2;
+    }
+
+    while (EZQ_STATUS_SUCCESS == ezq_pop(p_queue, &p_item))
+    {
+        g_sink = p_item;
+        ++done_ops;
+    }
+
+done:
+    *p_status = estat;
+    return done_ops;
+} /* bench_steady_at_capacity */
+
+static unsigned long
+bench_burst(
+    ezq_queue *p_queue,
+    unsigned long ops,
+    ezq_status *p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_SUCCESS;
+    void *p_item = NULL;
+    unsigned long done_ops = 0;
+    unsigned long seed = 1;
+    unsigned int burst = 0;
+    unsigned int i = 0;
+
+    while (done_ops < ops)
+    {
+        /* A fixed linear congruential sequence keeps runs comparable. */
+        seed = seed * 1103515245UL + 12345UL;
+        burst = 1 + (unsigned int)((seed >> 16) % BENCH_MAX_BURST);
+
+        for (i = 0; i < burst; ++i)
+        {
+            estat = ezq_push(p_queue, (void *)&g_sink);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            ++done_ops;
+        }
+        for (i = 0; i < burst; ++i)
+        {
+            estat = ezq_pop(p_queue, &p_item);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            g_sink = p_item;
+            ++done_ops;
+        }
+    }
+
+done:
+    *p_status = estat;
+    return done_ops;
+} /* bench_burst */
+
+static void
+bench_counters_start(struct bench_counters *p_counters)
+{
+    size_t i = 0;
+#if defined(__linux__)
+    struct perf_event_attr attr;
+#endif /* __linux__ */
+
+    for (i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        p_counters->fds[i] = -1;
+        p_counters->counted[i] = 0;
+        p_counters->values[i] = 0;
+#if defined(__linux__)
+        /* Count user-space events of this thread only, which needs no
+         * privileges under the default perf_event_paranoid setting.
+         * */
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = bench_counter_events[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        p_counters->fds[i] = (int)syscall(
+            SYS_perf_event_open,
+            &attr,
+            0,
+            -1,
+            -1,
+            0UL
+        );
+        if (p_counters->fds[i] >= 0)
+        {
+            (void)ioctl(p_counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            (void)ioctl(p_counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif /* __linux__ */
+    }
+} /* bench_counters_start */
+
+static void
+bench_counters_stop(struct bench_counters *p_counters)
+{
+    size_t i = 0;
+
+    for (i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+#if defined(__linux__)
+        if (p_counters->fds[i] >= 0)
+        {
+            (void)ioctl(p_counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            p_counters->counted[i] = read(
+                p_counters->fds[i],
+                &p_counters->values[i],
+                sizeof(p_counters->values[i])
+            ) == (ssize_t)sizeof(p_counters->values[i]);
+            (void)close(p_counters->fds[i]);
+            p_counters->fds[i] = -1;
+        }
+#else
+        p_counters->counted[i] = 0;
+#endif /* __linux__ */
+    }
+} /* bench_counters_stop */
+
+static double
+bench_now_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+} /* bench_now_ns */
@@ -17,9 +17,59 @@
  #error "Value of EZQ_FIXED_BUFFER_CAPACITY must be a positive integer"
 #endif /* EZQ_FIXED_BUFFER_CAPACITY < 1 */
 
+#ifndef EZQ_LIST_NODE_CAPACITY
+ /*
+  * The number of items stored in each dynamically allocated linked list
+  * node once the fixed-size buffer is full.
+  */
+ #define EZQ_LIST_NODE_CAPACITY (16)
+#endif /* EZQ_LIST_NODE_CAPACITY */
+#if EZQ_LIST_NODE_CAPACITY < 1
+ #error "Value of EZQ_LIST_NODE_CAPACITY must be a positive integer"
+#endif /* EZQ_LIST_NODE_CAPACITY < 1 */
+
+#ifndef EZQ_DEFAULT_NODE_CACHE_LIMIT
+ /*
+  * The default maximum number of retired linked list nodes a queue keeps
+  * for reuse instead of releasing them via its \c free_fn .
+  */
+ #define EZQ_DEFAULT_NODE_CACHE_LIMIT (32)
+#endif /* EZQ_DEFAULT_NODE_CACHE_LIMIT */
+
+#ifndef EZQ_CACHE_LINE_SIZE
+ /*
+  * The assumed size, in bytes, of a CPU cache line. Fields of the
+  * concurrent queue variants written by different threads are kept this
+  * far apart to avoid false sharing.
+  */
+ #define EZQ_CACHE_LINE_SIZE (64)
+#endif /* EZQ_CACHE_LINE_SIZE */
+
+/*
+ * Gets the address of the structure of type \c type whose member \c member
+ * is pointed to by \c p_member . Used to recover a caller's structure from
+ * a node embedded in it by the intrusive queue variants.
+ */
+#define EZQ_CONTAINER_OF(p_member, type, member) \
+    ((type *)(void *)((char *)(p_member) - offsetof(type, member)))
+
+/* Flag set on queues initialized by ezq_init_growable(). */
+#define EZQ_FLAG_GROWABLE (0x01u)
+
+/* Flag set on growable queues whose buffer shrinks at low occupancy. */
+#define EZQ_FLAG_SHRINK (0x02u)
+
+/* Flag set on queues whose buffer was provided by ezq_init_buffer(). */
+#define EZQ_FLAG_CALLER_SLOTS (0x04u)
+
+/* Flag set on queues made to pop their most recent item by ezq_set_lifo(). */
+#define EZQ_FLAG_LIFO (0x08u)
+
 /*!
  * @struct ezq_buffer
- * @brief Structure encapsulating a simple rotating buffer.
+ * @brief Structure encapsulating a simple rotating buffer. Items are kept in
+ * \c p_items unless the buffer has been grown or was provided by the caller,
+ * in which case they are kept in \c p_slots instead.
  *
  * @note This structure is exposed in the header to avoid necessitating that
  * instances of it be dynamically allocated, but this structure is not
@@ -28,14 +78,17 @@
 struct ezq_buffer
 {
     void *p_items[EZQ_FIXED_BUFFER_CAPACITY]; /* array of items */
-    unsigned int front_index; /* index of the front item of the buffer */
+    void **p_slots; /* grown or caller array replacing p_items, or NULL */
+    unsigned int slot_capacity; /* number of items p_slots can hold */
+    unsigned int front_index; /* position of the front item of the buffer */
     unsigned int count; /* number of items currently in the buffer */
 };
 
 /*!
  * @struct ezq_linkedlist_node
  * @brief Structure encapsulating a node for use with \c ezq_linkedlist
- * instances.
+ * instances. Each node holds a contiguous block of up to
+ * \c EZQ_LIST_NODE_CAPACITY items.
  *
  * @note This structure is exposed in the header to avoid necessitating that
  * instances of it be dynamically allocated, but this structure is not
@@ -43,14 +96,18 @@ struct ezq_buffer
  */
 struct ezq_linkedlist_node
 {
-    void * p_item; /* data in the list */
+    void * p_items[EZQ_LIST_NODE_CAPACITY]; /* block of items */
+    unsigned int front_index; /* index of the front item of the block */
+    unsigned int count; /* number of items currently in the block */
     struct ezq_linkedlist_node * p_next; /* next node in the list */
+    struct ezq_linkedlist_node * p_prev; /* previous node in the list */
 };
 
 /*!
  * @struct ezq_linkedlist
- * @brief Structure encapsulating a simple singly-linked list implementation
- * for use as the dynamic storage portion of an \c ezq_queue .
+ * @brief Structure encapsulating a simple doubly-linked list implementation
+ * for use as the dynamic storage portion of an \c ezq_queue . Nodes are
+ * linked both ways so that items can be taken from either end.
  *
  * @note This structure is exposed in the header to avoid necessitating that
  * instances of it be dynamically allocated, but this structure is not
@@ -60,9 +117,167 @@ struct ezq_linkedlist
 {
     struct ezq_linkedlist_node * p_head; /* front node of the list */
     struct ezq_linkedlist_node * p_tail; /* rear node of the list */
-    unsigned int count; /* number of nodes in the list */
+    unsigned int count; /* number of items across all nodes in the list */
 };
 
+/*!
+ * @struct ezq_nodecache
+ * @brief Structure encapsulating a bounded stack of retired
+ * \c ezq_linkedlist_node instances that may be reused by an \c ezq_queue
+ * before it resorts to dynamic allocation.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_nodecache
+{
+    struct ezq_linkedlist_node * p_top; /* most recently retired node */
+    unsigned int count; /* number of nodes currently cached */
+    unsigned int limit; /* maximum number of nodes that may be cached */
+};
+
+/*!
+ * @struct ezq_link
+ * @brief Structure linking an item into an \c ezq_queue via \c ezq_ipush .
+ * Callers embed one in each of their own items and recover the item from a
+ * popped link with \c EZQ_CONTAINER_OF , so the queue never allocates to
+ * hold it.
+ *
+ * @note A link may only be in one queue at a time, and must remain valid
+ * until it has been popped.
+ */
+struct ezq_link
+{
+    struct ezq_link * p_next; /* next link in the chain */
+};
+
+/*!
+ * @struct ezq_linkchain
+ * @brief Structure encapsulating a chain of caller-embedded \c ezq_link
+ * instances holding the items of an intrusive \c ezq_queue that did not
+ * fit in its buffer.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_linkchain
+{
+    struct ezq_link * p_head; /* front link of the chain */
+    struct ezq_link * p_tail; /* rear link of the chain */
+    unsigned int count; /* number of links in the chain */
+};
+
+#ifdef EZQ_ENABLE_STATS
+/*!
+ * @struct ezq_stats
+ * @brief Structure holding the counters an \c ezq_queue keeps when built
+ * with \c EZQ_ENABLE_STATS defined. A queue is above its fixed capacity
+ * whenever it holds more items than fit in its fixed-size (or
+ * caller-provided) buffer.
+ */
+struct ezq_stats
+{
+    unsigned long pushes; /* number of items placed in the queue */
+    unsigned long pops; /* number of items taken from the queue */
+    unsigned long full_rejections; /* pushes refused as the queue was full */
+    unsigned long overflow_allocs; /* allocations of nodes or grown buffers */
+    unsigned long alloc_failures; /* allocations that failed */
+    unsigned long spills; /* times the queue went above its fixed capacity */
+    unsigned long spill_ticks; /* clock ticks spent above fixed capacity */
+    unsigned int depth; /* number of items currently in the queue */
+    unsigned int high_water; /* greatest number of items held at once */
+};
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+ #ifndef EZQ_SOJOURN_STAMPS
+  /*
+   * The number of queued items a queue can hold timestamps for at once.
+   * Items pushed while this many are stamped are not timed.
+   */
+  #define EZQ_SOJOURN_STAMPS (64)
+ #endif /* EZQ_SOJOURN_STAMPS */
+ #if EZQ_SOJOURN_STAMPS < 1 \
+    || 0 != (EZQ_SOJOURN_STAMPS & (EZQ_SOJOURN_STAMPS - 1))
+  #error "Value of EZQ_SOJOURN_STAMPS must be a power of two"
+ #endif /* EZQ_SOJOURN_STAMPS */
+
+ #ifndef EZQ_SOJOURN_SUB_BITS
+  /*
+   * The number of bits of each time kept by the sojourn histogram. Each
+   * power of two is split into 2^EZQ_SOJOURN_SUB_BITS buckets, so reported
+   * times are within 1 / 2^EZQ_SOJOURN_SUB_BITS of the true value.
+   */
+  #define EZQ_SOJOURN_SUB_BITS (4)
+ #endif /* EZQ_SOJOURN_SUB_BITS */
+ #if EZQ_SOJOURN_SUB_BITS < 1 || EZQ_SOJOURN_SUB_BITS > 8
+  #error "Value of EZQ_SOJOURN_SUB_BITS must be between 1 and 8"
+ #endif /* EZQ_SOJOURN_SUB_BITS */
+
+ /*
+  * The number of buckets of the sojourn histogram, which covers times below
+  * 2^32 ticks. Longer times are counted in the last bucket.
+  */
+ #define EZQ_SOJOURN_BUCKETS \
+    ((32 - EZQ_SOJOURN_SUB_BITS + 1) << EZQ_SOJOURN_SUB_BITS)
+
+/*!
+ * @struct ezq_sojourn_stamp
+ * @brief Structure recording when an item was placed in an \c ezq_queue ,
+ * kept apart from the item itself.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_sojourn_stamp
+{
+    unsigned long seq; /* position of the item among all items pushed */
+    unsigned long ticks; /* clock reading when the item was pushed */
+};
+
+/*!
+ * @struct ezq_sojourn
+ * @brief Structure encapsulating the timestamps of queued items and a
+ * log-linear histogram of how long popped items spent in an \c ezq_queue .
+ * Since items leave in the order they arrived, the timestamps are kept in a
+ * ring of their own and matched to items by their position.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_sojourn
+{
+    struct ezq_sojourn_stamp stamps[EZQ_SOJOURN_STAMPS]; /* ring of stamps */
+    unsigned int stamp_front; /* position of the oldest stamp */
+    unsigned int stamp_count; /* number of stamps in the ring */
+    unsigned long push_seq; /* number of items ever pushed */
+    unsigned long pop_seq; /* number of items ever popped */
+    unsigned long buckets[EZQ_SOJOURN_BUCKETS]; /* histogram of times */
+    unsigned long samples; /* number of times in the histogram */
+    unsigned long max; /* longest time in the histogram */
+    unsigned long (*clock_fn)(void); /* clock stamping items, or NULL */
+};
+
+/*!
+ * @struct ezq_sojourn_summary
+ * @brief Structure holding the percentiles of the time items spent in an
+ * \c ezq_queue built with \c EZQ_ENABLE_SOJOURN defined, in the ticks of
+ * the queue's sojourn clock.
+ */
+struct ezq_sojourn_summary
+{
+    unsigned long samples; /* number of popped items that were timed */
+    unsigned long p50; /* median time */
+    unsigned long p99; /* 99th percentile time */
+    unsigned long p999; /* 99.9th percentile time */
+    unsigned long max; /* longest time */
+};
+#endif /* EZQ_ENABLE_SOJOURN */
+
 /*!
  * @struct ezq_queue
  * @brief Structure representing a queue with a fixed-size buffer that also
@@ -76,13 +291,27 @@ typedef struct ezq_queue
 {
     struct ezq_buffer fixed; /* fixed-size buffer */
     struct ezq_linkedlist dynamic; /* linked list for further items */
+    struct ezq_linkchain links; /* caller-embedded links for further items */
+    struct ezq_nodecache node_cache; /* retired nodes kept for reuse */
     unsigned int capacity; /* optional max number of items; 0 means no limit */
+    unsigned int flags; /* EZQ_FLAG_* values describing the queue's mode */
+    unsigned int reserved; /* slots handed out by ezq_reserve, uncommitted */
 
     /* function for dynamically allocating nodes in the linked list */
     void *(*alloc_fn)(const size_t size);
 
     /* function to release dynamically allocated nodes */
     void (*free_fn)(void * const ptr);
+
+#ifdef EZQ_ENABLE_STATS
+    struct ezq_stats stats; /* counters reported by ezq_stats */
+    unsigned long (*clock_fn)(void); /* optional clock timing spills */
+    unsigned long spill_start; /* clock reading when the queue last spilled */
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+    struct ezq_sojourn sojourn; /* time items spend in the queue */
+#endif /* EZQ_ENABLE_SOJOURN */
 } ezq_queue;
 
 /*!
@@ -104,6 +333,11 @@ typedef enum ezq_status
     EZQ_STATUS_NO_FREE_FN, /* No func to free dynamically allocated resource */
     EZQ_STATUS_ALLOC_FAILURE, /* Dynamic allocation attempt failed */
 
+    EZQ_STATUS_INVALID_CAPACITY, /* Requested capacity cannot be provided */
+    EZQ_STATUS_BUSY, /* Another thread won a race for the queue; may retry */
+    EZQ_STATUS_TIMEOUT, /* Wait for the queue ended before it was ready */
+    EZQ_STATUS_CORRUPT, /* Stored queue data failed validation */
+
     EZQ_STATUS_UNKNOWN = 0xFF /* Unknown error occurred */
 } ezq_status;
 
@@ -131,6 +365,71 @@ ezq_init(
     void (*free_fn)(void * const ptr)
 );
 
+/*!
+ * @brief Initializes an \c ezq_queue structure such that it contains no
+ * items and, instead of placing items in a linked list once its fixed-size
+ * buffer is full, moves them into a dynamically allocated buffer of twice
+ * the size.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to initialize.
+ * @param[in] capacity Maximum number of items that may be placed in the
+ * queue ( \c 0 for no limit).
+ * @param[in] shrink Non-zero if the buffer should be halved whenever no
+ * more than a quarter of it is in use, returning to the fixed-size buffer
+ * once the items fit in it again.
+ * @param[in] alloc_fn Function used to allocate the larger buffer when the
+ * current buffer is full.
+ * @param[in] free_fn Function used to release buffers that are no longer in
+ * use.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_queue pointed to by \c p_queue
+ * is successfully initialized, otherwise an error-specific \c ezq_status
+ * value.
+ */
+ezq_status EZQ_API
+ezq_init_growable(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    const int shrink,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Initializes an \c ezq_queue structure such that it contains no
+ * items and keeps them in caller-provided storage of \c slot_count items,
+ * rather than in its \c EZQ_FIXED_BUFFER_CAPACITY item buffer, until the
+ * storage is full. Further items are placed in a linked list as with
+ * \c ezq_init .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to initialize.
+ * @param[in] capacity Maximum number of items that may be placed in the
+ * queue ( \c 0 for no limit).
+ * @param[in,out] p_slots Storage for \c slot_count items, such as a stack
+ * array, a static buffer or a block of an arena. It must remain valid until
+ * the queue is destroyed, and is never released by the queue.
+ * @param[in] slot_count Number of items \c p_slots can hold. Must be a
+ * power of two, whatever \c EZQ_FIXED_BUFFER_CAPACITY is configured as.
+ * @param[in] alloc_fn Function used to allocate memory needed to store
+ * more items when the storage is full.
+ * @param[in] free_fn Function used to release memory allocated for items
+ * when the storage is full.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_queue pointed to by \c p_queue
+ * is successfully initialized, \c EZQ_STATUS_INVALID_CAPACITY if
+ * \c slot_count is unsupported, otherwise an error-specific \c ezq_status
+ * value.
+ */
+ezq_status EZQ_API
+ezq_init_buffer(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    void ** const p_slots,
+    const unsigned int slot_count,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
 /*!
  * @brief Gets the number of items currently in the queue.
  *
@@ -161,9 +460,34 @@ ezq_count(const ezq_queue * const p_queue, ezq_status * const p_status);
 ezq_status EZQ_API
 ezq_push(ezq_queue * const p_queue, void * const p_item);
 
+/*!
+ * @brief Places the items of \c pp_items at the tail end of a queue, in
+ * order, stopping early if an item cannot be placed.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue in which to place the
+ * items.
+ * @param[in] pp_items Array of pointers to arbitrary data to place on the
+ * queue. The items may not be \c NULL .
+ * @param[in] count Number of items in \c pp_items .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer than
+ * \c count items were placed, this indicates why.
+ *
+ * @return The number of items from the front of \c pp_items that were
+ * placed on the \c ezq_queue pointed to by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_push_n(
+    ezq_queue * const p_queue,
+    void * const * const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
 /*!
  * @brief Retrieves the front item of the queue and places it in the location
- * pointed to by \c pp_item .
+ * pointed to by \c pp_item . A queue in LIFO mode (see \c ezq_set_lifo )
+ * retrieves its back item instead.
  *
  * @param[in,out] p_queue Address of an \c ezq_queue to retrieve the front
  * item of.
@@ -177,13 +501,392 @@ ezq_push(ezq_queue * const p_queue, void * const p_item);
 ezq_status EZQ_API
 ezq_pop(ezq_queue * const p_queue, void ** const pp_item);
 
+/*!
+ * @brief Places \c p_item at the front end of a queue, so that it is the
+ * next item popped, e.g. to requeue preempted work.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue in which to place the
+ * item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * front of the \c ezq_queue pointed to by \c p_queue , otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note Once the buffer is full, its back item moves to the front of the
+ * linked list to make room, which may allocate a node.
+ */
+ezq_status EZQ_API
+ezq_push_front(ezq_queue * const p_queue, void * const p_item);
+
+/*!
+ * @brief Retrieves the back item of the queue, i.e. the one most recently
+ * pushed, and places it in the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to retrieve the back
+ * item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the back item of the \c ezq_queue pointed
+ * to by \c p_queue is retrieved and placed in the location pointed to by
+ * \c pp_item , otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_pop_back(ezq_queue * const p_queue, void ** const pp_item);
+
+/*!
+ * @brief Sets the maximum number of retired linked list nodes the queue
+ * keeps for reuse, releasing any cached nodes beyond the new limit.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to configure.
+ * @param[in] limit Maximum number of nodes to cache ( \c 0 disables
+ * caching).
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the limit of the \c ezq_queue pointed to
+ * by \c p_queue is successfully updated, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_set_node_cache_limit(ezq_queue * const p_queue, const unsigned int limit);
+
+/*!
+ * @brief Sets whether the queue is in LIFO mode, in which \c ezq_pop and
+ * \c ezq_pop_n take the most recently pushed items first, so that the queue
+ * behaves as a stack. May be called after any of the initialization
+ * functions.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to configure.
+ * @param[in] lifo Non-zero to pop the back item first, \c 0 to pop the
+ * front item first.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the mode of the \c ezq_queue pointed to
+ * by \c p_queue is successfully updated, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note \c ezq_peek , \c ezq_release and \c ezq_ipop always work from the
+ * front of the queue.
+ */
+ezq_status EZQ_API
+ezq_set_lifo(ezq_queue * const p_queue, const int lifo);
+
+/*!
+ * @brief Releases every retired linked list node the queue is holding for
+ * reuse.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to trim.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the cached nodes of the \c ezq_queue
+ * pointed to by \c p_queue are successfully released, otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_trim(ezq_queue * const p_queue);
+
+/*!
+ * @brief Retrieves up to \c count items from the front of the queue and
+ * places them, in order, in \c pp_items . A queue in LIFO mode (see
+ * \c ezq_set_lifo ) retrieves them from its back instead, most recently
+ * pushed first.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to retrieve the front
+ * items of.
+ * @param[out] pp_items Array in which to store the items retrieved from the
+ * queue. Must have room for \c count items.
+ * @param[in] count Maximum number of items to retrieve.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer than
+ * \c count items were retrieved, this indicates why.
+ *
+ * @return The number of items retrieved from the \c ezq_queue pointed to
+ * by \c p_queue and placed in \c pp_items .
+ */
+unsigned int EZQ_API
+ezq_pop_n(
+    ezq_queue * const p_queue,
+    void ** const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Reserves a run of up to \c count consecutive empty slots at the
+ * tail end of the queue, so that items may be written into the queue's
+ * storage directly and then published with \c ezq_commit .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to reserve slots in.
+ * @param[in] count Maximum number of slots to reserve.
+ * @param[out] ppp_slots Address in which to store the address of the first
+ * reserved slot.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If no slots were
+ * reserved, this indicates why.
+ *
+ * @return The number of slots reserved. This may be fewer than \c count
+ * when the queue's free space is not contiguous, in which case the rest may
+ * be reserved after the first run is committed.
+ *
+ * @note Reserving again, or pushing or popping, before committing abandons
+ * the reservation, after which \c ezq_commit fails.
+ */
+unsigned int EZQ_API
+ezq_reserve(
+    ezq_queue * const p_queue,
+    const unsigned int count,
+    void *** const ppp_slots,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Publishes the first \c count slots of the last reservation made
+ * with \c ezq_reserve , placing the items written to them at the tail end
+ * of the queue. Any further reserved slots are abandoned.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to commit slots in.
+ * @param[in] count Number of reserved slots to publish.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the items are published,
+ * \c EZQ_STATUS_INVALID_CAPACITY if \c count exceeds the number of
+ * reserved slots or the reservation was abandoned,
+ * \c EZQ_STATUS_NULL_ITEM if any of the slots was left
+ * \c NULL , otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_commit(ezq_queue * const p_queue, const unsigned int count);
+
+/*!
+ * @brief Gets the run of consecutive items at the front of the queue, in
+ * place, so that they may be read before being released with
+ * \c ezq_release .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to peek at.
+ * @param[out] ppp_items Address in which to store the address of the front
+ * item.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of consecutive items available from the address
+ * stored in \c ppp_items . Further items may follow once these are
+ * released.
+ */
+unsigned int EZQ_API
+ezq_peek(
+    ezq_queue * const p_queue,
+    void *** const ppp_items,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Removes the front \c count items of the queue without copying
+ * them out, typically after reading them with \c ezq_peek .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to release items of.
+ * @param[in] count Number of front items to remove.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the items are removed,
+ * \c EZQ_STATUS_EMPTY if fewer than \c count items are in the queue's
+ * fixed-size buffer (in which case none are removed), otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_release(ezq_queue * const p_queue, const unsigned int count);
+
+/*!
+ * @brief Places the item containing \c p_link at the tail end of a queue.
+ * Once the fixed size buffer is full, further items are chained together
+ * through their own links, so neither \c alloc_fn nor \c free_fn is ever
+ * called.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue in which to place the
+ * item.
+ * @param[in,out] p_link Address of an \c ezq_link embedded in the caller's
+ * item. May not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_link is successfully placed at the
+ * end of the \c ezq_queue pointed to by \c p_queue , otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note A queue pushed onto with this function must only be popped from
+ * with \c ezq_ipop , and must not also be pushed onto with \c ezq_push ,
+ * \c ezq_push_n or \c ezq_push_front .
+ */
+ezq_status EZQ_API
+ezq_ipush(ezq_queue * const p_queue, struct ezq_link * const p_link);
+
+/*!
+ * @brief Retrieves the link of the front item of an intrusive queue and
+ * places it in the location pointed to by \c pp_link . The item itself may
+ * be recovered with \c EZQ_CONTAINER_OF .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to retrieve the front
+ * item of.
+ * @param[out] pp_link Address in which to store the link retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front link of the \c ezq_queue
+ * pointed to by \c p_queue is retrieved and placed in the location pointed
+ * to by \c pp_link , otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_ipop(ezq_queue * const p_queue, struct ezq_link ** const pp_link);
+
+#ifdef EZQ_ENABLE_STATS
+/*!
+ * @brief Takes a snapshot of the queue's counters.
+ *
+ * @param[in] p_queue Address of an \c ezq_queue to get the counters of.
+ * @param[out] p_stats Address of an \c ezq_stats in which to place the
+ * counters.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the counters of the \c ezq_queue pointed
+ * to by \c p_queue are placed in \c p_stats , otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_STATS defined.
+ */
+ezq_status EZQ_API
+ezq_stats(const ezq_queue * const p_queue, struct ezq_stats * const p_stats);
+
+/*!
+ * @brief Sets the clock used to time how long the queue spends above its
+ * fixed capacity. Without one, only the number of such spells is counted.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to set the clock of.
+ * @param[in] clock_fn Function returning a monotonically increasing tick
+ * count in any unit, or \c NULL to stop timing.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the clock is set, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_STATS defined.
+ */
+ezq_status EZQ_API
+ezq_set_stats_clock(
+    ezq_queue * const p_queue,
+    unsigned long (*clock_fn)(void)
+);
+
+/*!
+ * @brief Formats counters taken with \c ezq_stats in the Prometheus text
+ * exposition format, as \c ezq_* metrics.
+ *
+ * @param[in] p_stats Address of the counters to format.
+ * @param[in] p_name Optional name of the queue, placed in a \c queue label
+ * of every metric. May be \c NULL for no label.
+ * @param[out] p_buf Buffer in which to place the text, which is always
+ * terminated when \c size is non-zero. May be \c NULL if \c size is \c 0 .
+ * @param[in] size Number of bytes \c p_buf can hold.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. This is
+ * \c EZQ_STATUS_FULL if the text was cut short.
+ *
+ * @return The length of the complete text, excluding its terminator. If
+ * this is not less than \c size , the text was cut short.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_STATS defined.
+ */
+size_t EZQ_API
+ezq_stats_format(
+    const struct ezq_stats * const p_stats,
+    const char * const p_name,
+    char * const p_buf,
+    const size_t size,
+    ezq_status * const p_status
+);
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+/*!
+ * @brief Sets the clock used to stamp items as they are pushed, so that the
+ * time each spends in the queue is recorded when it is popped. Any stamps
+ * already taken are discarded.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to set the clock of.
+ * @param[in] clock_fn Function returning a monotonically increasing tick
+ * count in any unit, or \c NULL to stop timing items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the clock is set, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note While \c EZQ_SOJOURN_STAMPS queued items are stamped, further items
+ * are not, so a deep queue times a sample of its items.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_SOJOURN defined.
+ */
+ezq_status EZQ_API
+ezq_set_sojourn_clock(
+    ezq_queue * const p_queue,
+    unsigned long (*clock_fn)(void)
+);
+
+/*!
+ * @brief Gets the time, in clock ticks, within which a given share of the
+ * timed items left the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_queue to get the percentile of.
+ * @param[in] per_mille Share of the timed items, in thousandths (e.g.
+ * \c 500 for the median and \c 999 for the 99.9th percentile). Values
+ * above \c 1000 are treated as \c 1000 .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. This is
+ * \c EZQ_STATUS_EMPTY if no items have been timed.
+ *
+ * @return The highest time counted in the histogram bucket holding the
+ * percentile, and never more than the longest time recorded.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_SOJOURN defined.
+ */
+unsigned long EZQ_API
+ezq_sojourn_percentile(
+    const ezq_queue * const p_queue,
+    const unsigned int per_mille,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Gets the median, 99th and 99.9th percentile and longest times
+ * items spent in the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_queue to summarize.
+ * @param[out] p_summary Address of an \c ezq_sojourn_summary in which to
+ * place the times.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the times are placed in \c p_summary ,
+ * \c EZQ_STATUS_EMPTY if no items have been timed, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_SOJOURN defined.
+ */
+ezq_status EZQ_API
+ezq_sojourn(
+    const ezq_queue * const p_queue,
+    struct ezq_sojourn_summary * const p_summary
+);
+
+/*!
+ * @brief Empties the sojourn histogram, e.g. to start a new measurement
+ * window. Items already queued remain stamped.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to reset.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the histogram is emptied, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note Only available when built with \c EZQ_ENABLE_SOJOURN defined.
+ */
+ezq_status EZQ_API
+ezq_sojourn_reset(ezq_queue * const p_queue);
+#endif /* EZQ_ENABLE_SOJOURN */
+
 /*!
  * @brief Clears the queue, performing any necessary cleanup.
  *
  * @param[in,out] p_queue Address of an \c ezq_queue structure to destroy.
  * @param[in] item_cleanup_fn Optional function that will be invoked each
  * remaining item in the queue, in case those items require additional
- * cleanup handling.
+ * cleanup handling. For items pushed with \c ezq_ipush , it is passed the
+ * address of each remaining \c ezq_link .
  * @param[in] p_args Optional pointer to an arbitrary structure that may
  * contain any additional resources necessary for cleanup of remaining items.
  *
@@ -0,0 +1,151 @@
+#ifndef EASYQUEUE_COMPACT_H
+#define EASYQUEUE_COMPACT_H
+
+#include "easyqueue.h"
+
+#ifndef EZQ_COMPACT_MIN_SLOTS
+ /*
+  * The number of items an \c ezq_cqueue allocates room for on its first
+  * push, and the size below which its ring is never shrunk.
+  */
+ #define EZQ_COMPACT_MIN_SLOTS (4)
+#endif /* EZQ_COMPACT_MIN_SLOTS */
+#if EZQ_COMPACT_MIN_SLOTS < 1 \
+    || 0 != (EZQ_COMPACT_MIN_SLOTS & (EZQ_COMPACT_MIN_SLOTS - 1))
+ #error "Value of EZQ_COMPACT_MIN_SLOTS must be a power of two"
+#endif /* EZQ_COMPACT_MIN_SLOTS */
+
+/*!
+ * @struct ezq_allocator
+ * @brief Structure holding the allocation functions of any number of
+ * \c ezq_cqueue instances, so that each queue needs only a pointer to it.
+ */
+typedef struct ezq_allocator
+{
+    /* function for dynamically allocating the rings of queues */
+    void *(*alloc_fn)(const size_t size);
+
+    /* function to release the rings of queues */
+    void (*free_fn)(void * const ptr);
+} ezq_allocator;
+
+/*!
+ * @struct ezq_cqueue
+ * @brief Structure representing a compact queue meant to be kept in large
+ * numbers, most of them empty. It holds no items inline; instead a ring is
+ * allocated on the first push and doubled whenever it is full, so an empty
+ * queue occupies only a few dozen bytes.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_cqueue
+{
+    void ** p_slots; /* ring of items, or NULL until the first push */
+    const ezq_allocator * p_allocator; /* shared allocation functions */
+    unsigned int front_index; /* position of the front item of the ring */
+    unsigned int count; /* number of items currently in the ring */
+    unsigned int slot_capacity; /* number of items the ring can hold */
+    unsigned int capacity; /* optional max number of items; 0 means none */
+} ezq_cqueue;
+
+/*!
+ * @brief Initializes an \c ezq_cqueue structure such that it contains no
+ * items. No memory is allocated until the first push.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue to initialize.
+ * @param[in] capacity Maximum number of items that may be placed in the
+ * queue ( \c 0 for no limit).
+ * @param[in] p_allocator Address of the allocation functions used for the
+ * queue's ring. It must remain valid until the queue is destroyed, and may
+ * be shared by any number of queues.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_cqueue pointed to by
+ * \c p_queue is successfully initialized, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_cinit(
+    ezq_cqueue * const p_queue,
+    const unsigned int capacity,
+    const ezq_allocator * const p_allocator
+);
+
+/*!
+ * @brief Places a new item at the tail end of a queue, allocating or
+ * doubling its ring if it is full.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue in which to place the
+ * item.
+ * @param[in] p_item Pointer to store in the queue. May not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * end of the \c ezq_cqueue pointed to by \c p_queue , otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_cpush(ezq_cqueue * const p_queue, void * const p_item);
+
+/*!
+ * @brief Retrieves the item at the front end of the queue and removes it,
+ * halving the ring once no more than a quarter of it is in use.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue to retrieve the front
+ * item of.
+ * @param[out] pp_item Address in which to store the retrieved item.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front item of the \c ezq_cqueue
+ * pointed to by \c p_queue is placed in \c pp_item , otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_cpop(ezq_cqueue * const p_queue, void ** const pp_item);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_cqueue to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items currently within the \c ezq_cqueue pointed to
+ * by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_ccount(const ezq_cqueue * const p_queue, ezq_status * const p_status);
+
+/*!
+ * @brief Shrinks the queue's ring to the smallest size that holds its
+ * items, releasing the ring entirely if the queue is empty.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue to trim.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the ring was trimmed, otherwise an
+ * error-specific \c ezq_status value, in which case the ring is left
+ * unchanged.
+ */
+ezq_status EZQ_API
+ezq_ctrim(ezq_cqueue * const p_queue);
+
+/*!
+ * @brief Clears the queue, releasing its ring.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in case those items require additional cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_cqueue pointed to by
+ * \c p_queue is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_cdestroy(
+    ezq_cqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_COMPACT_H */
@@ -0,0 +1,299 @@
+#ifndef EASYQUEUE_EXECUTOR_H
+#define EASYQUEUE_EXECUTOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "easyqueue.h"
+#include "easyqueue_mpmc.h"
+#include "easyqueue_wsdeque.h"
+
+#ifndef EZQ_EXECUTOR_BATCH
+ /*
+  * The largest number of tasks an idle worker takes at once from the
+  * submission queue or steals at once from another worker. Tasks beyond the
+  * first are placed on the worker's own deque, where others may steal them.
+  */
+ #define EZQ_EXECUTOR_BATCH (16)
+#endif /* EZQ_EXECUTOR_BATCH */
+#if EZQ_EXECUTOR_BATCH < 1
+ #error "Value of EZQ_EXECUTOR_BATCH must be a positive integer"
+#endif /* EZQ_EXECUTOR_BATCH < 1 */
+
+#ifndef EZQ_EXECUTOR_SPIN_LIMIT
+ /*
+  * The number of consecutive times an idle worker looks for a task, yielding
+  * the processor in between, before it parks until a task is submitted.
+  */
+ #define EZQ_EXECUTOR_SPIN_LIMIT (64)
+#endif /* EZQ_EXECUTOR_SPIN_LIMIT */
+#if EZQ_EXECUTOR_SPIN_LIMIT < 1
+ #error "Value of EZQ_EXECUTOR_SPIN_LIMIT must be a positive integer"
+#endif /* EZQ_EXECUTOR_SPIN_LIMIT < 1 */
+
+/*!
+ * @struct ezq_task
+ * @brief Structure describing a unit of work for an \c ezq_executor .
+ * Callers embed one in each of their own task structures and recover the
+ * task from the pointer passed to \c run_fn with \c EZQ_CONTAINER_OF , so
+ * the executor never allocates to hold it.
+ *
+ * @note A task may only be submitted once at a time, and must remain valid
+ * until its \c run_fn has been invoked or it has been passed to the cleanup
+ * function of \c ezq_executor_destroy .
+ */
+struct ezq_task
+{
+    void (*run_fn)(struct ezq_task * const p_task); /* function to run */
+};
+
+/*!
+ * @struct ezq_executor_stats
+ * @brief Structure holding the counters each worker of an \c ezq_executor
+ * keeps.
+ */
+struct ezq_executor_stats
+{
+    unsigned long executed; /* number of tasks run by the worker */
+    unsigned long injected; /* tasks taken from the submission queue */
+    unsigned long stolen; /* tasks stolen from other workers */
+    unsigned long parks; /* times the worker parked while idle */
+};
+
+/*!
+ * @struct ezq_executor_worker
+ * @brief Structure encapsulating a single worker thread of an
+ * \c ezq_executor and the deque of tasks it owns.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_executor_worker
+{
+    ezq_wsdeque deque; /* tasks owned by the worker */
+    struct ezq_executor * p_executor; /* executor the worker belongs to */
+    pthread_t thread; /* thread running the worker */
+    unsigned int index; /* position of the worker in the executor */
+    unsigned int victim; /* offset of the next worker to steal from */
+
+    /* Counters below are only written by the worker's own thread. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_ulong executed;
+    atomic_ulong injected;
+    atomic_ulong stolen;
+    atomic_ulong parks;
+};
+
+/*!
+ * @struct ezq_executor
+ * @brief Structure representing a pool of worker threads that run
+ * submitted tasks.
+ *
+ * Each worker owns an \c ezq_wsdeque . Tasks submitted from one of the
+ * executor's own tasks are pushed onto the running worker's deque, and all
+ * other tasks are pushed onto a shared \c ezq_mpmc submission queue. A
+ * worker runs the tasks of its own deque newest first, then takes a batch
+ * from the submission queue, then steals half of the tasks of another
+ * worker. Workers that find nothing to do for a while park on a condition
+ * variable, which submitters only signal while a worker is parked.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ * Because its workers refer back to it, an initialized executor may not be
+ * moved or copied.
+ */
+typedef struct ezq_executor
+{
+    /* Fields below are read-only between init and destroy. */
+    struct ezq_executor_worker * p_workers; /* caller-provided workers */
+    unsigned int worker_count; /* number of workers in p_workers */
+
+    ezq_mpmc submissions; /* tasks submitted from outside the workers */
+    pthread_mutex_t lock; /* guards parking and draining */
+    pthread_cond_t wake; /* signalled when tasks arrive for parked workers */
+    pthread_cond_t drained; /* signalled when no tasks remain pending */
+
+    /* submitted tasks that have neither run nor been cleaned up */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint pending;
+    atomic_uint sleepers; /* workers parked, or about to park */
+    atomic_uint drainers; /* threads waiting in ezq_executor_drain */
+    atomic_int stopping; /* non-zero once the workers should exit */
+} ezq_executor;
+
+/*!
+ * @brief Initializes an \c ezq_executor structure and starts its worker
+ * threads.
+ *
+ * @param[in,out] p_executor Address of an \c ezq_executor to initialize.
+ * @param[in,out] p_workers Array of \c worker_count workers to start. It
+ * must remain valid until the executor is destroyed.
+ * @param[in] worker_count Number of workers in \c p_workers . Must be
+ * non-zero.
+ * @param[in] capacity Number of tasks the submission queue is able to
+ * hold, rounded up to a power of two, and the initial capacity of each
+ * worker's deque.
+ * @param[in] alloc_fn Function used to allocate the submission queue and
+ * the workers' deques.
+ * @param[in] free_fn Function used to release the submission queue and the
+ * workers' deques.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_executor pointed to by
+ * \c p_executor is successfully initialized and its workers started,
+ * \c EZQ_STATUS_INVALID_CAPACITY if \c worker_count or \c capacity is
+ * unsupported, otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_executor_init(
+    ezq_executor * const p_executor,
+    struct ezq_executor_worker * const p_workers,
+    const unsigned int worker_count,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Pins a worker of the executor to a single CPU.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor whose worker to
+ * pin.
+ * @param[in] worker Index of the worker to pin.
+ * @param[in] cpu Index of the CPU to pin the worker to.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the worker is pinned,
+ * \c EZQ_STATUS_INVALID_CAPACITY if \c worker or \c cpu is out of range,
+ * \c EZQ_STATUS_UNKNOWN if the system refused (or, on platforms other than
+ * Linux, does not support) the request, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_executor_set_affinity(
+    ezq_executor * const p_executor,
+    const unsigned int worker,
+    const unsigned int cpu
+);
+
+/*!
+ * @brief Submits a task to be run by one of the executor's workers.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor to run the task.
+ * @param[in] p_task Address of the task to run. Neither it nor its
+ * \c run_fn may be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the task is submitted,
+ * \c EZQ_STATUS_FULL if the submission queue is full, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note When called from one of the executor's own tasks, the task is
+ * placed on the running worker's deque instead of the submission queue.
+ */
+ezq_status EZQ_API
+ezq_executor_submit(
+    ezq_executor * const p_executor,
+    struct ezq_task * const p_task
+);
+
+/*!
+ * @brief Submits a batch of tasks to be run by the executor's workers,
+ * waking as many parked workers as there are tasks.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor to run the
+ * tasks.
+ * @param[in] pp_tasks Array of tasks to run. Submission stops at the first
+ * task that is \c NULL or has no \c run_fn .
+ * @param[in] count Number of tasks in \c pp_tasks .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of tasks submitted, which are always the first ones
+ * of \c pp_tasks .
+ */
+unsigned int EZQ_API
+ezq_executor_submit_batch(
+    ezq_executor * const p_executor,
+    struct ezq_task * const * const pp_tasks,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Gets the number of submitted tasks that have not yet finished.
+ *
+ * @param[in] p_executor Address of an \c ezq_executor to count the tasks
+ * of.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of tasks submitted to the \c ezq_executor pointed to
+ * by \c p_executor that are queued or running.
+ */
+unsigned int EZQ_API
+ezq_executor_pending(
+    const ezq_executor * const p_executor,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Waits until every submitted task, including any that those tasks
+ * submit, has finished running.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor to drain.
+ *
+ * @return \c EZQ_STATUS_SUCCESS once no tasks remain pending, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function must not be called from one of the executor's own
+ * tasks.
+ */
+ezq_status EZQ_API
+ezq_executor_drain(ezq_executor * const p_executor);
+
+/*!
+ * @brief Takes a snapshot of the counters of one worker of the executor.
+ *
+ * @param[in] p_executor Address of an \c ezq_executor to get the counters
+ * of.
+ * @param[in] worker Index of the worker to get the counters of.
+ * @param[out] p_stats Address of an \c ezq_executor_stats in which to
+ * place the counters.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the counters are placed in \c p_stats ,
+ * \c EZQ_STATUS_INVALID_CAPACITY if \c worker is out of range, otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_executor_stats(
+    const ezq_executor * const p_executor,
+    const unsigned int worker,
+    struct ezq_executor_stats * const p_stats
+);
+
+/*!
+ * @brief Stops the executor's workers once they finish the tasks they are
+ * running, then releases its queues. Call \c ezq_executor_drain first to
+ * have every submitted task run.
+ *
+ * @param[in,out] p_executor Address of an \c ezq_executor structure to
+ * destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * task that never ran, in case those tasks require additional cleanup
+ * handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining
+ * tasks.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_executor pointed to by
+ * \c p_executor is successfully stopped and cleared, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function must not be called from one of the executor's own
+ * tasks, nor while another thread is submitting to the executor.
+ */
+ezq_status EZQ_API
+ezq_executor_destroy(
+    ezq_executor * const p_executor,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_EXECUTOR_H */
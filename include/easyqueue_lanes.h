@@ -0,0 +1,155 @@
+#ifndef EASYQUEUE_LANES_H
+#define EASYQUEUE_LANES_H
+
+#include "easyqueue.h"
+
+#ifndef EZQ_LANES_MAX
+ /*
+  * The largest number of lanes, i.e. priority levels, an \c ezq_lqueue may
+  * be initialized with. Each further 32 lanes add a word to the occupancy
+  * bitmap scanned by every pop.
+  */
+ #define EZQ_LANES_MAX (64)
+#endif /* EZQ_LANES_MAX */
+#if EZQ_LANES_MAX < 1
+ #error "Value of EZQ_LANES_MAX must be a positive integer"
+#endif /* EZQ_LANES_MAX < 1 */
+
+/* Number of lanes tracked by each word of an ezq_lqueue occupancy bitmap. */
+#define EZQ_LANE_WORD_BITS (32)
+
+/* Number of words in the occupancy bitmap of an ezq_lqueue. */
+#define EZQ_LANE_WORDS \
+    ((EZQ_LANES_MAX + EZQ_LANE_WORD_BITS - 1) / EZQ_LANE_WORD_BITS)
+
+/*!
+ * @struct ezq_lqueue
+ * @brief Structure representing a queue with a fixed number of priority
+ * levels, each kept as its own \c ezq_queue lane. Items are popped from the
+ * most urgent non-empty lane, lane \c 0 being the most urgent, and in the
+ * order they were pushed within a lane. A bitmap with a bit per non-empty
+ * lane lets pushes and pops find their lane in constant time.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_lqueue
+{
+    ezq_queue * p_lanes; /* caller-provided array of lane_count lanes */
+    unsigned int lane_count; /* number of lanes in p_lanes */
+    unsigned int count; /* number of items currently in all lanes */
+    unsigned int capacity; /* optional max number of items; 0 means none */
+
+    /* bit per non-empty lane; the most significant of the low 32 bits of
+     * word 0 is lane 0, so the most urgent lane is the first set bit */
+    unsigned long occupied[EZQ_LANE_WORDS];
+} ezq_lqueue;
+
+/*!
+ * @brief Initializes an \c ezq_lqueue structure such that it contains no
+ * items, initializing each of its lanes with \c ezq_init .
+ *
+ * @param[in,out] p_queue Address of an \c ezq_lqueue to initialize.
+ * @param[in,out] p_lanes Array of \c lane_count queues to use as the lanes.
+ * It must remain valid until the queue is destroyed.
+ * @param[in] lane_count Number of lanes in \c p_lanes , between \c 1 and
+ * \c EZQ_LANES_MAX .
+ * @param[in] capacity Maximum number of items that may be placed in all of
+ * the lanes together ( \c 0 for no limit).
+ * @param[in] alloc_fn Function used by each lane to allocate memory needed
+ * to store more items when its fixed size buffer is full.
+ * @param[in] free_fn Function used by each lane to release memory allocated
+ * for items when its fixed size buffer is full.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_lqueue pointed to by
+ * \c p_queue is successfully initialized, \c EZQ_STATUS_INVALID_CAPACITY if
+ * \c lane_count is unsupported, otherwise an error-specific \c ezq_status
+ * value.
+ */
+ezq_status EZQ_API
+ezq_linit(
+    ezq_lqueue * const p_queue,
+    ezq_queue * const p_lanes,
+    const unsigned int lane_count,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Places an item at the tail end of one lane of a queue.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_lqueue in which to place the
+ * item.
+ * @param[in] p_item Pointer to store in the queue. May not be \c NULL .
+ * @param[in] lane Lane in which to place the item, lower lanes being popped
+ * first. Lanes beyond the last are placed in the last lane.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed in the
+ * \c ezq_lqueue pointed to by \c p_queue , otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_lpush(
+    ezq_lqueue * const p_queue,
+    void * const p_item,
+    const unsigned int lane
+);
+
+/*!
+ * @brief Retrieves the front item of the most urgent non-empty lane and
+ * removes it from the queue.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_lqueue to retrieve the item
+ * from.
+ * @param[out] pp_item Address in which to store the retrieved item.
+ * @param[out] p_lane Optional address in which to store the lane the item
+ * was retrieved from.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if an item of the \c ezq_lqueue pointed to
+ * by \c p_queue is placed in \c pp_item , otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_lpop(
+    ezq_lqueue * const p_queue,
+    void ** const pp_item,
+    unsigned int * const p_lane
+);
+
+/*!
+ * @brief Gets the number of items currently in all lanes of the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_lqueue to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items currently within the \c ezq_lqueue pointed to
+ * by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_lcount(const ezq_lqueue * const p_queue, ezq_status * const p_status);
+
+/*!
+ * @brief Clears the queue, destroying each of its lanes.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_lqueue structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item, lane by lane, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_lqueue pointed to by
+ * \c p_queue is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_ldestroy(
+    ezq_lqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_LANES_H */
@@ -0,0 +1,242 @@
+#ifndef EASYQUEUE_MPMC_H
+#define EASYQUEUE_MPMC_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_mpmc_slot
+ * @brief Structure encapsulating a single slot of an \c ezq_mpmc ring. The
+ * slot's sequence number says which ticket may use it next: a producer
+ * holding ticket \c t may fill it once the sequence equals \c t , and a
+ * consumer holding ticket \c t may empty it once the sequence equals
+ * \c t+1 .
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_mpmc_slot
+{
+    atomic_uint seq; /* ticket that may next use the slot */
+    void * p_item; /* item held by the slot, if filled */
+};
+
+/*!
+ * @struct ezq_mpmc
+ * @brief Structure representing a lock-free bounded queue that may be
+ * pushed onto and popped from by any number of threads at once.
+ *
+ * Producers and consumers each draw tickets from their own counter with a
+ * compare-and-swap, then wait only on the sequence number of the slot the
+ * ticket maps to, so threads working on different slots never contend.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_mpmc
+{
+    /* Fields below are read-only between init and destroy. */
+    struct ezq_mpmc_slot * p_slots; /* ring of slots */
+    unsigned int mask; /* number of slots in the ring, minus one */
+
+    /* function to release the ring */
+    void (*free_fn)(void * const ptr);
+
+    /* next ticket to hand to a producer */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint tail;
+
+    /* next ticket to hand to a consumer */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint head;
+} ezq_mpmc;
+
+/*!
+ * @brief Initializes an \c ezq_mpmc structure such that it contains no
+ * items.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc to initialize.
+ * @param[in] capacity Minimum number of items the queue must be able to
+ * hold. This is rounded up to the next power of two, and to no less than
+ * \c 2 .
+ * @param[in] alloc_fn Function used to allocate the ring of slots.
+ * @param[in] free_fn Function used to release the ring of slots.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_mpmc pointed to by \c p_mpmc
+ * is successfully initialized, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the queue.
+ */
+ezq_status EZQ_API
+ezq_mpmc_init(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Gets the number of items the queue is able to hold.
+ *
+ * @param[in] p_mpmc Address of an \c ezq_mpmc to get the capacity of.
+ *
+ * @return The capacity of the \c ezq_mpmc pointed to by \c p_mpmc , or
+ * \c 0 if \c p_mpmc is \c NULL .
+ */
+unsigned int EZQ_API
+ezq_mpmc_capacity(const ezq_mpmc * const p_mpmc);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in] p_mpmc Address of an \c ezq_mpmc to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items within the \c ezq_mpmc pointed to by
+ * \c p_mpmc , counting those still being placed or retrieved. If other
+ * threads are active, this is a snapshot that may already be stale.
+ */
+unsigned int EZQ_API
+ezq_mpmc_count(const ezq_mpmc * const p_mpmc, ezq_status * const p_status);
+
+/*!
+ * @brief Places \c p_item at the tail end of a queue, retrying for as long
+ * as other producers win the race for the same slot.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc in which to place the
+ * item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * end of the \c ezq_mpmc pointed to by \c p_mpmc , otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_mpmc_push(ezq_mpmc * const p_mpmc, void * const p_item);
+
+/*!
+ * @brief Attempts once to place \c p_item at the tail end of a queue.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc in which to place the
+ * item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * end of the \c ezq_mpmc pointed to by \c p_mpmc , \c EZQ_STATUS_BUSY if
+ * another producer claimed the slot first, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_mpmc_try_push(ezq_mpmc * const p_mpmc, void * const p_item);
+
+/*!
+ * @brief Places the items of \c pp_items at the tail end of a queue, in
+ * order, claiming as many consecutive slots as are free at once.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc in which to place the
+ * items.
+ * @param[in] pp_items Array of pointers to arbitrary data to place on the
+ * queue. The items may not be \c NULL .
+ * @param[in] count Number of items in \c pp_items .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer than
+ * \c count items were placed, this indicates why.
+ *
+ * @return The number of items from the front of \c pp_items that were
+ * placed on the \c ezq_mpmc pointed to by \c p_mpmc . Items placed by
+ * other producers during the call may be interleaved with them.
+ */
+unsigned int EZQ_API
+ezq_mpmc_push_n(
+    ezq_mpmc * const p_mpmc,
+    void * const * const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Retrieves the front item of the queue, retrying for as long as
+ * other consumers win the race for the same slot.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc to retrieve the front
+ * item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front item of the \c ezq_mpmc
+ * pointed to by \c p_mpmc is retrieved and placed in the location pointed
+ * to by \c pp_item , otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_mpmc_pop(ezq_mpmc * const p_mpmc, void ** const pp_item);
+
+/*!
+ * @brief Attempts once to retrieve the front item of the queue.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc to retrieve the front
+ * item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front item of the \c ezq_mpmc
+ * pointed to by \c p_mpmc is retrieved and placed in the location pointed
+ * to by \c pp_item , \c EZQ_STATUS_BUSY if another consumer claimed the
+ * slot first, otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_mpmc_try_pop(ezq_mpmc * const p_mpmc, void ** const pp_item);
+
+/*!
+ * @brief Retrieves up to \c count items from the front of the queue and
+ * places them, in order, in \c pp_items , claiming as many consecutive
+ * slots as are filled at once.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc to retrieve the front
+ * items of.
+ * @param[out] pp_items Array in which to store the items retrieved from the
+ * queue. Must have room for \c count items.
+ * @param[in] count Maximum number of items to retrieve.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer than
+ * \c count items were retrieved, this indicates why.
+ *
+ * @return The number of items retrieved from the \c ezq_mpmc pointed to by
+ * \c p_mpmc and placed in \c pp_items .
+ */
+unsigned int EZQ_API
+ezq_mpmc_pop_n(
+    ezq_mpmc * const p_mpmc,
+    void ** const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Clears the queue and releases its ring of slots.
+ *
+ * @param[in,out] p_mpmc Address of an \c ezq_mpmc structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in the queue, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_mpmc pointed to by \c p_mpmc
+ * is successfully cleared, otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the queue.
+ */
+ezq_status EZQ_API
+ezq_mpmc_destroy(
+    ezq_mpmc * const p_mpmc,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_MPMC_H */
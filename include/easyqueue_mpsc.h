@@ -0,0 +1,125 @@
+#ifndef EASYQUEUE_MPSC_H
+#define EASYQUEUE_MPSC_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_mpsc_node
+ * @brief Structure linking an item into an \c ezq_mpsc . Callers embed one
+ * in each of their own message structures and recover the message from a
+ * popped node with \c EZQ_CONTAINER_OF , so the queue never allocates.
+ *
+ * @note A node may only be in one queue at a time, and must remain valid
+ * until it has been popped.
+ */
+struct ezq_mpsc_node
+{
+    _Atomic(struct ezq_mpsc_node *) p_next; /* next node in the queue */
+};
+
+/*!
+ * @struct ezq_mpsc
+ * @brief Structure representing an unbounded, intrusive queue that may be
+ * pushed onto by any number of threads while being popped from by exactly
+ * one consumer thread.
+ *
+ * Producers link a node in with a single atomic exchange of the tail and
+ * never wait on one another. The consumer follows the links from the head.
+ * A stub node embedded in the queue keeps the list non-empty.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ * Because the queue links to its own stub node, an initialized queue may
+ * not be moved or copied.
+ */
+typedef struct ezq_mpsc
+{
+    /* most recently pushed node; exchanged by producers */
+    _Alignas(EZQ_CACHE_LINE_SIZE) _Atomic(struct ezq_mpsc_node *) p_tail;
+
+    /* Fields below are only accessed by the consumer. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) struct ezq_mpsc_node * p_head; /* front */
+    struct ezq_mpsc_node stub; /* placeholder keeping the list non-empty */
+} ezq_mpsc;
+
+/*!
+ * @brief Initializes an \c ezq_mpsc structure such that it contains no
+ * items.
+ *
+ * @param[in,out] p_mpsc Address of an \c ezq_mpsc to initialize.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_mpsc pointed to by \c p_mpsc
+ * is successfully initialized, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the queue.
+ */
+ezq_status EZQ_API
+ezq_mpsc_init(ezq_mpsc * const p_mpsc);
+
+/*!
+ * @brief Links \c p_node in at the tail end of a queue. May be called by
+ * any number of threads at once.
+ *
+ * @param[in,out] p_mpsc Address of an \c ezq_mpsc in which to place the
+ * node.
+ * @param[in,out] p_node Address of an \c ezq_mpsc_node embedded in the
+ * caller's item. May not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_node is successfully placed at the
+ * end of the \c ezq_mpsc pointed to by \c p_mpsc , otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_mpsc_push(ezq_mpsc * const p_mpsc, struct ezq_mpsc_node * const p_node);
+
+/*!
+ * @brief Unlinks the front node of the queue and places it in the location
+ * pointed to by \c pp_node .
+ *
+ * @param[in,out] p_mpsc Address of an \c ezq_mpsc to retrieve the front
+ * node of.
+ * @param[out] pp_node Address in which to store the node retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front node of the \c ezq_mpsc
+ * pointed to by \c p_mpsc is retrieved, \c EZQ_STATUS_EMPTY if the queue
+ * holds no nodes, \c EZQ_STATUS_BUSY if the front node is still being
+ * linked in by a producer (in which case the pop may be retried shortly),
+ * otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function may only be called by the queue's single consumer.
+ */
+ezq_status EZQ_API
+ezq_mpsc_pop(ezq_mpsc * const p_mpsc, struct ezq_mpsc_node ** const pp_node);
+
+/*!
+ * @brief Unlinks every node in the queue at the time of the call, in order,
+ * passing each to \c node_fn . Nodes pushed during the call may be left in
+ * the queue.
+ *
+ * @param[in,out] p_mpsc Address of an \c ezq_mpsc to drain.
+ * @param[in] node_fn Function invoked on each node as it is unlinked. The
+ * node may be reused or released by it.
+ * @param[in] p_args Optional pointer passed to each call to \c node_fn .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. This is
+ * \c EZQ_STATUS_BUSY if draining stopped at a node that a producer was
+ * still linking in.
+ *
+ * @return The number of nodes passed to \c node_fn .
+ *
+ * @note This function may only be called by the queue's single consumer.
+ */
+unsigned int EZQ_API
+ezq_mpsc_drain(
+    ezq_mpsc * const p_mpsc,
+    void (*node_fn)(struct ezq_mpsc_node *p_node, void *p_args),
+    void * const p_args,
+    ezq_status * const p_status
+);
+
+#endif /* EASYQUEUE_MPSC_H */
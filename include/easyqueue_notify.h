@@ -0,0 +1,101 @@
+#ifndef EASYQUEUE_NOTIFY_H
+#define EASYQUEUE_NOTIFY_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_notifier
+ * @brief Structure representing a file descriptor that becomes readable
+ * when a queue goes from empty to non-empty, so that consumers may wait on
+ * the queue with \c epoll , \c poll , \c io_uring , etc.
+ *
+ * On Linux the descriptor is an \c eventfd ; elsewhere it is the read end
+ * of a pipe. Signals are coalesced: after the first signal, further signals
+ * write nothing until the consumer calls \c ezq_notifier_ack() , so a burst
+ * of pushes costs a single write.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_notifier
+{
+    int fd; /* descriptor that becomes readable when signalled */
+    int write_fd; /* descriptor written to signal; equal to fd for eventfds */
+    atomic_uint armed; /* non-zero if the next signal should write */
+} ezq_notifier;
+
+/*!
+ * @brief Initializes an \c ezq_notifier structure, opening its descriptor
+ * in non-blocking mode and arming it.
+ *
+ * @param[in,out] p_notifier Address of an \c ezq_notifier to initialize.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_notifier pointed to by
+ * \c p_notifier is successfully initialized, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_notifier_init(ezq_notifier * const p_notifier);
+
+/*!
+ * @brief Gets the descriptor that becomes readable when the notifier is
+ * signalled, for registration with an event loop.
+ *
+ * @param[in] p_notifier Address of an \c ezq_notifier to get the descriptor
+ * of.
+ *
+ * @return The descriptor of the \c ezq_notifier pointed to by
+ * \c p_notifier , or \c -1 if \c p_notifier is \c NULL .
+ */
+int EZQ_API
+ezq_notifier_fd(const ezq_notifier * const p_notifier);
+
+/*!
+ * @brief Makes the notifier's descriptor readable, unless it has already
+ * been signalled since it was last acknowledged. Producers call this after
+ * making a queue non-empty.
+ *
+ * @param[in,out] p_notifier Address of an \c ezq_notifier to signal.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_notifier pointed to by
+ * \c p_notifier is signalled (or already was), otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_notifier_signal(ezq_notifier * const p_notifier);
+
+/*!
+ * @brief Clears the notifier's descriptor and re-arms it, so that the next
+ * signal writes to it again.
+ *
+ * @param[in,out] p_notifier Address of an \c ezq_notifier to acknowledge.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_notifier pointed to by
+ * \c p_notifier is acknowledged, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note Signals are only sent on the empty to non-empty transition, so
+ * after acknowledging, the consumer must pop from the queue until it is
+ * empty before waiting on the descriptor again.
+ */
+ezq_status EZQ_API
+ezq_notifier_ack(ezq_notifier * const p_notifier);
+
+/*!
+ * @brief Closes the notifier's descriptors.
+ *
+ * @param[in,out] p_notifier Address of an \c ezq_notifier to destroy.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_notifier pointed to by
+ * \c p_notifier is successfully destroyed, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must not be called while the notifier is attached
+ * to a queue that may still be pushed onto.
+ */
+ezq_status EZQ_API
+ezq_notifier_destroy(ezq_notifier * const p_notifier);
+
+#endif /* EASYQUEUE_NOTIFY_H */
@@ -0,0 +1,221 @@
+#ifndef EASYQUEUE_PERSIST_H
+#define EASYQUEUE_PERSIST_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/* Layout version of the files written by ezq_persist_open. */
+#define EZQ_PERSIST_VERSION (1u)
+
+/*!
+ * @struct ezq_persist_header
+ * @brief Structure at the start of the file backing an \c ezq_persist .
+ * The rest of its first page is unused, and the ring of records starts at
+ * \c data_offset .
+ *
+ * @note Files are only portable between builds with the same byte order
+ * and \c EZQ_CACHE_LINE_SIZE , on systems with the same page size.
+ */
+struct ezq_persist_header
+{
+    char magic[8]; /* identifies the file as an ezq_persist ring */
+    unsigned int version; /* EZQ_PERSIST_VERSION of the layout */
+    unsigned int record_size; /* bytes of data in each record */
+    unsigned int capacity; /* records in the ring, a power of two */
+    unsigned int data_offset; /* offset of the ring within the file */
+
+    /* position of the next record to push */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint tail;
+
+    /* position of the next record to pop */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint head;
+};
+
+/*!
+ * @struct ezq_persist_record
+ * @brief Structure of each slot in the ring of an \c ezq_persist . Slots
+ * are padded to a multiple of eight bytes.
+ */
+struct ezq_persist_record
+{
+    unsigned int seq; /* position the record was pushed at */
+    unsigned int checksum; /* checksum of seq and data */
+    unsigned char data[]; /* record_size bytes of data */
+};
+
+/*!
+ * @struct ezq_persist
+ * @brief Structure representing a bounded queue of fixed-size records kept
+ * in a memory-mapped file, so that the records it holds survive a restart
+ * of the process. It may be pushed onto by one producer thread while being
+ * popped from by one consumer thread.
+ *
+ * Pushes and pops copy records into and out of the mapping and update the
+ * head and tail in the file's header page, as with an \c ezq_spsc , without
+ * making a system call. Records only reach the disk when the kernel writes
+ * the pages back, when \c ezq_persist_sync is called, or every
+ * \c sync_every pushes.
+ *
+ * Each record carries the position it was pushed at and a checksum. On
+ * opening an existing file the queue keeps the records from the stored head
+ * onwards up to the first one that fails validation, whatever the stored
+ * tail, so a torn write at a crash loses only the records written after the
+ * last sync. Slots at the stored head that a later lap of the ring has
+ * reused are skipped, since a push may reuse a slot before the head that
+ * freed it reaches the disk. Records popped since the last sync are popped again after a
+ * restart, so consumers must tolerate seeing a record more than once.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_persist
+{
+    /* Fields below are read-only between open and close. */
+    struct ezq_persist_header * p_header; /* start of the mapped file */
+    unsigned char * p_ring; /* first slot of the ring of records */
+    size_t size; /* number of bytes mapped */
+    size_t page_size; /* size of the pages msync works on */
+    size_t stride; /* number of bytes between consecutive slots */
+    unsigned int mask; /* number of slots in the ring, minus one */
+    unsigned int record_size; /* bytes of data in each record */
+    unsigned int sync_every; /* pushes between automatic syncs, or 0 */
+    int fd; /* descriptor of the backing file */
+
+    /* Fields below are only written by the producer. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) unsigned int cached_head;
+    unsigned int synced_tail; /* tail as of the last sync */
+
+    /* Fields below are only written by the consumer. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) unsigned int cached_tail;
+} ezq_persist;
+
+/*!
+ * @brief Opens the file at \c path as an \c ezq_persist , creating an empty
+ * queue in it if the file is missing or empty, or else recovering the
+ * records it holds.
+ *
+ * @param[in,out] p_persist Address of an \c ezq_persist to open.
+ * @param[in] path Path of the file backing the queue.
+ * @param[in] record_size Number of bytes in each record. Must be non-zero.
+ * @param[in] capacity Minimum number of records the queue must be able to
+ * hold. This is rounded up to the next power of two.
+ * @param[in] sync_every Number of pushes after which a push also calls
+ * \c ezq_persist_sync , or \c 0 to only sync when asked.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_persist pointed to by
+ * \c p_persist is successfully opened, \c EZQ_STATUS_INVALID_CAPACITY if
+ * \c record_size or \c capacity is unsupported or differs from those the
+ * file was created with, \c EZQ_STATUS_CORRUPT if the file is not an
+ * \c ezq_persist ring, \c EZQ_STATUS_BUSY if another \c ezq_persist has the
+ * file open, \c EZQ_STATUS_UNKNOWN if the file could not be opened or
+ * mapped, otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_persist_open(
+    ezq_persist * const p_persist,
+    const char * const path,
+    const unsigned int record_size,
+    const unsigned int capacity,
+    const unsigned int sync_every
+);
+
+/*!
+ * @brief Gets the number of records the queue is able to hold.
+ *
+ * @param[in] p_persist Address of an \c ezq_persist to get the capacity
+ * of.
+ *
+ * @return The capacity of the queue, or \c 0 if \c p_persist is \c NULL or
+ * not open.
+ */
+unsigned int EZQ_API
+ezq_persist_capacity(const ezq_persist * const p_persist);
+
+/*!
+ * @brief Gets the number of records currently in the queue.
+ *
+ * @param[in] p_persist Address of an \c ezq_persist to count the records
+ * in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of records in the \c ezq_persist pointed to by
+ * \c p_persist .
+ */
+unsigned int EZQ_API
+ezq_persist_count(
+    const ezq_persist * const p_persist,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Copies the record at \c p_record to the tail end of the queue.
+ *
+ * @param[in,out] p_persist Address of an \c ezq_persist in which to place
+ * the record.
+ * @param[in] p_record Address of the \c record_size bytes to copy.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the record is placed on the queue,
+ * \c EZQ_STATUS_FULL if the queue is full, \c EZQ_STATUS_UNKNOWN if the
+ * record was placed on the queue but the automatic sync that followed it
+ * failed, otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function must only be called from the producer thread.
+ */
+ezq_status EZQ_API
+ezq_persist_push(ezq_persist * const p_persist, const void * const p_record);
+
+/*!
+ * @brief Copies the front record of the queue to \c p_record and removes it
+ * from the queue.
+ *
+ * @param[in,out] p_persist Address of an \c ezq_persist to retrieve the
+ * front record of.
+ * @param[out] p_record Address of \c record_size bytes in which to copy the
+ * record.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if a record is retrieved,
+ * \c EZQ_STATUS_EMPTY if the queue is empty, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must only be called from the consumer thread.
+ */
+ezq_status EZQ_API
+ezq_persist_pop(ezq_persist * const p_persist, void * const p_record);
+
+/*!
+ * @brief Writes the records pushed since the last sync, then the header
+ * page, back to the file and waits for them to reach the disk.
+ *
+ * @param[in,out] p_persist Address of an \c ezq_persist to sync.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the records and the head and tail
+ * positions as of the call are on the disk, \c EZQ_STATUS_UNKNOWN if the
+ * system failed to write them, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note This function must only be called from the producer thread, or
+ * while no push is in progress.
+ */
+ezq_status EZQ_API
+ezq_persist_sync(ezq_persist * const p_persist);
+
+/*!
+ * @brief Syncs the queue, then unmaps and closes its file. The records it
+ * holds remain in the file for the next \c ezq_persist_open .
+ *
+ * @param[in,out] p_persist Address of an \c ezq_persist to close.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_persist pointed to by
+ * \c p_persist is successfully synced and closed, otherwise an
+ * error-specific \c ezq_status value. The file is closed even if the final
+ * sync fails.
+ *
+ * @note This function must not be called while another thread is using the
+ * queue.
+ */
+ezq_status EZQ_API
+ezq_persist_close(ezq_persist * const p_persist);
+
+#endif /* EASYQUEUE_PERSIST_H */
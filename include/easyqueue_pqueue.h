@@ -0,0 +1,204 @@
+#ifndef EASYQUEUE_PQUEUE_H
+#define EASYQUEUE_PQUEUE_H
+
+#include "easyqueue.h"
+
+#ifndef EZQ_PQUEUE_MIN_SLOTS
+ /*
+  * The number of entries an \c ezq_pqueue allocates room for on its first
+  * push. The heap array doubles from this size whenever it is full.
+  */
+ #define EZQ_PQUEUE_MIN_SLOTS (16)
+#endif /* EZQ_PQUEUE_MIN_SLOTS */
+#if EZQ_PQUEUE_MIN_SLOTS < 1
+ #error "Value of EZQ_PQUEUE_MIN_SLOTS must be a positive integer"
+#endif /* EZQ_PQUEUE_MIN_SLOTS < 1 */
+
+/*!
+ * @struct ezq_pqueue_entry
+ * @brief Structure holding an item of an \c ezq_pqueue alongside its
+ * priority, so that integer priorities are compared without following the
+ * item pointer.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_pqueue_entry
+{
+    void * p_item; /* item placed in the queue */
+    long priority; /* priority given when the item was pushed */
+};
+
+/*!
+ * @struct ezq_pqueue
+ * @brief Structure representing a priority queue, from which items are
+ * popped lowest priority first rather than in the order they were pushed.
+ * Items are ordered by an optional comparator or, without one, by an
+ * integer priority given with each item. They are kept in an implicit 4-ary
+ * heap in a single array, so that each level of the heap spans fewer cache
+ * lines than a binary heap would, and no per-item nodes are allocated.
+ *
+ * @note Items of equal priority are not popped in any particular order.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_pqueue
+{
+    struct ezq_pqueue_entry * p_entries; /* heap array, or NULL until used */
+    unsigned int count; /* number of items currently in the heap */
+    unsigned int slot_capacity; /* number of entries p_entries can hold */
+    unsigned int capacity; /* optional max number of items; 0 means none */
+
+    /* optional function ordering items; negative if p_a pops before p_b */
+    int (*cmp_fn)(const void *p_a, const void *p_b);
+
+    /* function for dynamically allocating the heap array */
+    void *(*alloc_fn)(const size_t size);
+
+    /* function to release the heap array */
+    void (*free_fn)(void * const ptr);
+} ezq_pqueue;
+
+/*!
+ * @brief Initializes an \c ezq_pqueue structure such that it contains no
+ * items. No memory is allocated until the first push.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue to initialize.
+ * @param[in] capacity Maximum number of items that may be placed in the
+ * queue ( \c 0 for no limit).
+ * @param[in] cmp_fn Optional function comparing two items, returning a
+ * negative value if \c p_a should be popped before \c p_b , as with
+ * \c qsort . If \c NULL , items are ordered by the priority they were pushed
+ * with instead.
+ * @param[in] alloc_fn Function used to allocate the heap array.
+ * @param[in] free_fn Function used to release the heap array.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_pqueue pointed to by
+ * \c p_queue is successfully initialized, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_pinit(
+    ezq_pqueue * const p_queue,
+    const unsigned int capacity,
+    int (*cmp_fn)(const void *p_a, const void *p_b),
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Places an item in a priority queue, doubling its heap array if it
+ * is full.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue in which to place the
+ * item.
+ * @param[in] p_item Pointer to store in the queue. May not be \c NULL .
+ * @param[in] priority Priority of the item, lower values being popped
+ * first. Ignored if the queue has a comparator.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed in the
+ * \c ezq_pqueue pointed to by \c p_queue , otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_ppush(
+    ezq_pqueue * const p_queue,
+    void * const p_item,
+    const long priority
+);
+
+/*!
+ * @brief Places a batch of items in a priority queue. A batch at least as
+ * large as the queue is ordered by rebuilding the heap in linear time
+ * rather than by placing each item in turn.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue in which to place the
+ * items.
+ * @param[in] pp_items Array of pointers to place in the queue. The items may
+ * not be \c NULL .
+ * @param[in] p_priorities Optional array of the priorities of the items in
+ * \c pp_items . If \c NULL , every item has priority \c 0 .
+ * @param[in] count Number of items in \c pp_items .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer than
+ * \c count items were placed, this indicates why.
+ *
+ * @return The number of items from the front of \c pp_items that were
+ * placed in the \c ezq_pqueue pointed to by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_ppush_n(
+    ezq_pqueue * const p_queue,
+    void * const * const pp_items,
+    const long * const p_priorities,
+    const unsigned int count,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Retrieves the item of lowest priority and removes it from the
+ * queue.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue to retrieve the item
+ * of lowest priority from.
+ * @param[out] pp_item Address in which to store the retrieved item.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the item of lowest priority in the
+ * \c ezq_pqueue pointed to by \c p_queue is placed in \c pp_item , otherwise
+ * an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_ppop(ezq_pqueue * const p_queue, void ** const pp_item);
+
+/*!
+ * @brief Retrieves the item of lowest priority without removing it from
+ * the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_pqueue to peek at.
+ * @param[out] pp_item Address in which to store the item.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the item of lowest priority in the
+ * \c ezq_pqueue pointed to by \c p_queue is placed in \c pp_item , otherwise
+ * an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_ppeek(const ezq_pqueue * const p_queue, void ** const pp_item);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_pqueue to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items currently within the \c ezq_pqueue pointed to
+ * by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_pcount(const ezq_pqueue * const p_queue, ezq_status * const p_status);
+
+/*!
+ * @brief Clears the queue, releasing its heap array.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item, in no particular order, in case those items require
+ * additional cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_pqueue pointed to by
+ * \c p_queue is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_pdestroy(
+    ezq_pqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_PQUEUE_H */
@@ -0,0 +1,164 @@
+#ifndef EASYQUEUE_SHARDED_H
+#define EASYQUEUE_SHARDED_H
+
+#include "easyqueue.h"
+#include "easyqueue_mpmc.h"
+
+/* Have each thread use its own home shard, regardless of the CPU it runs
+ * on, rather than the shard of its current CPU.
+ */
+#define EZQ_SHARDED_BY_THREAD (0x01u)
+
+/*!
+ * @struct ezq_sharded
+ * @brief Structure representing a queue split into several \c ezq_mpmc
+ * shards, so that producers and consumers on different CPUs mostly touch
+ * different cache lines.
+ *
+ * Each thread has a home shard: that of the CPU it is running on, or with
+ * \c EZQ_SHARDED_BY_THREAD (or on platforms other than Linux) one handed
+ * out to the thread the first time it uses any sharded queue. Pushes go to
+ * the home shard, moving on to the next shards only if it is full. Pops
+ * take from the home shard first, then sweep the other shards in turn.
+ *
+ * Items stay in FIFO order within a shard, but not across shards: an item
+ * pushed on one CPU may be popped before an item pushed earlier on another.
+ * This relaxed ordering is what lets the queue scale with the number of
+ * CPUs, so callers needing strict FIFO order should use an \c ezq_mpmc .
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_sharded
+{
+    /* Fields below are read-only between init and destroy. */
+    ezq_mpmc * p_shards; /* caller-provided shards */
+    unsigned int shard_count; /* number of shards in p_shards */
+    unsigned int flags; /* EZQ_SHARDED_* flags given at init */
+} ezq_sharded;
+
+/*!
+ * @brief Initializes an \c ezq_sharded structure such that it contains no
+ * items.
+ *
+ * @param[in,out] p_sharded Address of an \c ezq_sharded to initialize.
+ * @param[in,out] p_shards Array of \c shard_count shards to initialize. It
+ * must remain valid until the queue is destroyed. One shard per CPU, or per
+ * producer thread with \c EZQ_SHARDED_BY_THREAD , avoids most contention.
+ * @param[in] shard_count Number of shards in \c p_shards . Must be
+ * non-zero.
+ * @param[in] capacity Number of items each shard is able to hold, rounded
+ * up to a power of two.
+ * @param[in] flags Bitwise OR of \c EZQ_SHARDED_* flags, or \c 0 .
+ * @param[in] alloc_fn Function used to allocate the rings of the shards.
+ * @param[in] free_fn Function used to release the rings of the shards.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_sharded pointed to by
+ * \c p_sharded is successfully initialized,
+ * \c EZQ_STATUS_INVALID_CAPACITY if \c shard_count or \c capacity is
+ * unsupported, otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_sharded_init(
+    ezq_sharded * const p_sharded,
+    ezq_mpmc * const p_shards,
+    const unsigned int shard_count,
+    const unsigned int capacity,
+    const unsigned int flags,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Gets the index of the calling thread's home shard.
+ *
+ * @param[in] p_sharded Address of an \c ezq_sharded to get the home shard
+ * of.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The index of the shard that pushes and pops from the calling
+ * thread try first. Without \c EZQ_SHARDED_BY_THREAD , it may change
+ * whenever the thread migrates to another CPU.
+ */
+unsigned int EZQ_API
+ezq_sharded_home(
+    const ezq_sharded * const p_sharded,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in] p_sharded Address of an \c ezq_sharded to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The sum of the number of items in each shard, which is only
+ * exact while no other thread is pushing or popping.
+ */
+unsigned int EZQ_API
+ezq_sharded_count(
+    const ezq_sharded * const p_sharded,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Places \c p_item at the tail end of the calling thread's home
+ * shard, or of the next shard with room if the home shard is full.
+ *
+ * @param[in,out] p_sharded Address of an \c ezq_sharded in which to place
+ * the item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the item is placed on the queue,
+ * \c EZQ_STATUS_FULL if every shard is full, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_sharded_push(ezq_sharded * const p_sharded, void * const p_item);
+
+/*!
+ * @brief Retrieves the front item of the calling thread's home shard or,
+ * if it is empty, of the first non-empty shard after it.
+ *
+ * @param[in,out] p_sharded Address of an \c ezq_sharded to retrieve an
+ * item from.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if an item is retrieved,
+ * \c EZQ_STATUS_EMPTY if every shard was found empty, otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_sharded_pop(ezq_sharded * const p_sharded, void ** const pp_item);
+
+/*!
+ * @brief Releases the rings of the shards, leaving the queue empty.
+ *
+ * @param[in,out] p_sharded Address of an \c ezq_sharded structure to
+ * destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in the queue, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_sharded pointed to by
+ * \c p_sharded is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must not be called while another thread is using the
+ * queue.
+ */
+ezq_status EZQ_API
+ezq_sharded_destroy(
+    ezq_sharded * const p_sharded,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_SHARDED_H */
@@ -0,0 +1,150 @@
+#ifndef EASYQUEUE_SPSC_H
+#define EASYQUEUE_SPSC_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_spsc
+ * @brief Structure representing a lock-free bounded queue that may be
+ * pushed onto by exactly one producer thread while being popped from by
+ * exactly one consumer thread.
+ *
+ * Items are kept in a ring whose capacity is a power of two. The producer
+ * and consumer each own an index on a cache line of their own, alongside a
+ * cached copy of the other side's index that is only refreshed when the
+ * ring appears to be full or empty, respectively. The structure's size is
+ * rounded up to a whole number of cache lines, so the consumer's line is
+ * not shared with neighbouring data either.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_spsc
+{
+    /* Fields below are read-only between init and destroy. */
+    void ** p_slots; /* ring of items */
+    unsigned int mask; /* number of slots in the ring, minus one */
+
+    /* function to release the ring */
+    void (*free_fn)(void * const ptr);
+
+    /* Fields below are only written by the producer. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint tail; /* next index to fill */
+    unsigned int cached_head; /* last head index seen by the producer */
+
+    /* Fields below are only written by the consumer. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint head; /* next index to empty */
+    unsigned int cached_tail; /* last tail index seen by the consumer */
+} ezq_spsc;
+
+/*!
+ * @brief Initializes an \c ezq_spsc structure such that it contains no
+ * items.
+ *
+ * @param[in,out] p_spsc Address of an \c ezq_spsc to initialize.
+ * @param[in] capacity Minimum number of items the queue must be able to
+ * hold. This is rounded up to the next power of two.
+ * @param[in] alloc_fn Function used to allocate the ring of items.
+ * @param[in] free_fn Function used to release the ring of items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_spsc pointed to by \c p_spsc
+ * is successfully initialized, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the queue.
+ */
+ezq_status EZQ_API
+ezq_spsc_init(
+    ezq_spsc * const p_spsc,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Gets the number of items the queue is able to hold.
+ *
+ * @param[in] p_spsc Address of an \c ezq_spsc to get the capacity of.
+ *
+ * @return The capacity of the \c ezq_spsc pointed to by \c p_spsc , or
+ * \c 0 if \c p_spsc is \c NULL .
+ */
+unsigned int EZQ_API
+ezq_spsc_capacity(const ezq_spsc * const p_spsc);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in] p_spsc Address of an \c ezq_spsc to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items within the \c ezq_spsc pointed to by
+ * \c p_spsc . If the producer or consumer is active, this is a snapshot
+ * that may already be stale.
+ */
+unsigned int EZQ_API
+ezq_spsc_count(const ezq_spsc * const p_spsc, ezq_status * const p_status);
+
+/*!
+ * @brief Places \c p_item at the tail end of a queue.
+ *
+ * @param[in,out] p_spsc Address of an \c ezq_spsc in which to place the
+ * item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * end of the \c ezq_spsc pointed to by \c p_spsc , otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function may only be called by the queue's single producer.
+ */
+ezq_status EZQ_API
+ezq_spsc_push(ezq_spsc * const p_spsc, void * const p_item);
+
+/*!
+ * @brief Retrieves the front item of the queue and places it in the location
+ * pointed to by \c pp_item .
+ *
+ * @param[in,out] p_spsc Address of an \c ezq_spsc to retrieve the front
+ * item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front item of the \c ezq_spsc
+ * pointed to by \c p_spsc is retrieved and placed in the location pointed
+ * to by \c pp_item , otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function may only be called by the queue's single consumer.
+ */
+ezq_status EZQ_API
+ezq_spsc_pop(ezq_spsc * const p_spsc, void ** const pp_item);
+
+/*!
+ * @brief Clears the queue and releases its ring of items.
+ *
+ * @param[in,out] p_spsc Address of an \c ezq_spsc structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in the queue, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_spsc pointed to by \c p_spsc
+ * is successfully cleared, otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the queue.
+ */
+ezq_status EZQ_API
+ezq_spsc_destroy(
+    ezq_spsc * const p_spsc,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_SPSC_H */
@@ -0,0 +1,163 @@
+#ifndef EASYQUEUE_VALUE_H
+#define EASYQUEUE_VALUE_H
+
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_vsegment
+ * @brief Structure heading a dynamically allocated block of up to
+ * \c EZQ_LIST_NODE_CAPACITY elements for use by an \c ezq_vqueue once its
+ * ring is full. The elements themselves follow the header in the same
+ * allocation.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_vsegment
+{
+    struct ezq_vsegment * p_next; /* next segment in the list */
+    unsigned int front_index; /* index of the front element of the block */
+    unsigned int count; /* number of elements currently in the block */
+};
+
+/*!
+ * @struct ezq_vqueue
+ * @brief Structure representing a queue that stores fixed-size elements by
+ * value rather than pointers to them. Elements are copied into a ring of
+ * \c EZQ_FIXED_BUFFER_CAPACITY elements, allocated when the queue is
+ * initialized, and into segments of \c EZQ_LIST_NODE_CAPACITY elements once
+ * the ring is full.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_vqueue
+{
+    unsigned char * p_ring; /* ring of EZQ_FIXED_BUFFER_CAPACITY elements */
+    unsigned int front_index; /* position of the front element of the ring */
+    unsigned int count; /* number of elements currently in the ring */
+    struct ezq_vsegment * p_head; /* front segment of further elements */
+    struct ezq_vsegment * p_tail; /* rear segment of further elements */
+    struct ezq_vsegment * p_spare; /* retired segment kept for reuse */
+    unsigned int spilled; /* number of elements across all segments */
+    unsigned int capacity; /* optional max number of elements; 0 means none */
+    size_t elem_size; /* size, in bytes, of each element */
+
+    /* function for dynamically allocating the ring and segments */
+    void *(*alloc_fn)(const size_t size);
+
+    /* function to release the ring and segments */
+    void (*free_fn)(void * const ptr);
+} ezq_vqueue;
+
+/*!
+ * @brief Initializes an \c ezq_vqueue structure such that it contains no
+ * elements, allocating its ring.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue to initialize.
+ * @param[in] elem_size Size, in bytes, of each element. Must be non-zero.
+ * @param[in] capacity Maximum number of elements that may be placed in the
+ * queue ( \c 0 for no limit).
+ * @param[in] alloc_fn Function used to allocate the ring and any further
+ * segments.
+ * @param[in] free_fn Function used to release the ring and segments.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_vqueue pointed to by
+ * \c p_queue is successfully initialized, \c EZQ_STATUS_INVALID_CAPACITY
+ * if \c elem_size is \c 0 or too large, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_vinit(
+    ezq_vqueue * const p_queue,
+    const size_t elem_size,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Copies the element pointed to by \c p_src to the tail end of a
+ * queue.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue in which to place the
+ * element.
+ * @param[in] p_src Address of the element to copy. May not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the element is successfully copied to
+ * the end of the \c ezq_vqueue pointed to by \c p_queue , otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_vpush(ezq_vqueue * const p_queue, const void * const p_src);
+
+/*!
+ * @brief Copies the front element of the queue to \c p_dst and removes it.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue to retrieve the front
+ * element of.
+ * @param[out] p_dst Address at which to store the element, which must have
+ * room for the queue's element size.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front element of the \c ezq_vqueue
+ * pointed to by \c p_queue is copied to \c p_dst and removed, otherwise an
+ * error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_vpop(ezq_vqueue * const p_queue, void * const p_dst);
+
+/*!
+ * @brief Gets the address of the front element of the queue, in place.
+ *
+ * @param[in] p_queue Address of an \c ezq_vqueue to peek at.
+ * @param[out] pp_elem Address in which to store the address of the front
+ * element.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the address of the front element of the
+ * \c ezq_vqueue pointed to by \c p_queue is placed in \c pp_elem , otherwise
+ * an error-specific \c ezq_status value.
+ *
+ * @note The address remains valid until the element is popped or the queue
+ * is destroyed.
+ */
+ezq_status EZQ_API
+ezq_vpeek(const ezq_vqueue * const p_queue, void ** const pp_elem);
+
+/*!
+ * @brief Gets the number of elements currently in the queue.
+ *
+ * @param[in] p_queue Address of an \c ezq_vqueue to count the elements in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of elements currently within the \c ezq_vqueue
+ * pointed to by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_vcount(const ezq_vqueue * const p_queue, ezq_status * const p_status);
+
+/*!
+ * @brief Clears the queue, releasing its ring and segments.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue structure to destroy.
+ * @param[in] elem_cleanup_fn Optional function that will be invoked on the
+ * address of each remaining element, in place, in case those elements
+ * require additional cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining
+ * elements.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_vqueue pointed to by
+ * \c p_queue is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_vdestroy(
+    ezq_vqueue * const p_queue,
+    void (*elem_cleanup_fn)(void *p_elem, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_VALUE_H */
@@ -0,0 +1,198 @@
+#ifndef EASYQUEUE_WAIT_H
+#define EASYQUEUE_WAIT_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "easyqueue.h"
+#include "easyqueue_notify.h"
+
+/* Timeout value making ezq_push_wait()/ezq_pop_wait() wait indefinitely. */
+#define EZQ_WAIT_FOREVER (UINT64_MAX)
+
+#ifndef EZQ_WAIT_SPIN_LIMIT
+ /*
+  * The maximum number of times a waiting thread re-checks the queue before
+  * parking. Each queue adapts its spin count between 1 and this value,
+  * spinning for longer while spinning keeps paying off.
+  */
+ #define EZQ_WAIT_SPIN_LIMIT (1024)
+#endif /* EZQ_WAIT_SPIN_LIMIT */
+#if EZQ_WAIT_SPIN_LIMIT < 1
+ #error "Value of EZQ_WAIT_SPIN_LIMIT must be a positive integer"
+#endif /* EZQ_WAIT_SPIN_LIMIT < 1 */
+
+/*!
+ * @struct ezq_waiters
+ * @brief Structure encapsulating a set of threads waiting for a queue to
+ * change state. Threads park on the 32-bit \c seq word, which is advanced
+ * every time the state may have changed.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_waiters
+{
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint seq; /* futex word */
+    atomic_uint parked; /* number of threads parked on seq */
+    atomic_uint spin; /* current number of spins before parking */
+};
+
+/*!
+ * @struct ezq_wait_queue
+ * @brief Structure representing a thread-safe \c ezq_queue whose push and
+ * pop operations may wait for room or for an item, respectively.
+ *
+ * Waiting threads first spin briefly and then park on a futex (on Linux).
+ * Threads that change the queue only make a wake system call when another
+ * thread is parked. An \c ezq_notifier may also be attached, to be
+ * signalled whenever the queue becomes non-empty.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_wait_queue
+{
+    ezq_queue queue; /* underlying queue, guarded by lock */
+    ezq_notifier * p_notifier; /* optional notifier, guarded by lock */
+    pthread_mutex_t lock; /* serializes access to queue */
+    struct ezq_waiters not_empty; /* consumers waiting for an item */
+    struct ezq_waiters not_full; /* producers waiting for room */
+} ezq_wait_queue;
+
+/*!
+ * @brief Initializes an \c ezq_wait_queue structure such that it contains
+ * no items.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue to initialize.
+ * @param[in] capacity Maximum number of items that may be placed in the
+ * queue ( \c 0 for no limit, in which case pushes never wait).
+ * @param[in] alloc_fn Function used to allocate memory needed to store
+ * more items when the fixed size buffer is full.
+ * @param[in] free_fn Function used to release memory allocated for items
+ * when the fixed size buffer is full.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_wait_queue pointed to by
+ * \c p_queue is successfully initialized, otherwise an error-specific
+ * \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_wait_init(
+    ezq_wait_queue * const p_queue,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Gets the number of items currently in the queue.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue to count the items
+ * in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items currently within the \c ezq_wait_queue
+ * pointed to by \c p_queue .
+ */
+unsigned int EZQ_API
+ezq_wait_count(ezq_wait_queue * const p_queue, ezq_status * const p_status);
+
+/*!
+ * @brief Attaches a notifier to be signalled whenever the queue goes from
+ * empty to non-empty, replacing any notifier already attached.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue to attach the
+ * notifier to.
+ * @param[in] p_notifier Address of an initialized \c ezq_notifier , or
+ * \c NULL to detach the current notifier.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the notifier is attached to the
+ * \c ezq_wait_queue pointed to by \c p_queue , otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note If the queue is already non-empty, the notifier is signalled
+ * immediately so that its consumer starts draining the queue.
+ */
+ezq_status EZQ_API
+ezq_wait_set_notifier(
+    ezq_wait_queue * const p_queue,
+    ezq_notifier * const p_notifier
+);
+
+/*!
+ * @brief Places \c p_item at the tail end of a queue, waiting up to
+ * \c timeout_ns nanoseconds for room if the queue is full.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue in which to place
+ * the item.
+ * @param[in] p_item Pointer to arbitrary data to place on the queue. May
+ * not be \c NULL .
+ * @param[in] timeout_ns Maximum number of nanoseconds to wait. \c 0 makes a
+ * single attempt, and \c EZQ_WAIT_FOREVER waits indefinitely.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * end of the \c ezq_wait_queue pointed to by \c p_queue ,
+ * \c EZQ_STATUS_FULL if \c timeout_ns was \c 0 and the queue was full,
+ * \c EZQ_STATUS_TIMEOUT if the queue stayed full for \c timeout_ns ,
+ * otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_push_wait(
+    ezq_wait_queue * const p_queue,
+    void * const p_item,
+    const uint64_t timeout_ns
+);
+
+/*!
+ * @brief Retrieves the front item of the queue, waiting up to
+ * \c timeout_ns nanoseconds for an item if the queue is empty.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue to retrieve the
+ * front item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the queue.
+ * @param[in] timeout_ns Maximum number of nanoseconds to wait. \c 0 makes a
+ * single attempt, and \c EZQ_WAIT_FOREVER waits indefinitely.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the front item of the \c ezq_wait_queue
+ * pointed to by \c p_queue is retrieved and placed in the location pointed
+ * to by \c pp_item , \c EZQ_STATUS_EMPTY if \c timeout_ns was \c 0 and the
+ * queue was empty, \c EZQ_STATUS_TIMEOUT if the queue stayed empty for
+ * \c timeout_ns , otherwise an error-specific \c ezq_status value.
+ */
+ezq_status EZQ_API
+ezq_pop_wait(
+    ezq_wait_queue * const p_queue,
+    void ** const pp_item,
+    const uint64_t timeout_ns
+);
+
+/*!
+ * @brief Clears the queue, performing any necessary cleanup.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_wait_queue structure to
+ * destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in the queue, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_wait_queue pointed to by
+ * \c p_queue is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing or waiting on the queue.
+ */
+ezq_status EZQ_API
+ezq_wait_destroy(
+    ezq_wait_queue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_WAIT_H */
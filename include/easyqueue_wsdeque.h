@@ -0,0 +1,220 @@
+#ifndef EASYQUEUE_WSDEQUE_H
+#define EASYQUEUE_WSDEQUE_H
+
+#include <stdatomic.h>
+#include "easyqueue.h"
+
+/*!
+ * @struct ezq_wsdeque_array
+ * @brief Structure encapsulating the circular array of slots an
+ * \c ezq_wsdeque keeps its items in. Arrays outgrown by the deque are kept
+ * on a chain until the deque is destroyed, since a thief may still be
+ * reading from one.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * instances of it be dynamically allocated, but this structure is not
+ * intended to be interacted with directly.
+ */
+struct ezq_wsdeque_array
+{
+    struct ezq_wsdeque_array * p_retired; /* array this one replaced */
+    unsigned int mask; /* number of slots in the array, minus one */
+    _Atomic(void *) slots[]; /* items, indexed by position & mask */
+};
+
+/*!
+ * @struct ezq_wsdeque
+ * @brief Structure representing a Chase-Lev work-stealing deque: an
+ * unbounded deque owned by one thread, which pushes and pops items at its
+ * bottom end, while any number of other threads steal items from its top
+ * end.
+ *
+ * The owner only needs a compare-and-swap when it pops the last item, which
+ * a thief may be stealing at the same time; thieves always claim items with
+ * a compare-and-swap on the top index. Items are kept in a circular array
+ * whose capacity is a power of two, and which the owner doubles when a push
+ * finds it full.
+ *
+ * @note This structure is exposed in the header to avoid necessitating that
+ * users dynamically allocate instances of it, but instances of this structure
+ * are intended to be accessed via the API functions rather than directly.
+ */
+typedef struct ezq_wsdeque
+{
+    /* Fields below are read-only between init and destroy. */
+    void *(*alloc_fn)(const size_t size); /* function to allocate arrays */
+    void (*free_fn)(void * const ptr); /* function to release arrays */
+
+    /* Fields below are only written by the owner. */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint bottom; /* next index to fill */
+    _Atomic(struct ezq_wsdeque_array *) p_array; /* current array */
+
+    /* next index to steal; written by thieves, and by the owner when it
+     * pops the last item */
+    _Alignas(EZQ_CACHE_LINE_SIZE) atomic_uint top;
+} ezq_wsdeque;
+
+/*!
+ * @brief Initializes an \c ezq_wsdeque structure such that it contains no
+ * items.
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque to initialize.
+ * @param[in] capacity Minimum number of items the deque must be able to
+ * hold before its array first grows. This is rounded up to the next power
+ * of two.
+ * @param[in] alloc_fn Function used to allocate the deque's arrays.
+ * @param[in] free_fn Function used to release the deque's arrays.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_wsdeque pointed to by
+ * \c p_deque is successfully initialized, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the deque.
+ */
+ezq_status EZQ_API
+ezq_wsdeque_init(
+    ezq_wsdeque * const p_deque,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
+/*!
+ * @brief Gets the number of items the deque is able to hold before its
+ * array next grows.
+ *
+ * @param[in] p_deque Address of an \c ezq_wsdeque to get the capacity of.
+ *
+ * @return The capacity of the current array of the \c ezq_wsdeque pointed
+ * to by \c p_deque , or \c 0 if \c p_deque is \c NULL .
+ */
+unsigned int EZQ_API
+ezq_wsdeque_capacity(const ezq_wsdeque * const p_deque);
+
+/*!
+ * @brief Gets the number of items currently in the deque.
+ *
+ * @param[in] p_deque Address of an \c ezq_wsdeque to count the items in.
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation.
+ *
+ * @return The number of items within the \c ezq_wsdeque pointed to by
+ * \c p_deque . If the owner or any thief is active, this is a snapshot
+ * that may already be stale.
+ */
+unsigned int EZQ_API
+ezq_wsdeque_count(
+    const ezq_wsdeque * const p_deque,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Places \c p_item at the bottom end of a deque, growing its array
+ * if it is full.
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque in which to place
+ * the item.
+ * @param[in] p_item Pointer to arbitrary data to place on the deque. May
+ * not be \c NULL .
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c p_item is successfully placed at the
+ * bottom of the \c ezq_wsdeque pointed to by \c p_deque , otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function may only be called by the deque's owner.
+ */
+ezq_status EZQ_API
+ezq_wsdeque_push(ezq_wsdeque * const p_deque, void * const p_item);
+
+/*!
+ * @brief Retrieves the bottom item of the deque, i.e. the item most
+ * recently pushed, and places it in the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque to retrieve the
+ * bottom item of.
+ * @param[out] pp_item Address in which to store the item retrieved from
+ * the deque.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the bottom item of the \c ezq_wsdeque
+ * pointed to by \c p_deque is retrieved and placed in the location pointed
+ * to by \c pp_item , \c EZQ_STATUS_EMPTY if the deque is empty or its last
+ * item was stolen first, otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function may only be called by the deque's owner.
+ */
+ezq_status EZQ_API
+ezq_wsdeque_pop(ezq_wsdeque * const p_deque, void ** const pp_item);
+
+/*!
+ * @brief Retrieves the top item of the deque, i.e. the oldest item, and
+ * places it in the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque to steal the top item
+ * of.
+ * @param[out] pp_item Address in which to store the item stolen from the
+ * deque.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the top item of the \c ezq_wsdeque
+ * pointed to by \c p_deque is retrieved and placed in the location pointed
+ * to by \c pp_item , \c EZQ_STATUS_EMPTY if the deque is empty, or
+ * \c EZQ_STATUS_BUSY if another thread took the item first, in which case
+ * the steal may be retried.
+ *
+ * @note This function may be called by any thread, including the owner.
+ */
+ezq_status EZQ_API
+ezq_wsdeque_steal(ezq_wsdeque * const p_deque, void ** const pp_item);
+
+/*!
+ * @brief Steals up to half of the items in the deque, rounded up, from its
+ * top end.
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque to steal items from.
+ * @param[out] pp_items Array in which to store the stolen items, oldest
+ * first.
+ * @param[in] max Maximum number of items to steal, i.e. the number of
+ * elements in \c pp_items .
+ * @param[out] p_status Optional address of an \c ezq_status in which to
+ * place the relevant status code after the operation. If fewer items than
+ * half are stolen, this is the status of the steal that stopped short.
+ *
+ * @return The number of items stolen and placed in \c pp_items .
+ *
+ * @note Each item is claimed with its own compare-and-swap, so that the
+ * owner's pops need not contend with a thief for any but the last item.
+ * This function may be called by any thread, including the owner.
+ */
+unsigned int EZQ_API
+ezq_wsdeque_steal_half(
+    ezq_wsdeque * const p_deque,
+    void ** const pp_items,
+    const unsigned int max,
+    ezq_status * const p_status
+);
+
+/*!
+ * @brief Clears the deque and releases its current and outgrown arrays.
+ *
+ * @param[in,out] p_deque Address of an \c ezq_wsdeque structure to destroy.
+ * @param[in] item_cleanup_fn Optional function that will be invoked on each
+ * remaining item in the deque, in case those items require additional
+ * cleanup handling.
+ * @param[in] p_args Optional pointer to an arbitrary structure that may
+ * contain any additional resources necessary for cleanup of remaining items.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the \c ezq_wsdeque pointed to by
+ * \c p_deque is successfully cleared, otherwise an error-specific
+ * \c ezq_status value.
+ *
+ * @note This function must not be called while any other thread is
+ * accessing the deque.
+ */
+ezq_status EZQ_API
+ezq_wsdeque_destroy(
+    ezq_wsdeque * const p_deque,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+#endif /* EASYQUEUE_WSDEQUE_H */
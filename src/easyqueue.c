@@ -7,10 +7,176 @@
 
 typedef struct ezq_buffer ezq_buf; /* shorthand name for convenience */
 
+/* Determines whether a new node must be appended to the linked list before
+ * another item can be pushed onto it.
+ */
+#define EZQ_LIST_TAIL_FULL(p_ll) \
+    (NULL == (p_ll)->p_tail \
+    || (p_ll)->p_tail->front_index + (p_ll)->p_tail->count \
+        >= EZQ_LIST_NODE_CAPACITY)
+
+/* Gets the array currently holding the items of a buffer. */
+#define EZQ_BUF_SLOTS(p_buf) \
+    (NULL == (p_buf)->p_slots ? (p_buf)->p_items : (p_buf)->p_slots)
+
+/* Gets the number of items the array currently backing a buffer can hold. */
+#define EZQ_BUF_CAPACITY(p_buf) \
+    (NULL == (p_buf)->p_slots \
+    ? EZQ_FIXED_BUFFER_CAPACITY : (p_buf)->slot_capacity)
+
+/* When the fixed-size buffer's capacity is a power of two (and therefore so
+ * is the capacity of any buffer a growable queue moves to), a buffer's front
+ * index increases monotonically and is masked into range, since unsigned
+ * wraparound keeps it consistent. Otherwise the front index is kept within
+ * range and wrapped by comparison. Neither scheme needs a division.
+ */
+#if 0 == (EZQ_FIXED_BUFFER_CAPACITY & (EZQ_FIXED_BUFFER_CAPACITY - 1))
+ #define EZQ_FIXED_BUFFER_IS_POW2
+#endif /* 0 == (EZQ_FIXED_BUFFER_CAPACITY & (EZQ_FIXED_BUFFER_CAPACITY - 1)) */
+
+#ifdef EZQ_FIXED_BUFFER_IS_POW2
+ /* Gets the array index of the item offset places behind the front item. */
+ #define EZQ_BUF_INDEX(p_buf, offset, bound) \
+    ((((ezq_buf *)(p_buf))->front_index + (offset)) & ((bound) - 1))
+
+ /* Advances the front index of a buffer past its front n items. */
+ #define EZQ_BUF_ADVANCE(p_buf, n, bound) \
+    do \
+    { \
+        ((ezq_buf *)(p_buf))->front_index += (n); \
+        (void)(bound); \
+    } while (0)
+
+ /* Moves the front index of a buffer back by one place. */
+ #define EZQ_BUF_RETREAT(p_buf, bound) \
+    do \
+    { \
+        --((ezq_buf *)(p_buf))->front_index; \
+        (void)(bound); \
+    } while (0)
+#else
+ /* Gets the array index of the item offset places behind the front item. */
+ #define EZQ_BUF_INDEX(p_buf, offset, bound) \
+    (((ezq_buf *)(p_buf))->front_index + (offset) >= (bound) \
+    ? ((ezq_buf *)(p_buf))->front_index + (offset) - (bound) \
+    : ((ezq_buf *)(p_buf))->front_index + (offset))
+
+ /* Advances the front index of a buffer past its front n items. */
+ #define EZQ_BUF_ADVANCE(p_buf, n, bound) \
+    do \
+    { \
+        ((ezq_buf *)(p_buf))->front_index = \
+            EZQ_BUF_INDEX(p_buf, n, bound); \
+    } while (0)
+
+ /* Moves the front index of a buffer back by one place. */
+ #define EZQ_BUF_RETREAT(p_buf, bound) \
+    do \
+    { \
+        ((ezq_buf *)(p_buf))->front_index = \
+            (0 == ((ezq_buf *)(p_buf))->front_index \
+            ? (bound) : ((ezq_buf *)(p_buf))->front_index) - 1; \
+    } while (0)
+#endif /* EZQ_FIXED_BUFFER_IS_POW2 */
+
 /* Gets the next available index of the fixed size buffer. */
 #define EZQ_BUF_BACK(p_buf, bound) \
-    ((((ezq_buf *)(p_buf))->front_index % (bound)) \
-    + ((ezq_buf *)(p_buf))->count)
+    EZQ_BUF_INDEX(p_buf, ((ezq_buf *)(p_buf))->count, bound)
+
+/* Gets the lesser of two values. */
+#define EZQ_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#ifdef EZQ_ENABLE_STATS
+ /* Records that n items were placed in a queue. */
+ #define EZQ_STATS_PUSHED(p_queue, n) ezq_stats_record_unsafe(p_queue, n, 0)
+
+ /* Records that n items were taken from a queue. */
+ #define EZQ_STATS_POPPED(p_queue, n) ezq_stats_record_unsafe(p_queue, 0, n)
+
+ /* Increments one of the counters of a queue. */
+ #define EZQ_STATS_INC(p_queue, counter) (++(p_queue)->stats.counter)
+
+ /* Zeroes the counters of a queue and forgets its clock. */
+ #define EZQ_STATS_RESET(p_queue) ezq_stats_reset_unsafe(p_queue)
+
+ /* Number of metrics formatted by ezq_stats_format. */
+ #define EZQ_STATS_METRIC_COUNT (9)
+#else
+ #define EZQ_STATS_PUSHED(p_queue, n) ((void)0)
+ #define EZQ_STATS_POPPED(p_queue, n) ((void)0)
+ #define EZQ_STATS_INC(p_queue, counter) ((void)0)
+ #define EZQ_STATS_RESET(p_queue) ((void)0)
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+ /* Stamps n items just placed in a queue. */
+ #define EZQ_SOJOURN_PUSHED(p_queue, n) \
+    ezq_sojourn_record_unsafe(p_queue, n, 0)
+
+ /* Records how long n items just taken from a queue were queued. */
+ #define EZQ_SOJOURN_POPPED(p_queue, n) \
+    ezq_sojourn_record_unsafe(p_queue, 0, n)
+
+ /* Stamps n items just placed at the front of a queue. */
+ #define EZQ_SOJOURN_PUSHED_FRONT(p_queue, n) \
+    ezq_sojourn_record_reverse_unsafe(p_queue, n, 0)
+
+ /* Records how long n items just taken from the back of a queue were
+  * queued.
+  */
+ #define EZQ_SOJOURN_POPPED_BACK(p_queue, n) \
+    ezq_sojourn_record_reverse_unsafe(p_queue, 0, n)
+
+ /* Discards the stamps and histogram of a queue and forgets its clock. */
+ #define EZQ_SOJOURN_RESET(p_queue) ezq_sojourn_reset_unsafe(p_queue)
+
+ /* Number of linearly spaced buckets per power of two of the histogram. */
+ #define EZQ_SOJOURN_SUB_BUCKETS (1u << EZQ_SOJOURN_SUB_BITS)
+#else
+ #define EZQ_SOJOURN_PUSHED(p_queue, n) ((void)0)
+ #define EZQ_SOJOURN_POPPED(p_queue, n) ((void)0)
+ #define EZQ_SOJOURN_PUSHED_FRONT(p_queue, n) ((void)0)
+ #define EZQ_SOJOURN_POPPED_BACK(p_queue, n) ((void)0)
+ #define EZQ_SOJOURN_RESET(p_queue) ((void)0)
+#endif /* EZQ_ENABLE_SOJOURN */
+
+#ifdef EZQ_ENABLE_STATS
+/* Name, Prometheus type and description of each metric formatted by
+ * ezq_stats_format, in the order of its values.
+ */
+static const char * const ezq_stats_metrics[EZQ_STATS_METRIC_COUNT][3] =
+{
+    { "ezq_pushes_total", "counter", "Items placed in the queue." },
+    { "ezq_pops_total", "counter", "Items taken from the queue." },
+    {
+        "ezq_full_rejections_total",
+        "counter",
+        "Pushes refused because the queue was full."
+    },
+    {
+        "ezq_overflow_allocations_total",
+        "counter",
+        "Allocations of linked list nodes or grown buffers."
+    },
+    { "ezq_alloc_failures_total", "counter", "Allocations that failed." },
+    {
+        "ezq_spills_total",
+        "counter",
+        "Times the queue went above its fixed capacity."
+    },
+    {
+        "ezq_spill_ticks_total",
+        "counter",
+        "Clock ticks spent above the fixed capacity."
+    },
+    { "ezq_depth", "gauge", "Items currently in the queue." },
+    {
+        "ezq_depth_high_water",
+        "gauge",
+        "Greatest number of items held at once."
+    }
+};
+#endif /* EZQ_ENABLE_STATS */
 
 /*!
  * @brief Initializes an \c ezq_queue structure such that it contains no
@@ -19,6 +185,7 @@ typedef struct ezq_buffer ezq_buf; /* shorthand name for convenience */
  * @param[in,out] p_queue Address of an \c ezq_queue to initialize.
  * @param[in] capacity Maximum number of items that may be placed in the
  * queue ( \c 0 for no limit).
+ * @param[in] flags \c EZQ_FLAG_* values describing the queue's mode.
  * @param[in] alloc_fn Function used to allocate memory needed to store
  * more items when the fixed size buffer is full.
  * @param[in] free_fn Function used to release memory allocated for items
@@ -31,6 +198,7 @@ static void EZQ_API
 ezq_init_unsafe(
     ezq_queue * const p_queue,
     const unsigned int capacity,
+    const unsigned int flags,
     void *(*alloc_fn)(const size_t size),
     void (*free_fn)(void * const ptr)
 );
@@ -46,6 +214,139 @@ ezq_init_unsafe(
 static unsigned int EZQ_API
 ezq_count_unsafe(const ezq_queue * const p_queue);
 
+/*!
+ * @brief Moves the items of a growable queue's full buffer into a buffer
+ * able to hold at least \c min_capacity items.
+ *
+ * @param[in,out] p_queue Address of a growable \c ezq_queue to grow.
+ * @param[in] min_capacity Minimum number of items the new buffer must hold.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the buffer was grown, otherwise an
+ * error-specific \c ezq_status value, in which case the buffer is left
+ * unchanged.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_grow_unsafe(ezq_queue * const p_queue, const unsigned int min_capacity);
+
+/*!
+ * @brief Halves a shrinkable queue's grown buffer for as long as no more
+ * than a quarter of it is in use. A failure to do so is not an error; the
+ * larger buffer remains usable.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to shrink.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_shrink_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Appends an empty node to the queue's linked list so that further
+ * items can be pushed onto it.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to extend the linked
+ * list of.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if a node was appended, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_list_extend_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Ensures the queue's linked list has room for an item before its
+ * front item, prepending an empty node if the front node has none.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to make room in the
+ * linked list of.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if \c ezq_list_push_front may be called on
+ * the linked list, otherwise an error-specific \c ezq_status value.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_list_front_room_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Moves items from the front of the queue's linked list to the back
+ * of its fixed-size buffer until either is exhausted.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to refill.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_refill_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Removes the back item of a non-empty queue, taking it from the
+ * linked list if that holds any items and from the buffer otherwise.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to pop the back item
+ * of.
+ * @param[out] pp_item Address in which to store the popped item.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_pop_back_unsafe(ezq_queue * const p_queue, void ** const pp_item);
+
+/*!
+ * @brief Copies \c count item pointers from \c pp_src to \c pp_dst .
+ *
+ * @param[out] pp_dst Array to copy the items into.
+ * @param[in] pp_src Array to copy the items from.
+ * @param[in] count Number of items to copy.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_copy_items(
+    void ** const pp_dst,
+    void * const * const pp_src,
+    const unsigned int count
+);
+
+/*!
+ * @brief Moves the items of the buffer pointed to by \c p_buf into a new
+ * array able to hold \c new_capacity items, placing the front item at index
+ * \c 0 . If \c new_capacity is no greater than
+ * \c EZQ_FIXED_BUFFER_CAPACITY , the buffer's own \c p_items array is used.
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer to resize.
+ * @param[in] new_capacity Number of items the new array must hold. Must be
+ * no less than the number of items in the buffer.
+ * @param[in] alloc_fn Function used to allocate the new array.
+ * @param[in] free_fn Function used to release the previous array if it was
+ * dynamically allocated.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the items were moved into the new array,
+ * otherwise an error-specific \c ezq_status value, in which case the buffer
+ * is left unchanged.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_buf_resize(
+    struct ezq_buffer * const p_buf,
+    unsigned int new_capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+);
+
 /*!
  * @brief Places \c p_item into the next available location within the
  * buffer pointed to by \c p_buf .
@@ -59,6 +360,88 @@ ezq_count_unsafe(const ezq_queue * const p_queue);
 static void EZQ_API
 ezq_buf_push(struct ezq_buffer * const p_buf, void * const p_item);
 
+/*!
+ * @brief Places the \c count items in \c pp_items into the next available
+ * locations within the buffer pointed to by \c p_buf , copying at most two
+ * contiguous runs.
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer with room for at least
+ * \c count more items.
+ * @param[in] pp_items Array of items to store in the buffer.
+ * @param[in] count Number of items in \c pp_items .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_buf_push_run(
+    struct ezq_buffer * const p_buf,
+    void * const * const pp_items,
+    const unsigned int count
+);
+
+/*!
+ * @brief Removes the front \c count items from the buffer pointed to by
+ * \c p_buf and places them in \c pp_items , copying at most two
+ * contiguous runs.
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer holding at least
+ * \c count items.
+ * @param[out] pp_items Array in which to store the popped items.
+ * @param[in] count Number of items to pop.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_buf_pop_run(
+    struct ezq_buffer * const p_buf,
+    void ** const pp_items,
+    const unsigned int count
+);
+
+/*!
+ * @brief Removes the front \c count items of the buffer pointed to by
+ * \c p_buf without copying them out.
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer holding at least
+ * \c count items.
+ * @param[in] count Number of items to remove.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_buf_release_run(struct ezq_buffer * const p_buf, const unsigned int count);
+
+/*!
+ * @brief Gets the run of consecutive empty slots at the tail end of the
+ * queue's storage that the next pushed items would occupy, growing the
+ * buffer or extending the linked list first if needed.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to find slots in.
+ * @param[in] max Maximum number of slots wanted. Must be non-zero.
+ * @param[in] extend Non-zero if storage may be added when none is free.
+ * @param[out] ppp_slots Address in which to store the address of the first
+ * slot.
+ * @param[out] p_run Address in which to store the number of slots.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if any slots were found,
+ * \c EZQ_STATUS_FULL if none are free and \c extend is zero, otherwise the
+ * reason none were.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_tail_slots_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int max,
+    const int extend,
+    void *** const ppp_slots,
+    unsigned int * const p_run
+);
+
 /*!
  * @brief Removes the front item from the buffer pointed to by \c p_buf
  * and places the item in the location pointed to by \c pp_item .
@@ -73,64 +456,243 @@ static void EZQ_API
 ezq_buf_pop(struct ezq_buffer * const p_buf, void ** const pp_item);
 
 /*!
- * @brief Dynamically allocates an \c ezq_linkedlist_node and ensures
- * its fields are zero-initialized.
+ * @brief Places \c p_item before the front item of the buffer pointed to
+ * by \c p_buf .
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer to push \c p_item onto.
+ * Must not be full.
+ * @param[in] p_item Pointer to store in the buffer.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_buf_push_front(struct ezq_buffer * const p_buf, void * const p_item);
+
+/*!
+ * @brief Removes the back item from the buffer pointed to by \c p_buf
+ * and places the item in the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_buf Address of an \c ezq_buffer to pop an item from.
+ * @param[out] pp_item Address in which to store the popped item.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_buf_pop_back(struct ezq_buffer * const p_buf, void ** const pp_item);
+
+/*!
+ * @brief Obtains an empty \c ezq_linkedlist_node , reusing a node from the
+ * queue's node cache if one is available and dynamically allocating one
+ * otherwise.
  *
- * @param[in] alloc_fn Function used to allocate memory for the new
- * \c ezq_linkedlist_node .
- * @param[in] p_item Pointer to store in the resulting
- * \c ezq_linkedlist_node .
+ * @param[in,out] p_queue Address of an \c ezq_queue whose node cache and
+ * \c alloc_fn are used to obtain the node.
  *
- * @return The address of a dynamically allocated \c ezq_linkedlist_node
- * if successful, otherwise \c NULL .
+ * @return The address of an empty \c ezq_linkedlist_node if successful,
+ * otherwise \c NULL .
  *
  * @note This function performs no safety checks (e.g. checks for
  * \c NULL ) on its passed arguments in release builds.
  */
 static struct ezq_linkedlist_node * EZQ_API
-ezq_list_create_node(
-    void * (*alloc_fn)(const size_t size),
-    void * const p_item
+ezq_node_acquire(ezq_queue * const p_queue);
+
+/*!
+ * @brief Retires an \c ezq_linkedlist_node that is no longer part of the
+ * queue's linked list, placing it in the queue's node cache if the cache
+ * has room and releasing it via the queue's \c free_fn otherwise.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to retire the node to.
+ * @param[in] p_node Address of the \c ezq_linkedlist_node to retire.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_node_release(
+    ezq_queue * const p_queue,
+    struct ezq_linkedlist_node * const p_node
+);
+
+/*!
+ * @brief Releases cached nodes via \c free_fn until no more than \c keep
+ * nodes remain in the cache pointed to by \c p_cache .
+ *
+ * @param[in,out] p_cache Address of an \c ezq_nodecache to trim.
+ * @param[in] keep Number of nodes that may remain in the cache.
+ * @param[in] free_fn Function used to release the trimmed nodes.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_nodecache_trim(
+    struct ezq_nodecache * const p_cache,
+    const unsigned int keep,
+    void (*free_fn)(void * const ptr)
 );
 
 /*!
- * @brief Appends the node pointed to by \c p_newnode to the end of the
+ * @brief Appends the empty node pointed to by \c p_node to the end of the
  * linked list pointed to by \c p_ll .
  *
  * @param[in,out] p_ll Address of an \c ezq_linkedlist to append to.
- * @param[in] p_node Address of an \c ezq_linkedlist_node to append to
- * the linked list.
+ * @param[in] p_node Address of an empty \c ezq_linkedlist_node to append
+ * to the linked list.
  *
  * @note This function performs no safety checks (e.g. checks for
  * \c NULL ) on its passed arguments in release builds.
  */
 static void EZQ_API
-ezq_list_push(
+ezq_list_append_node(
     struct ezq_linkedlist * const p_ll,
     struct ezq_linkedlist_node * const p_node
 );
 
 /*!
- * @brief Removes the front node of the linked list pointed to by \c p_ll
- * and places the node's data into the location pointed to by \c pp_item .
+ * @brief Places \c p_item into the next available location of the rear
+ * node of the linked list pointed to by \c p_ll .
  *
- * @param[in,out] p_ll Address of an \c ezq_linkedlist to retrieve the
- * front node of.
- * @param[in] free_fn Function used to release memory allocated for the
- * node being removed.
- * @param[out] pp_item Address in which to store the item that was in the
- * retrieved node.
+ * @param[in,out] p_ll Address of an \c ezq_linkedlist to push onto. Its
+ * rear node must have room for another item.
+ * @param[in] p_item Pointer to store in the linked list.
  *
  * @note This function performs no safety checks (e.g. checks for
  * \c NULL ) on its passed arguments in release builds.
  */
 static void EZQ_API
-ezq_list_pop(
+ezq_list_push(struct ezq_linkedlist * const p_ll, void * const p_item);
+
+/*!
+ * @brief Places as many of the \c count items in \c pp_items as fit into
+ * the rear node of the linked list pointed to by \c p_ll .
+ *
+ * @param[in,out] p_ll Address of an \c ezq_linkedlist to push onto. Its
+ * rear node must have room for another item.
+ * @param[in] pp_items Array of items to store in the linked list.
+ * @param[in] count Number of items in \c pp_items .
+ *
+ * @return The number of items placed in the linked list.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static unsigned int EZQ_API
+ezq_list_push_run(
+    struct ezq_linkedlist * const p_ll,
+    void * const * const pp_items,
+    const unsigned int count
+);
+
+/*!
+ * @brief Removes up to \c count items from the front node of the linked
+ * list pointed to by \c p_ll and places them in \c pp_items .
+ *
+ * @param[in,out] p_ll Address of a non-empty \c ezq_linkedlist to retrieve
+ * items from.
+ * @param[out] pp_items Array in which to store the retrieved items.
+ * @param[in] count Maximum number of items to retrieve.
+ * @param[out] pp_emptied Address in which to store the front node if
+ * removing the items left it empty, in which case the node has been
+ * unlinked and the caller is responsible for retiring it, otherwise
+ * \c NULL .
+ *
+ * @return The number of items retrieved, which is never more than the
+ * number of items in the front node.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static unsigned int EZQ_API
+ezq_list_pop_run(
     struct ezq_linkedlist * const p_ll,
-    void (*free_fn)(void * const ptr),
-    void ** const pp_item
+    void ** const pp_items,
+    const unsigned int count,
+    struct ezq_linkedlist_node ** const pp_emptied
+);
+
+/*!
+ * @brief Removes the front item of the linked list pointed to by \c p_ll
+ * and places it into the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_ll Address of an \c ezq_linkedlist to retrieve the
+ * front item of.
+ * @param[out] pp_item Address in which to store the retrieved item.
+ *
+ * @return The address of the front \c ezq_linkedlist_node if removing the
+ * item left it empty, in which case the node has been unlinked and the
+ * caller is responsible for retiring it, otherwise \c NULL .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static struct ezq_linkedlist_node * EZQ_API
+ezq_list_pop(struct ezq_linkedlist * const p_ll, void ** const pp_item);
+
+/*!
+ * @brief Places \c p_item before the front item of the linked list pointed
+ * to by \c p_ll .
+ *
+ * @param[in,out] p_ll Address of an \c ezq_linkedlist to push onto. Room
+ * must have been made by \c ezq_list_front_room_unsafe .
+ * @param[in] p_item Pointer to store in the linked list.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_list_push_front(struct ezq_linkedlist * const p_ll, void * const p_item);
+
+/*!
+ * @brief Removes the back item of the linked list pointed to by \c p_ll
+ * and places it into the location pointed to by \c pp_item .
+ *
+ * @param[in,out] p_ll Address of an \c ezq_linkedlist holding at least one
+ * item to retrieve the back item of.
+ * @param[out] pp_item Address in which to store the retrieved item.
+ *
+ * @return The address of the \c ezq_linkedlist_node the item was taken
+ * from if that left it empty, in which case the node has been unlinked and
+ * the caller is responsible for retiring it, otherwise \c NULL .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static struct ezq_linkedlist_node * EZQ_API
+ezq_list_pop_back(struct ezq_linkedlist * const p_ll, void ** const pp_item);
+
+/*!
+ * @brief Appends \c p_link to the rear of the link chain pointed to by
+ * \c p_chain .
+ *
+ * @param[in,out] p_chain Address of an \c ezq_linkchain to append to.
+ * @param[in,out] p_link Address of the \c ezq_link to append.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_chain_push(
+    struct ezq_linkchain * const p_chain,
+    struct ezq_link * const p_link
 );
 
+/*!
+ * @brief Unlinks the front link of the non-empty link chain pointed to by
+ * \c p_chain .
+ *
+ * @param[in,out] p_chain Address of an \c ezq_linkchain to unlink from.
+ *
+ * @return The address of the unlinked \c ezq_link .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static struct ezq_link * EZQ_API
+ezq_chain_pop(struct ezq_linkchain * const p_chain);
+
 /*!
  * @brief Clears the queue, performing any necessary cleanup.
  *
@@ -151,13 +713,181 @@ ezq_destroy_unsafe(
     void * const p_args
 );
 
-ezq_status EZQ_API
-ezq_init(
+#ifdef EZQ_ENABLE_STATS
+/*!
+ * @brief Updates the counters of the queue after items were placed in or
+ * taken from it, tracking its depth and spells above its fixed capacity.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to update.
+ * @param[in] pushed Number of items just placed in the queue.
+ * @param[in] popped Number of items just taken from the queue.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_stats_record_unsafe(
     ezq_queue * const p_queue,
-    const unsigned int capacity,
-    void *(*alloc_fn)(const size_t size),
-    void (*free_fn)(void * const ptr)
-)
+    const unsigned int pushed,
+    const unsigned int popped
+);
+
+/*!
+ * @brief Zeroes the counters of the queue and forgets its clock.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to reset.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_stats_reset_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Appends \c p_text to the text being formatted in \c p_buf ,
+ * counting every character but storing only those that fit.
+ *
+ * @param[out] p_buf Buffer holding the text.
+ * @param[in] size Number of bytes \c p_buf can hold, including a
+ * terminator.
+ * @param[in,out] p_len Address of the length of the text so far.
+ * @param[in] p_text Terminated text to append.
+ * @param[in] escape Non-zero to escape the text as a label value.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_stats_put(
+    char * const p_buf,
+    const size_t size,
+    size_t * const p_len,
+    const char * p_text,
+    const int escape
+);
+
+/*!
+ * @brief Appends one metric, with its help and type lines, to the text
+ * being formatted in \c p_buf .
+ *
+ * @param[out] p_buf Buffer holding the text.
+ * @param[in] size Number of bytes \c p_buf can hold, including a
+ * terminator.
+ * @param[in,out] p_len Address of the length of the text so far.
+ * @param[in] pp_metric Name, Prometheus type and description of the
+ * metric.
+ * @param[in] p_name Optional name of the queue for the \c queue label.
+ * @param[in] value Value of the metric.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_stats_put_metric(
+    char * const p_buf,
+    const size_t size,
+    size_t * const p_len,
+    const char * const * const pp_metric,
+    const char * const p_name,
+    unsigned long value
+);
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+/*!
+ * @brief Stamps items just placed in the queue, or records in its histogram
+ * how long the stamped items just taken from it were queued.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to update.
+ * @param[in] pushed Number of items just placed in the queue.
+ * @param[in] popped Number of items just taken from the queue.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_sojourn_record_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int pushed,
+    const unsigned int popped
+);
+
+/*!
+ * @brief Stamps items just placed at the front of the queue, or records in
+ * its histogram how long the stamped items just taken from its back were
+ * queued.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to update.
+ * @param[in] pushed Number of items just placed at the front of the queue.
+ * @param[in] popped Number of items just taken from the back of the queue.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_sojourn_record_reverse_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int pushed,
+    const unsigned int popped
+);
+
+/*!
+ * @brief Adds a popped item's time in the queue to the histogram.
+ *
+ * @param[in,out] p_sojourn Address of the \c ezq_sojourn to update.
+ * @param[in] ticks Time the item spent in the queue.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_sojourn_sample_unsafe(
+    struct ezq_sojourn * const p_sojourn,
+    const unsigned long ticks
+);
+
+/*!
+ * @brief Discards the stamps and histogram of the queue and forgets its
+ * clock.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_queue to reset.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_sojourn_reset_unsafe(ezq_queue * const p_queue);
+
+/*!
+ * @brief Gets the histogram bucket counting a time. Times below twice
+ * \c EZQ_SOJOURN_SUB_BUCKETS have a bucket each; above that, each power of
+ * two is split into \c EZQ_SOJOURN_SUB_BUCKETS equal buckets.
+ *
+ * @param[in] ticks Time to find the bucket of.
+ *
+ * @return The index of the bucket within \c ezq_sojourn.buckets .
+ */
+static unsigned int EZQ_API
+ezq_sojourn_bucket(unsigned long ticks);
+
+/*!
+ * @brief Gets the highest time counted by a histogram bucket.
+ *
+ * @param[in] bucket Index of the bucket within \c ezq_sojourn.buckets .
+ *
+ * @return The highest time that \c ezq_sojourn_bucket maps to \c bucket .
+ */
+static unsigned long EZQ_API
+ezq_sojourn_bucket_high(const unsigned int bucket);
+#endif /* EZQ_ENABLE_SOJOURN */
+
+ezq_status EZQ_API
+ezq_init(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
 {
     ezq_status estat = EZQ_STATUS_UNKNOWN;
 
@@ -167,24 +897,112 @@ ezq_init(
         goto done;
     }
 
-    ezq_init_unsafe(p_queue, capacity, alloc_fn, free_fn);
+    ezq_init_unsafe(p_queue, capacity, 0, alloc_fn, free_fn);
     estat = EZQ_STATUS_SUCCESS;
 
 done:
     return estat;
 } /* ezq_init */
 
+ezq_status EZQ_API
+ezq_init_growable(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    const int shrink,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    ezq_init_unsafe(
+        p_queue,
+        capacity,
+        EZQ_FLAG_GROWABLE | (shrink ? EZQ_FLAG_SHRINK : 0),
+        alloc_fn,
+        free_fn
+    );
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_init_growable */
+
+ezq_status EZQ_API
+ezq_init_buffer(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    void ** const p_slots,
+    const unsigned int slot_count,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_slots)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    /* Positions are masked into range when EZQ_FIXED_BUFFER_CAPACITY is a
+     * power of two, which needs the storage to be one too. Requiring it in
+     * every build keeps the same call working whatever the configuration.
+     * */
+    if (slot_count < 1 || 0 != (slot_count & (slot_count - 1)))
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    ezq_init_unsafe(
+        p_queue,
+        capacity,
+        EZQ_FLAG_CALLER_SLOTS,
+        alloc_fn,
+        free_fn
+    );
+    for (i = 0; i < slot_count; ++i)
+    {
+        p_slots[i] = NULL;
+    }
+    p_queue->fixed.p_slots = p_slots;
+    p_queue->fixed.slot_capacity = slot_count;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_init_buffer */
+
 ezq_status EZQ_API
 ezq_push(ezq_queue * const p_queue, void * const p_item)
 {
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    struct ezq_linkedlist_node * p_newnode = NULL;
 
     if (NULL == p_queue)
     {
         estat = EZQ_STATUS_NULL_QUEUE;
         goto done;
     }
+
+    /* Any change to the queue's contents abandons an uncommitted
+     * reservation, so that ezq_commit cannot publish slots that no longer
+     * lie at the tail.
+     * */
+    p_queue->reserved = 0;
+
     if (NULL == p_item)
     {
         estat = EZQ_STATUS_NULL_ITEM;
@@ -195,34 +1013,45 @@ ezq_push(ezq_queue * const p_queue, void * const p_item)
         && p_queue->fixed.count + p_queue->dynamic.count >= p_queue->capacity
     )
     {
+        EZQ_STATS_INC(p_queue, full_rejections);
         estat = EZQ_STATUS_FULL;
         goto done;
     }
 
-    /* If the fixed buffer isn't full, add the item to it. Otherwise, add
-     * the item to the linked list.
+    /* If the fixed buffer isn't full, add the item to it. Otherwise, a
+     * growable queue doubles its buffer, and any other queue adds the item
+     * to the linked list, appending a new node first if the rear node has
+     * no room left.
      * */
-    if (p_queue->fixed.count < EZQ_FIXED_BUFFER_CAPACITY)
+    if (p_queue->fixed.count < EZQ_BUF_CAPACITY(&p_queue->fixed))
     {
         ezq_buf_push(&p_queue->fixed, p_item);
     }
-    else if (NULL == p_queue->alloc_fn)
+    else if (p_queue->flags & EZQ_FLAG_GROWABLE)
     {
-        estat = EZQ_STATUS_NO_ALLOC_FN;
-        goto done;
+        estat = ezq_grow_unsafe(p_queue, p_queue->fixed.count + 1);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+
+        ezq_buf_push(&p_queue->fixed, p_item);
     }
     else
     {
-        p_newnode = ezq_list_create_node(p_queue->alloc_fn, p_item);
-        if (NULL == p_newnode)
+        if (EZQ_LIST_TAIL_FULL(&p_queue->dynamic))
         {
-            estat = EZQ_STATUS_ALLOC_FAILURE;
-            goto done;
+            estat = ezq_list_extend_unsafe(p_queue);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
         }
 
-        ezq_list_push(&p_queue->dynamic, p_newnode);
-        p_newnode = NULL;
+        ezq_list_push(&p_queue->dynamic, p_item);
     }
+    EZQ_STATS_PUSHED(p_queue, 1);
+    EZQ_SOJOURN_PUSHED(p_queue, 1);
 
     estat = EZQ_STATUS_SUCCESS;
 
@@ -230,10 +1059,120 @@ done:
     return estat;
 } /* ezq_push */
 
+unsigned int EZQ_API
+ezq_push_n(
+    ezq_queue * const p_queue,
+    void * const * const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_status grow_estat = EZQ_STATUS_UNKNOWN;
+    unsigned int limit = count;
+    unsigned int room = 0;
+    unsigned int run = 0;
+    unsigned int pushed = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (NULL == pp_items && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Determine how many items can be pushed, remembering why the rest (if
+     * any) cannot be.
+     * */
+    estat = EZQ_STATUS_SUCCESS;
+    if (p_queue->capacity > 0)
+    {
+        room = ezq_count_unsafe(p_queue) < p_queue->capacity
+            ? p_queue->capacity - ezq_count_unsafe(p_queue) : 0;
+        if (limit > room)
+        {
+            EZQ_STATS_INC(p_queue, full_rejections);
+            limit = room;
+            estat = EZQ_STATUS_FULL;
+        }
+    }
+    for (run = 0; run < limit; ++run)
+    {
+        if (NULL == pp_items[run])
+        {
+            limit = run;
+            estat = EZQ_STATUS_NULL_ITEM;
+            break;
+        }
+    }
+
+    /* Fill the buffer first; it only has room when the linked list is
+     * empty. A growable queue grows its buffer once to fit every item.
+     * */
+    run = EZQ_MIN(
+        limit,
+        EZQ_BUF_CAPACITY(&p_queue->fixed) - p_queue->fixed.count
+    );
+    if (run < limit && (p_queue->flags & EZQ_FLAG_GROWABLE))
+    {
+        grow_estat = limit > (unsigned int)-1 - p_queue->fixed.count
+            ? EZQ_STATUS_FULL
+            : ezq_grow_unsafe(p_queue, p_queue->fixed.count + limit);
+        if (EZQ_STATUS_SUCCESS == grow_estat)
+        {
+            run = limit;
+        }
+        else
+        {
+            limit = run;
+            estat = grow_estat;
+        }
+    }
+    ezq_buf_push_run(&p_queue->fixed, pp_items, run);
+    pushed = run;
+
+    /* Place the remaining items in the linked list a node at a time. */
+    while (pushed < limit)
+    {
+        if (EZQ_LIST_TAIL_FULL(&p_queue->dynamic))
+        {
+            grow_estat = ezq_list_extend_unsafe(p_queue);
+            if (EZQ_STATUS_SUCCESS != grow_estat)
+            {
+                estat = grow_estat;
+                break;
+            }
+        }
+
+        pushed += ezq_list_push_run(
+            &p_queue->dynamic,
+            pp_items + pushed,
+            limit - pushed
+        );
+    }
+    EZQ_STATS_PUSHED(p_queue, pushed);
+    EZQ_SOJOURN_PUSHED(p_queue, pushed);
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return pushed;
+} /* ezq_push_n */
+
 ezq_status EZQ_API
 ezq_pop(ezq_queue * const p_queue, void ** const pp_item)
 {
     ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node * p_oldnode = NULL;
     void * p_item = NULL;
 
     if (NULL == p_queue)
@@ -241,6 +1180,14 @@ ezq_pop(ezq_queue * const p_queue, void ** const pp_item)
         estat = EZQ_STATUS_NULL_QUEUE;
         goto done;
     }
+
+    p_queue->reserved = 0;
+
+    if (p_queue->flags & EZQ_FLAG_LIFO)
+    {
+        estat = ezq_pop_back(p_queue, pp_item);
+        goto done;
+    }
     if (NULL == pp_item)
     {
         estat = EZQ_STATUS_NULL_OUT;
@@ -262,25 +1209,31 @@ ezq_pop(ezq_queue * const p_queue, void ** const pp_item)
     /* Move front item of the linked list to the back of the fixed buffer. */
     if (p_queue->dynamic.count > 0)
     {
-        ezq_list_pop(&p_queue->dynamic, p_queue->free_fn, &p_item);
+        p_oldnode = ezq_list_pop(&p_queue->dynamic, &p_item);
+        if (NULL != p_oldnode)
+        {
+            ezq_node_release(p_queue, p_oldnode);
+            p_oldnode = NULL;
+        }
 
-        p_queue->fixed.p_items[
-            (p_queue->fixed.front_index - 1) % EZQ_FIXED_BUFFER_CAPACITY
-        ] = p_item;
-        ++p_queue->fixed.count;
+        ezq_buf_push(&p_queue->fixed, p_item);
     }
 
+    ezq_shrink_unsafe(p_queue);
+    EZQ_STATS_POPPED(p_queue, 1);
+    EZQ_SOJOURN_POPPED(p_queue, 1);
+
     estat = EZQ_STATUS_SUCCESS;
 
 done:
     return estat;
 } /* ezq_pop */
 
-unsigned int EZQ_API
-ezq_count(const ezq_queue * const p_queue, ezq_status * const p_status)
+ezq_status EZQ_API
+ezq_push_front(ezq_queue * const p_queue, void * const p_item)
 {
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    unsigned int count = 0;
+    void * p_back = NULL;
 
     if (NULL == p_queue)
     {
@@ -288,179 +1241,1821 @@ ezq_count(const ezq_queue * const p_queue, ezq_status * const p_status)
         goto done;
     }
 
-    count = ezq_count_unsafe(p_queue);
-    estat = EZQ_STATUS_SUCCESS;
+    p_queue->reserved = 0;
 
-done:
-    if (NULL != p_status)
+    if (NULL == p_item)
     {
-        *p_status = estat;
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
     }
-    return count;
-} /* ezq_count */
-
-ezq_status EZQ_API
-ezq_destroy(
-    ezq_queue * const p_queue,
-    void (*item_cleanup_fn)(void *p_item, void *p_args),
-    void * const p_args
-)
-{
-    ezq_status estat = EZQ_STATUS_UNKNOWN;
-
-    if (NULL == p_queue)
+    if (
+        p_queue->capacity > 0
+        && p_queue->fixed.count + p_queue->dynamic.count >= p_queue->capacity
+    )
     {
-        estat = EZQ_STATUS_NULL_QUEUE;
+        EZQ_STATS_INC(p_queue, full_rejections);
+        estat = EZQ_STATUS_FULL;
         goto done;
     }
-    if (p_queue->dynamic.count > 0 && NULL == p_queue->free_fn)
+
+    /* The buffer holds the front items, so the item always goes into it.
+     * When it is full, a growable queue doubles it, and any other queue
+     * moves its back item to the front of the linked list to make room.
+     * */
+    if (p_queue->fixed.count >= EZQ_BUF_CAPACITY(&p_queue->fixed))
     {
-        estat = EZQ_STATUS_NO_FREE_FN;
-        goto done;
+        if (p_queue->flags & EZQ_FLAG_GROWABLE)
+        {
+            estat = ezq_grow_unsafe(p_queue, p_queue->fixed.count + 1);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+        }
+        else
+        {
+            estat = ezq_list_front_room_unsafe(p_queue);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+
+            ezq_buf_pop_back(&p_queue->fixed, &p_back);
+            ezq_list_push_front(&p_queue->dynamic, p_back);
+        }
     }
 
-    ezq_destroy_unsafe(p_queue, item_cleanup_fn, p_args);
+    ezq_buf_push_front(&p_queue->fixed, p_item);
+    EZQ_STATS_PUSHED(p_queue, 1);
+    EZQ_SOJOURN_PUSHED_FRONT(p_queue, 1);
 
     estat = EZQ_STATUS_SUCCESS;
 
 done:
     return estat;
-} /* ezq_destroy */
+} /* ezq_push_front */
 
-static void EZQ_API
-ezq_init_unsafe(
-    ezq_queue * const p_queue,
-    const unsigned int capacity,
-    void *(*alloc_fn)(const size_t size),
-    void (*free_fn)(void * const ptr)
-)
+ezq_status EZQ_API
+ezq_pop_back(ezq_queue * const p_queue, void ** const pp_item)
 {
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->fixed.count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+    if (p_queue->dynamic.count > 0 && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    ezq_pop_back_unsafe(p_queue, pp_item);
+    EZQ_STATS_POPPED(p_queue, 1);
+    EZQ_SOJOURN_POPPED_BACK(p_queue, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_pop_back */
+
+unsigned int EZQ_API
+ezq_pop_n(
+    ezq_queue * const p_queue,
+    void ** const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node * p_oldnode = NULL;
+    unsigned int limit = count;
+    unsigned int popped = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (NULL == pp_items && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->dynamic.count > 0 && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    if (limit > ezq_count_unsafe(p_queue))
+    {
+        limit = ezq_count_unsafe(p_queue);
+        estat = EZQ_STATUS_EMPTY;
+    }
+
+    /* A queue in LIFO mode takes its items from the back one at a time. */
+    if (p_queue->flags & EZQ_FLAG_LIFO)
+    {
+        for (popped = 0; popped < limit; ++popped)
+        {
+            ezq_pop_back_unsafe(p_queue, &pp_items[popped]);
+        }
+        EZQ_STATS_POPPED(p_queue, popped);
+        EZQ_SOJOURN_POPPED_BACK(p_queue, popped);
+        goto done;
+    }
+
+    /* The buffer holds the oldest items, so drain it first, then take any
+     * further items straight from the linked list a node at a time.
+     * */
+    popped = EZQ_MIN(limit, p_queue->fixed.count);
+    ezq_buf_pop_run(&p_queue->fixed, pp_items, popped);
+    while (popped < limit)
+    {
+        popped += ezq_list_pop_run(
+            &p_queue->dynamic,
+            pp_items + popped,
+            limit - popped,
+            &p_oldnode
+        );
+        if (NULL != p_oldnode)
+        {
+            ezq_node_release(p_queue, p_oldnode);
+            p_oldnode = NULL;
+        }
+    }
+
+    ezq_refill_unsafe(p_queue);
+    ezq_shrink_unsafe(p_queue);
+    EZQ_STATS_POPPED(p_queue, popped);
+    EZQ_SOJOURN_POPPED(p_queue, popped);
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return popped;
+} /* ezq_pop_n */
+
+unsigned int EZQ_API
+ezq_reserve(
+    ezq_queue * const p_queue,
+    const unsigned int count,
+    void *** const ppp_slots,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int limit = count;
+    unsigned int run = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == ppp_slots)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (p_queue->capacity > 0)
+    {
+        limit = ezq_count_unsafe(p_queue) < p_queue->capacity
+            ? EZQ_MIN(limit, p_queue->capacity - ezq_count_unsafe(p_queue))
+            : 0;
+    }
+    if (limit < 1 && count > 0)
+    {
+        EZQ_STATS_INC(p_queue, full_rejections);
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+    if (limit < 1)
+    {
+        estat = EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+
+    estat = ezq_tail_slots_unsafe(p_queue, limit, 1, ppp_slots, &run);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    /* Slots are handed out cleared so that unwritten ones are detected by
+     * ezq_commit.
+     * */
+    for (p_queue->reserved = 0; p_queue->reserved < run; ++p_queue->reserved)
+    {
+        (*ppp_slots)[p_queue->reserved] = NULL;
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return run;
+} /* ezq_reserve */
+
+ezq_status EZQ_API
+ezq_commit(ezq_queue * const p_queue, const unsigned int count)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void ** p_slots = NULL;
+    unsigned int run = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (count > p_queue->reserved)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    if (count < 1)
+    {
+        p_queue->reserved = 0;
+        estat = EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* The reservation is still the first run of free slots at the tail,
+     * so finding it must not add storage.
+     * */
+    estat = ezq_tail_slots_unsafe(p_queue, count, 0, &p_slots, &run);
+    if (EZQ_STATUS_SUCCESS != estat || run < count)
+    {
+        p_queue->reserved = 0;
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    for (i = 0; i < count; ++i)
+    {
+        if (NULL == p_slots[i])
+        {
+            estat = EZQ_STATUS_NULL_ITEM;
+            goto done;
+        }
+    }
+
+    if (p_queue->fixed.count < EZQ_BUF_CAPACITY(&p_queue->fixed))
+    {
+        p_queue->fixed.count += count;
+    }
+    else
+    {
+        p_queue->dynamic.p_tail->count += count;
+        p_queue->dynamic.count += count;
+    }
+    p_queue->reserved = 0;
+    EZQ_STATS_PUSHED(p_queue, count);
+    EZQ_SOJOURN_PUSHED(p_queue, count);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_commit */
+
+unsigned int EZQ_API
+ezq_peek(
+    ezq_queue * const p_queue,
+    void *** const ppp_items,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int slot_capacity = 0;
+    unsigned int front = 0;
+    unsigned int run = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == ppp_items)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->fixed.count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    /* The buffer always holds the front items; hand out those before the
+     * end of its array.
+     * */
+    slot_capacity = EZQ_BUF_CAPACITY(&p_queue->fixed);
+    front = EZQ_BUF_INDEX(&p_queue->fixed, 0, slot_capacity);
+    run = EZQ_MIN(p_queue->fixed.count, slot_capacity - front);
+    *ppp_items = &EZQ_BUF_SLOTS(&p_queue->fixed)[front];
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return run;
+} /* ezq_peek */
+
+ezq_status EZQ_API
+ezq_release(ezq_queue * const p_queue, const unsigned int count)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (count > p_queue->fixed.count)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+    if (p_queue->dynamic.count > 0 && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    ezq_buf_release_run(&p_queue->fixed, count);
+    ezq_refill_unsafe(p_queue);
+    ezq_shrink_unsafe(p_queue);
+    EZQ_STATS_POPPED(p_queue, count);
+    EZQ_SOJOURN_POPPED(p_queue, count);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_release */
+
+ezq_status EZQ_API
+ezq_ipush(ezq_queue * const p_queue, struct ezq_link * const p_link)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (NULL == p_link)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+    if (
+        p_queue->capacity > 0
+        && p_queue->fixed.count + p_queue->links.count >= p_queue->capacity
+    )
+    {
+        EZQ_STATS_INC(p_queue, full_rejections);
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    /* The buffer holds the oldest items, so once anything has been chained
+     * every later item must be chained too.
+     * */
+    if (
+        0 == p_queue->links.count
+        && p_queue->fixed.count < EZQ_BUF_CAPACITY(&p_queue->fixed)
+    )
+    {
+        ezq_buf_push(&p_queue->fixed, p_link);
+    }
+    else
+    {
+        ezq_chain_push(&p_queue->links, p_link);
+    }
+    EZQ_STATS_PUSHED(p_queue, 1);
+    EZQ_SOJOURN_PUSHED(p_queue, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ipush */
+
+ezq_status EZQ_API
+ezq_ipop(ezq_queue * const p_queue, struct ezq_link ** const pp_link)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_item = NULL;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_queue->reserved = 0;
+
+    if (NULL == pp_link)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->fixed.count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    ezq_buf_pop(&p_queue->fixed, &p_item);
+    *pp_link = (struct ezq_link *)p_item;
+
+    /* Move the front link of the chain to the back of the fixed buffer. */
+    if (p_queue->links.count > 0)
+    {
+        ezq_buf_push(&p_queue->fixed, ezq_chain_pop(&p_queue->links));
+    }
+    EZQ_STATS_POPPED(p_queue, 1);
+    EZQ_SOJOURN_POPPED(p_queue, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ipop */
+
+unsigned int EZQ_API
+ezq_count(const ezq_queue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    count = ezq_count_unsafe(p_queue) + p_queue->links.count;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_count */
+
+ezq_status EZQ_API
+ezq_set_node_cache_limit(ezq_queue * const p_queue, const unsigned int limit)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (p_queue->node_cache.count > limit && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    ezq_nodecache_trim(&p_queue->node_cache, limit, p_queue->free_fn);
+    p_queue->node_cache.limit = limit;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_set_node_cache_limit */
+
+ezq_status EZQ_API
+ezq_set_lifo(ezq_queue * const p_queue, const int lifo)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    if (lifo)
+    {
+        p_queue->flags |= EZQ_FLAG_LIFO;
+    }
+    else
+    {
+        p_queue->flags &= ~EZQ_FLAG_LIFO;
+    }
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_set_lifo */
+
+ezq_status EZQ_API
+ezq_trim(ezq_queue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (p_queue->node_cache.count > 0 && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    ezq_nodecache_trim(&p_queue->node_cache, 0, p_queue->free_fn);
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_trim */
+
+#ifdef EZQ_ENABLE_STATS
+ezq_status EZQ_API
+ezq_stats(const ezq_queue * const p_queue, struct ezq_stats * const p_stats)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int fixed_capacity = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_stats)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    *p_stats = p_queue->stats;
+
+    /* Include the current spell above the fixed capacity, if any. */
+    fixed_capacity = (p_queue->flags & EZQ_FLAG_CALLER_SLOTS)
+        ? p_queue->fixed.slot_capacity : EZQ_FIXED_BUFFER_CAPACITY;
+    if (NULL != p_queue->clock_fn && p_stats->depth > fixed_capacity)
+    {
+        p_stats->spill_ticks += p_queue->clock_fn() - p_queue->spill_start;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_stats */
+
+ezq_status EZQ_API
+ezq_set_stats_clock(
+    ezq_queue * const p_queue,
+    unsigned long (*clock_fn)(void)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* A spell already underway is timed from now. */
+    p_queue->clock_fn = clock_fn;
+    p_queue->spill_start = NULL == clock_fn ? 0 : clock_fn();
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_set_stats_clock */
+
+size_t EZQ_API
+ezq_stats_format(
+    const struct ezq_stats * const p_stats,
+    const char * const p_name,
+    char * const p_buf,
+    const size_t size,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned long values[EZQ_STATS_METRIC_COUNT];
+    unsigned int i = 0;
+    size_t len = 0;
+
+    if (NULL == p_stats)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_buf && size > 0)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    values[0] = p_stats->pushes;
+    values[1] = p_stats->pops;
+    values[2] = p_stats->full_rejections;
+    values[3] = p_stats->overflow_allocs;
+    values[4] = p_stats->alloc_failures;
+    values[5] = p_stats->spills;
+    values[6] = p_stats->spill_ticks;
+    values[7] = p_stats->depth;
+    values[8] = p_stats->high_water;
+    for (i = 0; i < EZQ_STATS_METRIC_COUNT; ++i)
+    {
+        ezq_stats_put_metric(
+            p_buf,
+            size,
+            &len,
+            ezq_stats_metrics[i],
+            p_name,
+            values[i]
+        );
+    }
+
+    if (size > 0)
+    {
+        p_buf[len < size ? len : size - 1] = '\0';
+    }
+    estat = len < size ? EZQ_STATUS_SUCCESS : EZQ_STATUS_FULL;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return len;
+} /* ezq_stats_format */
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+ezq_status EZQ_API
+ezq_set_sojourn_clock(
+    ezq_queue * const p_queue,
+    unsigned long (*clock_fn)(void)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* Stamps taken with another clock cannot be compared with this one. */
+    p_queue->sojourn.clock_fn = clock_fn;
+    p_queue->sojourn.stamp_front = 0;
+    p_queue->sojourn.stamp_count = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_set_sojourn_clock */
+
+unsigned long EZQ_API
+ezq_sojourn_percentile(
+    const ezq_queue * const p_queue,
+    const unsigned int per_mille,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    const unsigned long share = EZQ_MIN(per_mille, 1000);
+    unsigned long ticks = 0;
+    unsigned long rank = 0;
+    unsigned long seen = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (p_queue->sojourn.samples < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    /* Find the bucket holding the timed item of the percentile's rank,
+     * which is rounded up and computed in parts to avoid overflowing.
+     * */
+    rank = p_queue->sojourn.samples / 1000 * share
+        + (p_queue->sojourn.samples % 1000 * share + 999) / 1000;
+    rank = rank < 1 ? 1 : rank;
+    for (i = 0; seen < rank; ++i)
+    {
+        seen += p_queue->sojourn.buckets[i];
+    }
+
+    ticks = EZQ_MIN(ezq_sojourn_bucket_high(i - 1), p_queue->sojourn.max);
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return ticks;
+} /* ezq_sojourn_percentile */
+
+ezq_status EZQ_API
+ezq_sojourn(
+    const ezq_queue * const p_queue,
+    struct ezq_sojourn_summary * const p_summary
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_summary)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    p_summary->samples = p_queue->sojourn.samples;
+    p_summary->p50 = ezq_sojourn_percentile(p_queue, 500, &estat);
+    p_summary->p99 = ezq_sojourn_percentile(p_queue, 990, NULL);
+    p_summary->p999 = ezq_sojourn_percentile(p_queue, 999, NULL);
+    p_summary->max = p_queue->sojourn.max;
+
+done:
+    return estat;
+} /* ezq_sojourn */
+
+ezq_status EZQ_API
+ezq_sojourn_reset(ezq_queue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    for (i = 0; i < EZQ_SOJOURN_BUCKETS; ++i)
+    {
+        p_queue->sojourn.buckets[i] = 0;
+    }
+    p_queue->sojourn.samples = 0;
+    p_queue->sojourn.max = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_sojourn_reset */
+#endif /* EZQ_ENABLE_SOJOURN */
+
+ezq_status EZQ_API
+ezq_destroy(
+    ezq_queue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (
+        (
+            p_queue->dynamic.count > 0
+            || p_queue->node_cache.count > 0
+            || (
+                NULL != p_queue->fixed.p_slots
+                && !(p_queue->flags & EZQ_FLAG_CALLER_SLOTS)
+            )
+        )
+        && NULL == p_queue->free_fn
+    )
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    ezq_destroy_unsafe(p_queue, item_cleanup_fn, p_args);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_destroy */
+
+static void EZQ_API
+ezq_init_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int capacity,
+    const unsigned int flags,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    unsigned int i = 0;
+    assert(NULL != p_queue);
+
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        p_queue->fixed.p_items[i] = NULL;
+    }
+    p_queue->fixed.p_slots = NULL;
+    p_queue->fixed.slot_capacity = 0;
+    p_queue->fixed.front_index = 0;
+    p_queue->fixed.count = 0;
+
+    p_queue->dynamic.p_head = NULL;
+    p_queue->dynamic.p_tail = NULL;
+    p_queue->dynamic.count = 0;
+
+    p_queue->links.p_head = NULL;
+    p_queue->links.p_tail = NULL;
+    p_queue->links.count = 0;
+
+    p_queue->node_cache.p_top = NULL;
+    p_queue->node_cache.count = 0;
+    p_queue->node_cache.limit = EZQ_DEFAULT_NODE_CACHE_LIMIT;
+
+    p_queue->capacity = capacity;
+    p_queue->flags = flags;
+    p_queue->reserved = 0;
+    p_queue->alloc_fn = alloc_fn;
+    p_queue->free_fn = free_fn;
+    EZQ_STATS_RESET(p_queue);
+    EZQ_SOJOURN_RESET(p_queue);
+} /* ezq_init_unsafe */
+
+static unsigned int EZQ_API
+ezq_count_unsafe(const ezq_queue * const p_queue)
+{
+    assert(NULL != p_queue);
+
+    return p_queue->fixed.count + p_queue->dynamic.count;
+} /* ezq_count_unsafe */
+
+static ezq_status EZQ_API
+ezq_grow_unsafe(ezq_queue * const p_queue, const unsigned int min_capacity)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int new_capacity = 0;
+
+    assert(NULL != p_queue);
+
+    if (NULL == p_queue->alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL != p_queue->fixed.p_slots && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    /* Keep doubling so that the capacity stays a multiple of the fixed
+     * capacity by a power of two.
+     * */
+    new_capacity = EZQ_BUF_CAPACITY(&p_queue->fixed);
+    while (new_capacity < min_capacity)
+    {
+        if (new_capacity > (unsigned int)-1 / 2)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+        new_capacity *= 2;
+    }
+
+    estat = ezq_buf_resize(
+        &p_queue->fixed,
+        new_capacity,
+        p_queue->alloc_fn,
+        p_queue->free_fn
+    );
+    if (EZQ_STATUS_SUCCESS == estat)
+    {
+        EZQ_STATS_INC(p_queue, overflow_allocs);
+    }
+    else
+    {
+        EZQ_STATS_INC(p_queue, alloc_failures);
+    }
+
+done:
+    return estat;
+} /* ezq_grow_unsafe */
+
+static void EZQ_API
+ezq_shrink_unsafe(ezq_queue * const p_queue)
+{
+    unsigned int new_capacity = 0;
+
+    assert(NULL != p_queue);
+
+    if (
+        !(p_queue->flags & EZQ_FLAG_SHRINK)
+        || NULL == p_queue->fixed.p_slots
+        || NULL == p_queue->free_fn
+    )
+    {
+        return;
+    }
+
+    new_capacity = p_queue->fixed.slot_capacity;
+    while (
+        new_capacity > EZQ_FIXED_BUFFER_CAPACITY
+        && p_queue->fixed.count <= new_capacity / 4
+    )
+    {
+        new_capacity /= 2;
+    }
+    if (new_capacity < p_queue->fixed.slot_capacity)
+    {
+        (void)ezq_buf_resize(
+            &p_queue->fixed,
+            new_capacity,
+            p_queue->alloc_fn,
+            p_queue->free_fn
+        );
+    }
+} /* ezq_shrink_unsafe */
+
+static ezq_status EZQ_API
+ezq_list_extend_unsafe(ezq_queue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node * p_newnode = NULL;
+
+    assert(NULL != p_queue);
+
+    if (NULL == p_queue->alloc_fn && NULL == p_queue->node_cache.p_top)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+
+    p_newnode = ezq_node_acquire(p_queue);
+    if (NULL == p_newnode)
+    {
+        EZQ_STATS_INC(p_queue, alloc_failures);
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    ezq_list_append_node(&p_queue->dynamic, p_newnode);
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_list_extend_unsafe */
+
+static ezq_status EZQ_API
+ezq_list_front_room_unsafe(ezq_queue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist * p_ll = NULL;
+    struct ezq_linkedlist_node * p_newnode = NULL;
+
+    assert(NULL != p_queue);
+    p_ll = &p_queue->dynamic;
+
+    /* An empty list's front is also its back, so it is pushed onto as
+     * usual. Otherwise the front node may have room left by earlier pops.
+     * */
+    if (0 == p_ll->count)
+    {
+        estat = EZQ_LIST_TAIL_FULL(p_ll)
+            ? ezq_list_extend_unsafe(p_queue)
+            : EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+    if (p_ll->p_head->front_index > 0)
+    {
+        estat = EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+
+    if (NULL == p_queue->alloc_fn && NULL == p_queue->node_cache.p_top)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+
+    p_newnode = ezq_node_acquire(p_queue);
+    if (NULL == p_newnode)
+    {
+        EZQ_STATS_INC(p_queue, alloc_failures);
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    /* The new node is filled from its end towards its start. */
+    p_newnode->front_index = EZQ_LIST_NODE_CAPACITY;
+    p_newnode->p_next = p_ll->p_head;
+    p_ll->p_head->p_prev = p_newnode;
+    p_ll->p_head = p_newnode;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_list_front_room_unsafe */
+
+static ezq_status EZQ_API
+ezq_tail_slots_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int max,
+    const int extend,
+    void *** const ppp_slots,
+    unsigned int * const p_run
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node * p_rear = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int back = 0;
+
+    assert(NULL != p_queue);
+    assert(NULL != ppp_slots);
+    assert(NULL != p_run);
+    assert(max > 0);
+
+    /* The buffer only has room when the linked list is empty. A growable
+     * queue grows its buffer rather than using the list.
+     * */
+    if (
+        p_queue->fixed.count >= EZQ_BUF_CAPACITY(&p_queue->fixed)
+        && (p_queue->flags & EZQ_FLAG_GROWABLE)
+    )
+    {
+        if (!extend)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+        estat = max > (unsigned int)-1 - p_queue->fixed.count
+            ? EZQ_STATUS_FULL
+            : ezq_grow_unsafe(p_queue, p_queue->fixed.count + max);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+    if (p_queue->fixed.count < EZQ_BUF_CAPACITY(&p_queue->fixed))
+    {
+        slot_capacity = EZQ_BUF_CAPACITY(&p_queue->fixed);
+        back = EZQ_BUF_BACK(&p_queue->fixed, slot_capacity);
+        *ppp_slots = &EZQ_BUF_SLOTS(&p_queue->fixed)[back];
+        *p_run = EZQ_MIN(
+            max,
+            EZQ_MIN(slot_capacity - p_queue->fixed.count, slot_capacity - back)
+        );
+        estat = EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+
+    if (EZQ_LIST_TAIL_FULL(&p_queue->dynamic))
+    {
+        if (!extend)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+        estat = ezq_list_extend_unsafe(p_queue);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+    p_rear = p_queue->dynamic.p_tail;
+    *ppp_slots = &p_rear->p_items[p_rear->front_index + p_rear->count];
+    *p_run = EZQ_MIN(
+        max,
+        EZQ_LIST_NODE_CAPACITY - (p_rear->front_index + p_rear->count)
+    );
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_tail_slots_unsafe */
+
+static void EZQ_API
+ezq_refill_unsafe(ezq_queue * const p_queue)
+{
+    struct ezq_linkedlist_node * p_oldnode = NULL;
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int back = 0;
+    unsigned int moved = 0;
+
+    assert(NULL != p_queue);
+
+    p_slots = EZQ_BUF_SLOTS(&p_queue->fixed);
+    slot_capacity = EZQ_BUF_CAPACITY(&p_queue->fixed);
+
+    /* Each pass fills the contiguous free run behind the buffer's back
+     * item from the front node of the list.
+     * */
+    while (
+        p_queue->dynamic.count > 0
+        && p_queue->fixed.count < slot_capacity
+    )
+    {
+        back = EZQ_BUF_BACK(&p_queue->fixed, slot_capacity);
+        moved = ezq_list_pop_run(
+            &p_queue->dynamic,
+            &p_slots[back],
+            EZQ_MIN(
+                slot_capacity - p_queue->fixed.count,
+                slot_capacity - back
+            ),
+            &p_oldnode
+        );
+        p_queue->fixed.count += moved;
+        if (NULL != p_oldnode)
+        {
+            ezq_node_release(p_queue, p_oldnode);
+            p_oldnode = NULL;
+        }
+    }
+} /* ezq_refill_unsafe */
+
+static void EZQ_API
+ezq_pop_back_unsafe(ezq_queue * const p_queue, void ** const pp_item)
+{
+    struct ezq_linkedlist_node * p_oldnode = NULL;
+
+    assert(NULL != p_queue);
+    assert(NULL != pp_item);
+    assert(p_queue->fixed.count > 0);
+
+    /* The linked list only holds items while the buffer is full, and holds
+     * the newest of them. Taking from it leaves the buffer full.
+     * */
+    if (p_queue->dynamic.count > 0)
+    {
+        p_oldnode = ezq_list_pop_back(&p_queue->dynamic, pp_item);
+        if (NULL != p_oldnode)
+        {
+            ezq_node_release(p_queue, p_oldnode);
+        }
+    }
+    else
+    {
+        ezq_buf_pop_back(&p_queue->fixed, pp_item);
+        ezq_shrink_unsafe(p_queue);
+    }
+} /* ezq_pop_back_unsafe */
+
+static void EZQ_API
+ezq_copy_items(
+    void ** const pp_dst,
+    void * const * const pp_src,
+    const unsigned int count
+)
+{
+    unsigned int i = 0;
+
+    assert(NULL != pp_dst || 0 == count);
+    assert(NULL != pp_src || 0 == count);
+
+    for (i = 0; i < count; ++i)
+    {
+        pp_dst[i] = pp_src[i];
+    }
+} /* ezq_copy_items */
+
+static ezq_status EZQ_API
+ezq_buf_resize(
+    struct ezq_buffer * const p_buf,
+    unsigned int new_capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void ** p_old = NULL;
+    void ** p_new = NULL;
+    unsigned int old_capacity = 0;
+    unsigned int i = 0;
+    size_t size = 0;
+
+    assert(NULL != p_buf);
+    assert(new_capacity >= p_buf->count);
+
+    p_old = EZQ_BUF_SLOTS(p_buf);
+    old_capacity = EZQ_BUF_CAPACITY(p_buf);
+
+    if (new_capacity <= EZQ_FIXED_BUFFER_CAPACITY)
+    {
+        p_new = p_buf->p_items;
+        new_capacity = EZQ_FIXED_BUFFER_CAPACITY;
+    }
+    else
+    {
+        /* Guard against the size calculation wrapping on narrow targets. */
+        size = (size_t)new_capacity * sizeof(*p_new);
+        if (size / sizeof(*p_new) != new_capacity)
+        {
+            estat = EZQ_STATUS_ALLOC_FAILURE;
+            goto done;
+        }
+
+        assert(NULL != alloc_fn);
+        p_new = alloc_fn(size);
+        if (NULL == p_new)
+        {
+            estat = EZQ_STATUS_ALLOC_FAILURE;
+            goto done;
+        }
+    }
+    assert(p_new != p_old);
+
+    for (i = 0; i < p_buf->count; ++i)
+    {
+        p_new[i] = p_old[EZQ_BUF_INDEX(p_buf, i, old_capacity)];
+    }
+    for (; i < new_capacity; ++i)
+    {
+        p_new[i] = NULL;
+    }
+
+    if (p_old != p_buf->p_items)
+    {
+        assert(NULL != free_fn);
+        free_fn(p_old);
+    }
+    p_buf->p_slots = p_new == p_buf->p_items ? NULL : p_new;
+    p_buf->slot_capacity = p_new == p_buf->p_items ? 0 : new_capacity;
+    p_buf->front_index = 0;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_buf_resize */
+
+static void EZQ_API
+ezq_buf_push(struct ezq_buffer * const p_buf, void * const p_item)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+
+    assert(NULL != p_buf);
+    assert(NULL != p_item);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+    if (p_buf->count < slot_capacity)
+    {
+        p_slots[EZQ_BUF_BACK(p_buf, slot_capacity)] = p_item;
+        ++p_buf->count;
+    }
+} /* ezq_buf_push */
+
+static void EZQ_API
+ezq_buf_push_run(
+    struct ezq_buffer * const p_buf,
+    void * const * const pp_items,
+    const unsigned int count
+)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int back = 0;
+    unsigned int first = 0;
+
+    assert(NULL != p_buf);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+    assert(count <= slot_capacity - p_buf->count);
+
+    /* Copy up to the end of the array, then wrap around to its start. */
+    back = EZQ_BUF_BACK(p_buf, slot_capacity);
+    first = EZQ_MIN(count, slot_capacity - back);
+    ezq_copy_items(&p_slots[back], pp_items, first);
+    ezq_copy_items(p_slots, pp_items + first, count - first);
+    p_buf->count += count;
+} /* ezq_buf_push_run */
+
+static void EZQ_API
+ezq_buf_pop_run(
+    struct ezq_buffer * const p_buf,
+    void ** const pp_items,
+    const unsigned int count
+)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int front = 0;
+    unsigned int first = 0;
+
+    assert(NULL != p_buf);
+    assert(count <= p_buf->count);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+
+    /* Copy up to the end of the array, then wrap around to its start. */
+    front = EZQ_BUF_INDEX(p_buf, 0, slot_capacity);
+    first = EZQ_MIN(count, slot_capacity - front);
+    ezq_copy_items(pp_items, &p_slots[front], first);
+    ezq_copy_items(pp_items + first, p_slots, count - first);
+    ezq_buf_release_run(p_buf, count);
+} /* ezq_buf_pop_run */
+
+static void EZQ_API
+ezq_buf_release_run(struct ezq_buffer * const p_buf, const unsigned int count)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int front = 0;
+    unsigned int first = 0;
     unsigned int i = 0;
+
+    assert(NULL != p_buf);
+    assert(count <= p_buf->count);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+
+    /* Clear up to the end of the array, then wrap around to its start. */
+    front = EZQ_BUF_INDEX(p_buf, 0, slot_capacity);
+    first = EZQ_MIN(count, slot_capacity - front);
+    for (i = 0; i < first; ++i)
+    {
+        p_slots[front + i] = NULL;
+    }
+    for (i = 0; i < count - first; ++i)
+    {
+        p_slots[i] = NULL;
+    }
+
+    EZQ_BUF_ADVANCE(p_buf, count, slot_capacity);
+    p_buf->count -= count;
+} /* ezq_buf_release_run */
+
+static void EZQ_API
+ezq_buf_pop(struct ezq_buffer * const p_buf, void ** const pp_item)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int front = 0;
+
+    assert(NULL != p_buf);
+    assert(NULL != pp_item);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+    front = EZQ_BUF_INDEX(p_buf, 0, slot_capacity);
+    *pp_item = p_slots[front];
+    p_slots[front] = NULL;
+    EZQ_BUF_ADVANCE(p_buf, 1, slot_capacity);
+    --p_buf->count;
+} /* ezq_buf_pop */
+
+static void EZQ_API
+ezq_buf_push_front(struct ezq_buffer * const p_buf, void * const p_item)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+
+    assert(NULL != p_buf);
+    assert(NULL != p_item);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+    assert(p_buf->count < slot_capacity);
+
+    EZQ_BUF_RETREAT(p_buf, slot_capacity);
+    p_slots[EZQ_BUF_INDEX(p_buf, 0, slot_capacity)] = p_item;
+    ++p_buf->count;
+} /* ezq_buf_push_front */
+
+static void EZQ_API
+ezq_buf_pop_back(struct ezq_buffer * const p_buf, void ** const pp_item)
+{
+    void ** p_slots = NULL;
+    unsigned int slot_capacity = 0;
+    unsigned int back = 0;
+
+    assert(NULL != p_buf);
+    assert(NULL != pp_item);
+    assert(p_buf->count > 0);
+
+    p_slots = EZQ_BUF_SLOTS(p_buf);
+    slot_capacity = EZQ_BUF_CAPACITY(p_buf);
+    back = EZQ_BUF_INDEX(p_buf, p_buf->count - 1, slot_capacity);
+    *pp_item = p_slots[back];
+    p_slots[back] = NULL;
+    --p_buf->count;
+} /* ezq_buf_pop_back */
+
+static struct ezq_linkedlist_node * EZQ_API
+ezq_node_acquire(ezq_queue * const p_queue)
+{
+    struct ezq_linkedlist_node * p_newnode = NULL;
+
     assert(NULL != p_queue);
 
-    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    /* Prefer a previously retired node over asking the allocator. */
+    if (NULL != p_queue->node_cache.p_top)
     {
-        p_queue->fixed.p_items[i] = NULL;
+        p_newnode = p_queue->node_cache.p_top;
+        p_queue->node_cache.p_top = p_newnode->p_next;
+        --p_queue->node_cache.count;
+    }
+    else
+    {
+        assert(NULL != p_queue->alloc_fn);
+        p_newnode = p_queue->alloc_fn(sizeof(*p_newnode));
+        if (NULL == p_newnode)
+        {
+            goto done;
+        }
+        EZQ_STATS_INC(p_queue, overflow_allocs);
+    }
+    p_newnode->front_index = 0;
+    p_newnode->count = 0;
+    p_newnode->p_next = NULL;
+    p_newnode->p_prev = NULL;
+
+    done:
+        return p_newnode;
+} /* ezq_node_acquire */
+
+static void EZQ_API
+ezq_node_release(
+    ezq_queue * const p_queue,
+    struct ezq_linkedlist_node * const p_node
+)
+{
+    assert(NULL != p_queue);
+    assert(NULL != p_node);
+
+    p_node->front_index = 0;
+    p_node->count = 0;
+    p_node->p_next = NULL;
+    p_node->p_prev = NULL;
+
+    if (p_queue->node_cache.count < p_queue->node_cache.limit)
+    {
+        p_node->p_next = p_queue->node_cache.p_top;
+        p_queue->node_cache.p_top = p_node;
+        ++p_queue->node_cache.count;
+    }
+    else if (NULL != p_queue->free_fn)
+    {
+        p_queue->free_fn(p_node);
+    }
+} /* ezq_node_release */
+
+static void EZQ_API
+ezq_nodecache_trim(
+    struct ezq_nodecache * const p_cache,
+    const unsigned int keep,
+    void (*free_fn)(void * const ptr)
+)
+{
+    struct ezq_linkedlist_node * p_node = NULL;
+
+    assert(NULL != p_cache);
+
+    while (p_cache->count > keep)
+    {
+        assert(NULL != free_fn);
+
+        p_node = p_cache->p_top;
+        p_cache->p_top = p_node->p_next;
+        --p_cache->count;
+
+        p_node->p_next = NULL;
+        free_fn(p_node);
+    }
+} /* ezq_nodecache_trim */
+
+static void EZQ_API
+ezq_list_append_node(
+    struct ezq_linkedlist * const p_ll,
+    struct ezq_linkedlist_node * const p_node
+)
+{
+    assert(NULL != p_ll);
+    assert(NULL != p_node);
+    assert(0 == p_node->count);
+
+    if (NULL == p_ll->p_tail)
+    {
+        p_ll->p_head = p_node;
+    }
+    else
+    {
+        p_ll->p_tail->p_next = p_node;
+    }
+    p_node->p_prev = p_ll->p_tail;
+    p_ll->p_tail = p_node;
+} /* ezq_list_append_node */
+
+static void EZQ_API
+ezq_list_push(struct ezq_linkedlist * const p_ll, void * const p_item)
+{
+    struct ezq_linkedlist_node * p_rear = NULL;
+
+    assert(NULL != p_ll);
+    assert(NULL != p_item);
+    assert(!EZQ_LIST_TAIL_FULL(p_ll));
+
+    p_rear = p_ll->p_tail;
+    p_rear->p_items[p_rear->front_index + p_rear->count] = p_item;
+    ++p_rear->count;
+    ++p_ll->count;
+} /* ezq_list_push */
+
+static unsigned int EZQ_API
+ezq_list_push_run(
+    struct ezq_linkedlist * const p_ll,
+    void * const * const pp_items,
+    const unsigned int count
+)
+{
+    struct ezq_linkedlist_node * p_rear = NULL;
+    unsigned int run = 0;
+
+    assert(NULL != p_ll);
+    assert(NULL != pp_items);
+    assert(!EZQ_LIST_TAIL_FULL(p_ll));
+
+    p_rear = p_ll->p_tail;
+    run = EZQ_MIN(
+        count,
+        EZQ_LIST_NODE_CAPACITY - (p_rear->front_index + p_rear->count)
+    );
+    ezq_copy_items(
+        &p_rear->p_items[p_rear->front_index + p_rear->count],
+        pp_items,
+        run
+    );
+    p_rear->count += run;
+    p_ll->count += run;
+
+    return run;
+} /* ezq_list_push_run */
+
+static unsigned int EZQ_API
+ezq_list_pop_run(
+    struct ezq_linkedlist * const p_ll,
+    void ** const pp_items,
+    const unsigned int count,
+    struct ezq_linkedlist_node ** const pp_emptied
+)
+{
+    struct ezq_linkedlist_node * p_front = NULL;
+    unsigned int run = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_ll);
+    assert(NULL != p_ll->p_head);
+    assert(NULL != pp_items);
+    assert(NULL != pp_emptied);
+
+    p_front = p_ll->p_head;
+    run = EZQ_MIN(count, p_front->count);
+    ezq_copy_items(pp_items, &p_front->p_items[p_front->front_index], run);
+    for (i = 0; i < run; ++i)
+    {
+        p_front->p_items[p_front->front_index + i] = NULL;
+    }
+    p_front->front_index += run;
+    p_front->count -= run;
+    p_ll->count -= run;
+
+    /* Unlink the front node once its block has been exhausted. */
+    *pp_emptied = NULL;
+    if (0 == p_front->count)
+    {
+        p_ll->p_head = p_front->p_next;
+        if (NULL == p_ll->p_head)
+        {
+            p_ll->p_tail = NULL;
+        }
+        else
+        {
+            p_ll->p_head->p_prev = NULL;
+        }
+        p_front->p_next = NULL;
+        *pp_emptied = p_front;
     }
-    p_queue->fixed.front_index = 0;
-    p_queue->fixed.count = 0;
-
-    p_queue->dynamic.p_head = NULL;
-    p_queue->dynamic.p_tail = NULL;
-    p_queue->dynamic.count = 0;
 
-    p_queue->capacity = capacity;
-    p_queue->alloc_fn = alloc_fn;
-    p_queue->free_fn = free_fn;
-} /* ezq_init_unsafe */
+    return run;
+} /* ezq_list_pop_run */
 
-static unsigned int EZQ_API
-ezq_count_unsafe(const ezq_queue * const p_queue)
+static struct ezq_linkedlist_node * EZQ_API
+ezq_list_pop(struct ezq_linkedlist * const p_ll, void ** const pp_item)
 {
-    assert(NULL != p_queue);
+    struct ezq_linkedlist_node * p_front = NULL;
 
-    return p_queue->fixed.count + p_queue->dynamic.count;
-} /* ezq_count_unsafe */
+    assert(NULL != p_ll);
+    assert(NULL != pp_item);
 
-static void EZQ_API
-ezq_buf_push(struct ezq_buffer * const p_buf, void * const p_item)
-{
-    assert(NULL != p_buf);
-    assert(NULL != p_item);
+    p_front = p_ll->p_head;
+    *pp_item = p_front->p_items[p_front->front_index];
+    p_front->p_items[p_front->front_index] = NULL;
+    ++p_front->front_index;
+    --p_front->count;
+    --p_ll->count;
 
-    if (p_buf->count < EZQ_FIXED_BUFFER_CAPACITY)
+    /* Unlink the front node once its block has been exhausted. */
+    if (p_front->count > 0)
     {
-        p_buf->p_items[EZQ_BUF_BACK(p_buf, EZQ_FIXED_BUFFER_CAPACITY)] = p_item;
-        ++p_buf->count;
+        p_front = NULL;
+        goto done;
     }
-} /* ezq_buf_push */
+    p_ll->p_head = p_front->p_next;
+    if (NULL == p_ll->p_head)
+    {
+        p_ll->p_tail = NULL;
+    }
+    else
+    {
+        p_ll->p_head->p_prev = NULL;
+    }
+    p_front->p_next = NULL;
+
+done:
+    return p_front;
+} /* ezq_list_pop */
 
 static void EZQ_API
-ezq_buf_pop(struct ezq_buffer * const p_buf, void ** const pp_item)
+ezq_list_push_front(struct ezq_linkedlist * const p_ll, void * const p_item)
 {
-    assert(NULL != p_buf);
-    assert(NULL != pp_item);
+    struct ezq_linkedlist_node * p_front = NULL;
 
-    *pp_item = p_buf->p_items[p_buf->front_index];
-    p_buf->p_items[p_buf->front_index] = NULL;
-    p_buf->front_index = (p_buf->front_index + 1) % EZQ_FIXED_BUFFER_CAPACITY;
-    --p_buf->count;
-} /* ezq_buf_pop */
+    assert(NULL != p_ll);
+    assert(NULL != p_item);
+
+    if (0 == p_ll->count)
+    {
+        ezq_list_push(p_ll, p_item);
+        return;
+    }
+
+    p_front = p_ll->p_head;
+    assert(p_front->front_index > 0);
+    --p_front->front_index;
+    p_front->p_items[p_front->front_index] = p_item;
+    ++p_front->count;
+    ++p_ll->count;
+} /* ezq_list_push_front */
 
 static struct ezq_linkedlist_node * EZQ_API
-ezq_list_create_node(
-    void * (*alloc_fn)(const size_t size),
-    void * const p_item
-)
+ezq_list_pop_back(struct ezq_linkedlist * const p_ll, void ** const pp_item)
 {
-    struct ezq_linkedlist_node * p_newnode = NULL;
+    struct ezq_linkedlist_node * p_rear = NULL;
 
-    assert(NULL != alloc_fn);
-    assert(NULL != p_item);
+    assert(NULL != p_ll);
+    assert(NULL != pp_item);
+    assert(p_ll->count > 0);
 
-    p_newnode = alloc_fn(sizeof(*p_newnode));
-    if (NULL == p_newnode)
+    /* Skip an empty rear node appended for an uncommitted reservation. */
+    p_rear = p_ll->p_tail;
+    if (0 == p_rear->count)
+    {
+        p_rear = p_rear->p_prev;
+    }
+
+    --p_rear->count;
+    --p_ll->count;
+    *pp_item = p_rear->p_items[p_rear->front_index + p_rear->count];
+    p_rear->p_items[p_rear->front_index + p_rear->count] = NULL;
+
+    /* Unlink the node once its block has been exhausted. */
+    if (p_rear->count > 0)
     {
+        p_rear = NULL;
         goto done;
     }
-    p_newnode->p_next = NULL;
-    p_newnode->p_item = p_item;
+    if (NULL == p_rear->p_prev)
+    {
+        p_ll->p_head = p_rear->p_next;
+    }
+    else
+    {
+        p_rear->p_prev->p_next = p_rear->p_next;
+    }
+    if (NULL == p_rear->p_next)
+    {
+        p_ll->p_tail = p_rear->p_prev;
+    }
+    else
+    {
+        p_rear->p_next->p_prev = p_rear->p_prev;
+    }
+    p_rear->p_next = NULL;
+    p_rear->p_prev = NULL;
 
-    done:
-        return p_newnode;
-} /* ezq_list_create_node */
+done:
+    return p_rear;
+} /* ezq_list_pop_back */
 
 static void EZQ_API
-ezq_list_push(
-    struct ezq_linkedlist * const p_ll,
-    struct ezq_linkedlist_node * const p_node
+ezq_chain_push(
+    struct ezq_linkchain * const p_chain,
+    struct ezq_link * const p_link
 )
 {
-    assert(NULL != p_ll);
-    assert(NULL != p_node);
+    assert(NULL != p_chain);
+    assert(NULL != p_link);
 
-    if (NULL == p_ll->p_tail)
+    p_link->p_next = NULL;
+    if (NULL == p_chain->p_tail)
     {
-        p_ll->p_head = p_node;
+        p_chain->p_head = p_link;
     }
     else
     {
-        p_ll->p_tail->p_next = p_node;
+        p_chain->p_tail->p_next = p_link;
     }
-    p_ll->p_tail = p_node;
-    ++p_ll->count;
-} /* ezq_list_push */
+    p_chain->p_tail = p_link;
+    ++p_chain->count;
+} /* ezq_chain_push */
 
-static void EZQ_API
-ezq_list_pop(
-    struct ezq_linkedlist * const p_ll,
-    void (*free_fn)(void * const ptr),
-    void ** const pp_item
-)
+static struct ezq_link * EZQ_API
+ezq_chain_pop(struct ezq_linkchain * const p_chain)
 {
-    struct ezq_linkedlist_node * p_front = NULL;
+    struct ezq_link * p_front = NULL;
 
-    assert(NULL != p_ll);
-    assert(NULL != pp_item);
+    assert(NULL != p_chain);
+    assert(NULL != p_chain->p_head);
 
-    p_front = p_ll->p_head;
-    p_ll->p_head = p_ll->p_head->p_next;
-    --p_ll->count;
-    if (0 == p_ll->count)
+    p_front = p_chain->p_head;
+    p_chain->p_head = p_front->p_next;
+    if (NULL == p_chain->p_head)
     {
-        p_ll->p_tail = NULL;
+        p_chain->p_tail = NULL;
     }
-
-    *pp_item = p_front->p_item;
-    p_front->p_item = NULL;
     p_front->p_next = NULL;
+    --p_chain->count;
 
-    if (NULL != free_fn)
-    {
-        free_fn(p_front);
-    }
-    p_front = NULL;
-} /* ezq_list_pop */
+    return p_front;
+} /* ezq_chain_pop */
 
 static void EZQ_API
 ezq_destroy_unsafe(
@@ -469,6 +3064,7 @@ ezq_destroy_unsafe(
     void * const p_args
 )
 {
+    struct ezq_linkedlist_node * p_node = NULL;
     void *p_item = NULL;
 
     assert(NULL != p_queue);
@@ -483,18 +3079,423 @@ ezq_destroy_unsafe(
         }
     }
 
-    /* Now clean up the linked list. */
+    /* Now clean up the linked list. Caching is disabled first so that its
+     * nodes are released rather than retained.
+     * */
+    p_queue->node_cache.limit = 0;
     while (p_queue->dynamic.count > 0)
     {
-        ezq_list_pop(&p_queue->dynamic, p_queue->free_fn, &p_item);
+        p_node = ezq_list_pop(&p_queue->dynamic, &p_item);
+        if (NULL != p_node)
+        {
+            ezq_node_release(p_queue, p_node);
+        }
+        if (NULL != item_cleanup_fn)
+        {
+            item_cleanup_fn(p_item, p_args);
+        }
+    }
+
+    /* Release the empty rear node an abandoned reservation may have left. */
+    if (NULL != p_queue->dynamic.p_head)
+    {
+        p_node = p_queue->dynamic.p_head;
+        p_queue->dynamic.p_head = NULL;
+        p_queue->dynamic.p_tail = NULL;
+        ezq_node_release(p_queue, p_node);
+    }
+
+    /* Unchain any caller-embedded links; they belong to the caller. */
+    while (p_queue->links.count > 0)
+    {
+        p_item = ezq_chain_pop(&p_queue->links);
         if (NULL != item_cleanup_fn)
         {
             item_cleanup_fn(p_item, p_args);
         }
     }
 
+    /* Release any nodes that were being kept for reuse. */
+    ezq_nodecache_trim(&p_queue->node_cache, 0, p_queue->free_fn);
+
+    /* Release a grown buffer, returning to the fixed-size buffer. A
+     * caller-provided buffer is left to the caller.
+     * */
+    if (NULL != p_queue->fixed.p_slots)
+    {
+        if (!(p_queue->flags & EZQ_FLAG_CALLER_SLOTS))
+        {
+            p_queue->free_fn(p_queue->fixed.p_slots);
+        }
+        p_queue->fixed.p_slots = NULL;
+        p_queue->fixed.slot_capacity = 0;
+    }
+    p_queue->fixed.front_index = 0;
+
     /* Clear the other fields of the queue. */
     p_queue->alloc_fn = NULL;
     p_queue->free_fn = NULL;
     p_queue->capacity = 0;
+    p_queue->flags = 0;
+    p_queue->reserved = 0;
+    EZQ_STATS_RESET(p_queue);
+    EZQ_SOJOURN_RESET(p_queue);
 } /* ezq_destroy_unsafe */
+
+#ifdef EZQ_ENABLE_STATS
+static void EZQ_API
+ezq_stats_record_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int pushed,
+    const unsigned int popped
+)
+{
+    unsigned int fixed_capacity = 0;
+    unsigned int depth = 0;
+
+    assert(NULL != p_queue);
+
+    fixed_capacity = (p_queue->flags & EZQ_FLAG_CALLER_SLOTS)
+        ? p_queue->fixed.slot_capacity : EZQ_FIXED_BUFFER_CAPACITY;
+    depth = ezq_count_unsafe(p_queue) + p_queue->links.count;
+
+    p_queue->stats.pushes += pushed;
+    p_queue->stats.pops += popped;
+    if (depth > p_queue->stats.high_water)
+    {
+        p_queue->stats.high_water = depth;
+    }
+
+    /* The previous depth tells whether a spell above the fixed capacity
+     * has just started or ended.
+     * */
+    if (depth > fixed_capacity && p_queue->stats.depth <= fixed_capacity)
+    {
+        ++p_queue->stats.spills;
+        if (NULL != p_queue->clock_fn)
+        {
+            p_queue->spill_start = p_queue->clock_fn();
+        }
+    }
+    else if (
+        depth <= fixed_capacity
+        && p_queue->stats.depth > fixed_capacity
+        && NULL != p_queue->clock_fn
+    )
+    {
+        p_queue->stats.spill_ticks +=
+            p_queue->clock_fn() - p_queue->spill_start;
+    }
+    p_queue->stats.depth = depth;
+} /* ezq_stats_record_unsafe */
+
+static void EZQ_API
+ezq_stats_reset_unsafe(ezq_queue * const p_queue)
+{
+    assert(NULL != p_queue);
+
+    p_queue->stats.pushes = 0;
+    p_queue->stats.pops = 0;
+    p_queue->stats.full_rejections = 0;
+    p_queue->stats.overflow_allocs = 0;
+    p_queue->stats.alloc_failures = 0;
+    p_queue->stats.spills = 0;
+    p_queue->stats.spill_ticks = 0;
+    p_queue->stats.depth = 0;
+    p_queue->stats.high_water = 0;
+    p_queue->clock_fn = NULL;
+    p_queue->spill_start = 0;
+} /* ezq_stats_reset_unsafe */
+
+static void EZQ_API
+ezq_stats_put(
+    char * const p_buf,
+    const size_t size,
+    size_t * const p_len,
+    const char * p_text,
+    const int escape
+)
+{
+    char c = '\0';
+
+    assert(NULL != p_len);
+    assert(NULL != p_text);
+
+    for (; '\0' != *p_text; ++p_text)
+    {
+        c = *p_text;
+
+        /* Label values escape backslashes, quotes and line feeds. */
+        if (escape && ('\\' == c || '"' == c || '\n' == c))
+        {
+            if (*p_len + 1 < size)
+            {
+                p_buf[*p_len] = '\\';
+            }
+            ++*p_len;
+            c = '\n' == c ? 'n' : c;
+        }
+        if (*p_len + 1 < size)
+        {
+            p_buf[*p_len] = c;
+        }
+        ++*p_len;
+    }
+} /* ezq_stats_put */
+
+static void EZQ_API
+ezq_stats_put_metric(
+    char * const p_buf,
+    const size_t size,
+    size_t * const p_len,
+    const char * const * const pp_metric,
+    const char * const p_name,
+    unsigned long value
+)
+{
+    char digits[3 * sizeof(value) + 2];
+    unsigned int i = sizeof(digits) - 1;
+
+    assert(NULL != pp_metric);
+
+    /* Render the value from its last digit backwards. */
+    digits[i] = '\0';
+    do
+    {
+        digits[--i] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    ezq_stats_put(p_buf, size, p_len, "# HELP ", 0);
+    ezq_stats_put(p_buf, size, p_len, pp_metric[0], 0);
+    ezq_stats_put(p_buf, size, p_len, " ", 0);
+    ezq_stats_put(p_buf, size, p_len, pp_metric[2], 0);
+    ezq_stats_put(p_buf, size, p_len, "\n# TYPE ", 0);
+    ezq_stats_put(p_buf, size, p_len, pp_metric[0], 0);
+    ezq_stats_put(p_buf, size, p_len, " ", 0);
+    ezq_stats_put(p_buf, size, p_len, pp_metric[1], 0);
+    ezq_stats_put(p_buf, size, p_len, "\n", 0);
+    ezq_stats_put(p_buf, size, p_len, pp_metric[0], 0);
+    if (NULL != p_name)
+    {
+        ezq_stats_put(p_buf, size, p_len, "{queue=\"", 0);
+        ezq_stats_put(p_buf, size, p_len, p_name, 1);
+        ezq_stats_put(p_buf, size, p_len, "\"}", 0);
+    }
+    ezq_stats_put(p_buf, size, p_len, " ", 0);
+    ezq_stats_put(p_buf, size, p_len, &digits[i], 0);
+    ezq_stats_put(p_buf, size, p_len, "\n", 0);
+} /* ezq_stats_put_metric */
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+static void EZQ_API
+ezq_sojourn_record_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int pushed,
+    const unsigned int popped
+)
+{
+    struct ezq_sojourn *p_sojourn = NULL;
+    struct ezq_sojourn_stamp *p_stamp = NULL;
+    unsigned long now = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+    p_sojourn = &p_queue->sojourn;
+
+    /* Items leave in the order they arrived, so the stamps of the popped
+     * items, if any were stamped, are at the front of the ring.
+     * */
+    for (i = 0; p_sojourn->stamp_count > 0; ++i)
+    {
+        p_stamp = &p_sojourn->stamps[p_sojourn->stamp_front];
+        if (p_stamp->seq - p_sojourn->pop_seq >= popped)
+        {
+            break;
+        }
+        if (0 == i)
+        {
+            assert(NULL != p_sojourn->clock_fn);
+            now = p_sojourn->clock_fn();
+        }
+
+        ezq_sojourn_sample_unsafe(p_sojourn, now - p_stamp->ticks);
+
+        p_sojourn->stamp_front =
+            (p_sojourn->stamp_front + 1) & (EZQ_SOJOURN_STAMPS - 1);
+        --p_sojourn->stamp_count;
+    }
+    p_sojourn->pop_seq += popped;
+
+    /* Stamp as many of the pushed items as the ring has room for. */
+    for (
+        i = 0;
+        i < pushed
+            && NULL != p_sojourn->clock_fn
+            && p_sojourn->stamp_count < EZQ_SOJOURN_STAMPS;
+        ++i
+    )
+    {
+        if (0 == i)
+        {
+            now = p_sojourn->clock_fn();
+        }
+        p_stamp = &p_sojourn->stamps[
+            (p_sojourn->stamp_front + p_sojourn->stamp_count)
+                & (EZQ_SOJOURN_STAMPS - 1)
+        ];
+        p_stamp->seq = p_sojourn->push_seq + i;
+        p_stamp->ticks = now;
+        ++p_sojourn->stamp_count;
+    }
+    p_sojourn->push_seq += pushed;
+} /* ezq_sojourn_record_unsafe */
+
+static void EZQ_API
+ezq_sojourn_record_reverse_unsafe(
+    ezq_queue * const p_queue,
+    const unsigned int pushed,
+    const unsigned int popped
+)
+{
+    struct ezq_sojourn *p_sojourn = NULL;
+    struct ezq_sojourn_stamp *p_stamp = NULL;
+    unsigned long now = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+    p_sojourn = &p_queue->sojourn;
+    if (NULL != p_sojourn->clock_fn && (pushed > 0 || popped > 0))
+    {
+        now = p_sojourn->clock_fn();
+    }
+
+    /* An item taken from the back was the last pushed, so it gives back its
+     * position, and its stamp, if it was stamped, is at the back of the
+     * ring.
+     * */
+    for (i = 0; i < popped; ++i)
+    {
+        --p_sojourn->push_seq;
+        if (0 == p_sojourn->stamp_count)
+        {
+            continue;
+        }
+        p_stamp = &p_sojourn->stamps[
+            (p_sojourn->stamp_front + p_sojourn->stamp_count - 1)
+                & (EZQ_SOJOURN_STAMPS - 1)
+        ];
+        if (p_stamp->seq == p_sojourn->push_seq)
+        {
+            assert(NULL != p_sojourn->clock_fn);
+            ezq_sojourn_sample_unsafe(p_sojourn, now - p_stamp->ticks);
+            --p_sojourn->stamp_count;
+        }
+    }
+
+    /* An item placed at the front takes the position before the front
+     * item, and its stamp goes before the others in the ring.
+     * */
+    for (i = 0; i < pushed; ++i)
+    {
+        --p_sojourn->pop_seq;
+        if (
+            NULL == p_sojourn->clock_fn
+            || p_sojourn->stamp_count >= EZQ_SOJOURN_STAMPS
+        )
+        {
+            continue;
+        }
+        p_sojourn->stamp_front =
+            (p_sojourn->stamp_front - 1) & (EZQ_SOJOURN_STAMPS - 1);
+        p_stamp = &p_sojourn->stamps[p_sojourn->stamp_front];
+        p_stamp->seq = p_sojourn->pop_seq;
+        p_stamp->ticks = now;
+        ++p_sojourn->stamp_count;
+    }
+} /* ezq_sojourn_record_reverse_unsafe */
+
+static void EZQ_API
+ezq_sojourn_sample_unsafe(
+    struct ezq_sojourn * const p_sojourn,
+    const unsigned long ticks
+)
+{
+    assert(NULL != p_sojourn);
+
+    ++p_sojourn->buckets[ezq_sojourn_bucket(ticks)];
+    ++p_sojourn->samples;
+    if (ticks > p_sojourn->max)
+    {
+        p_sojourn->max = ticks;
+    }
+} /* ezq_sojourn_sample_unsafe */
+
+static void EZQ_API
+ezq_sojourn_reset_unsafe(ezq_queue * const p_queue)
+{
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+
+    for (i = 0; i < EZQ_SOJOURN_BUCKETS; ++i)
+    {
+        p_queue->sojourn.buckets[i] = 0;
+    }
+    p_queue->sojourn.stamp_front = 0;
+    p_queue->sojourn.stamp_count = 0;
+    p_queue->sojourn.push_seq = 0;
+    p_queue->sojourn.pop_seq = 0;
+    p_queue->sojourn.samples = 0;
+    p_queue->sojourn.max = 0;
+    p_queue->sojourn.clock_fn = NULL;
+} /* ezq_sojourn_reset_unsafe */
+
+static unsigned int EZQ_API
+ezq_sojourn_bucket(unsigned long ticks)
+{
+    unsigned int shift = 0;
+
+    /* Times too long for the histogram share its last bucket. */
+    if (0 != (ticks >> 16) >> 16)
+    {
+        ticks = 0xFFFFFFFFUL;
+    }
+
+    /* Keep the leading EZQ_SOJOURN_SUB_BITS + 1 bits of the time, dropping
+     * whole bytes first to keep long times cheap.
+     * */
+    while (ticks >= (unsigned long)EZQ_SOJOURN_SUB_BUCKETS << 9)
+    {
+        ticks >>= 8;
+        shift += 8;
+    }
+    while (ticks >= (unsigned long)EZQ_SOJOURN_SUB_BUCKETS << 1)
+    {
+        ticks >>= 1;
+        ++shift;
+    }
+
+    return shift * EZQ_SOJOURN_SUB_BUCKETS + (unsigned int)ticks;
+} /* ezq_sojourn_bucket */
+
+static unsigned long EZQ_API
+ezq_sojourn_bucket_high(const unsigned int bucket)
+{
+    unsigned long low = bucket;
+    unsigned int shift = 0;
+
+    assert(bucket < EZQ_SOJOURN_BUCKETS);
+
+    if (bucket >= 2 * EZQ_SOJOURN_SUB_BUCKETS)
+    {
+        shift = bucket / EZQ_SOJOURN_SUB_BUCKETS - 1;
+        low = (unsigned long)(
+            EZQ_SOJOURN_SUB_BUCKETS + bucket % EZQ_SOJOURN_SUB_BUCKETS
+        ) << shift;
+    }
+
+    return low + ((1UL << shift) - 1);
+} /* ezq_sojourn_bucket_high */
+#endif /* EZQ_ENABLE_SOJOURN */
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include <unity/unity.h>
 #include "easyqueue.h"
 
@@ -10,6 +11,16 @@ struct alloc_stack
     int top_index;
 } g_alloc_stack;
 
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned long g_ticks; /* reading of custom_clock_fn */
+
+/* Caller-owned item embedding a link for use with ezq_ipush. */
+struct test_message
+{
+    unsigned int id;
+    struct ezq_link link;
+};
+
 /*!
  * @brief Sets the global dummy allocation stack to default values.
  *
@@ -25,6 +36,7 @@ void setUp(void)
         g_alloc_stack.return_stack[i] = NULL;
     }
     g_alloc_stack.top_index = -1;
+    g_free_count = 0;
 }
 
 void tearDown(void) { } /* UNUSED; required definition for Unity tests */
@@ -77,7 +89,8 @@ custom_alloc_fn_push(void * const ptr)
 } /* custom_alloc_fn_push */
 
 /*!
- * @brief Does nothing.
+ * @brief Counts the number of times it is invoked but otherwise does
+ * nothing.
  *
  * @note This function mirrors the signature of the standard library's
  * \c free() function.
@@ -88,6 +101,7 @@ static void
 custom_free_fn(void * const ptr)
 {
     (void)ptr;
+    ++g_free_count;
 } /* custom_free_fn */
 
 /*!
@@ -133,6 +147,13 @@ test__ezq_init__standard__success(void)
     TEST_ASSERT_NULL(queue.dynamic.p_tail);
     TEST_ASSERT_EQUAL(0, queue.dynamic.count);
 
+    TEST_ASSERT_NULL(queue.node_cache.p_top);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.node_cache.count);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_DEFAULT_NODE_CACHE_LIMIT,
+        queue.node_cache.limit
+    );
+
     TEST_ASSERT_EQUAL(TEST_CAPACITY, queue.capacity);
     TEST_ASSERT_EQUAL_PTR(queue.alloc_fn, custom_alloc_fn);
     TEST_ASSERT_EQUAL_PTR(queue.free_fn, custom_free_fn);
@@ -152,6 +173,158 @@ test__ezq_init__null_queue__failure(void)
     TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
 } /* test__ezq_init__null_queue__failure */
 
+/*!
+ * @brief Test that \c ezq_init_growable succeeds when provided standard
+ * valid arguments.
+ */
+static void
+test__ezq_init_growable__standard__success(void)
+{
+    const unsigned int TEST_CAPACITY = 100;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_queue queue = { 0 };
+    unsigned int i = 0;
+
+    for (i = 0; i < sizeof(queue); ++i)
+    {
+        ((unsigned char *)&queue)[i] = 0xFF;
+    }
+
+    estat = ezq_init_growable(
+        &queue,
+        TEST_CAPACITY,
+        1,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.front_index);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_FLAG_GROWABLE | EZQ_FLAG_SHRINK,
+        queue.flags
+    );
+    TEST_ASSERT_EQUAL(TEST_CAPACITY, queue.capacity);
+    TEST_ASSERT_EQUAL_PTR(queue.alloc_fn, custom_alloc_fn);
+    TEST_ASSERT_EQUAL_PTR(queue.free_fn, custom_free_fn);
+} /* test__ezq_init_growable__standard__success */
+
+/*!
+ * @brief Test that \c ezq_init_growable properly fails when passed a
+ * \c NULL \c ezq_queue* .
+ */
+static void
+test__ezq_init_growable__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    estat = ezq_init_growable(NULL, 0, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_init_growable__null_queue__failure */
+
+/*!
+ * @brief Tests that \c ezq_init_buffer properly initializes an
+ * \c ezq_queue to keep its items in caller-provided storage.
+ */
+static void
+test__ezq_init_buffer__standard__success(void)
+{
+    const unsigned int TEST_CAPACITY = 100;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_queue queue = { 0 };
+    void *slots[4];
+    unsigned int i = 0;
+
+    for (i = 0; i < sizeof(queue); ++i)
+    {
+        ((unsigned char *)&queue)[i] = 0xFF;
+    }
+    for (i = 0; i < 4; ++i)
+    {
+        slots[i] = (void *)0xAA;
+    }
+
+    estat = ezq_init_buffer(
+        &queue,
+        TEST_CAPACITY,
+        slots,
+        4,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(slots, queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(4, queue.fixed.slot_capacity);
+    for (i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_NULL(slots[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.front_index);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FLAG_CALLER_SLOTS, queue.flags);
+    TEST_ASSERT_EQUAL(TEST_CAPACITY, queue.capacity);
+    TEST_ASSERT_EQUAL_PTR(queue.alloc_fn, custom_alloc_fn);
+    TEST_ASSERT_EQUAL_PTR(queue.free_fn, custom_free_fn);
+} /* test__ezq_init_buffer__standard__success */
+
+/*!
+ * @brief Test that \c ezq_init_buffer properly fails when passed a
+ * \c NULL \c ezq_queue* .
+ */
+static void
+test__ezq_init_buffer__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[4];
+
+    estat = ezq_init_buffer(
+        NULL,
+        0,
+        slots,
+        4,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_init_buffer__null_queue__failure */
+
+/*!
+ * @brief Test that \c ezq_init_buffer properly fails when given storage for
+ * no items.
+ */
+static void
+test__ezq_init_buffer__zero_slots__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_queue queue = { 0 };
+    void *slots[1] = { (void *)0xAA };
+
+    estat = ezq_init_buffer(&queue, 0, slots, 0, custom_alloc_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_PTR(0xAA, slots[0]);
+} /* test__ezq_init_buffer__zero_slots__failure */
+
+/*!
+ * @brief Test that \c ezq_init_buffer properly fails when given storage for
+ * a number of items that is not a power of two, whatever the fixed size
+ * buffer's capacity.
+ */
+static void
+test__ezq_init_buffer__non_pow2_slots__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_queue queue = { 0 };
+    void *slots[3] = { (void *)0xAA, (void *)0xAA, (void *)0xAA };
+
+    estat = ezq_init_buffer(&queue, 0, slots, 3, custom_alloc_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_PTR(0xAA, slots[0]);
+} /* test__ezq_init_buffer__non_pow2_slots__failure */
+
 /*!
  * @brief Tests that \c ezq_push properly pushes to the underlying
  * fixed-size buffer when given standard valid arguments.
@@ -184,6 +357,38 @@ test__ezq_push__buf__success(void)
     TEST_ASSERT_NULL(queue.dynamic.p_tail);
 } /* test__ezq_push__buf__success */
 
+/*!
+ * @brief Tests that \c ezq_push wraps around to the start of the underlying
+ * fixed-size buffer when the back of the buffer has been reached.
+ */
+static void
+test__ezq_push__buf_wrapped__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    queue.fixed.front_index = EZQ_FIXED_BUFFER_CAPACITY - 1;
+    queue.fixed.count = 1;
+    queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1] = (void *)0xFE;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push(&queue, p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(p_item, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_FIXED_BUFFER_CAPACITY - 1,
+        queue.fixed.front_index
+    );
+} /* test__ezq_push__buf_wrapped__success */
+
 /*!
  * @brief Tests that \c ezq_push properly pushes to the underlying linked
  * list when the fixed size buffer is full.
@@ -194,7 +399,7 @@ test__ezq_push__list__success(void)
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
     int *p_item = (int *)0xFF;
-    struct ezq_linkedlist_node node = { NULL, NULL };
+    struct ezq_linkedlist_node node = { 0 };
 
     /* Set any initial state. */
     custom_alloc_fn_push(&node);
@@ -206,10 +411,191 @@ test__ezq_push__list__success(void)
     TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
     TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
     TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
-    TEST_ASSERT_EQUAL_PTR(p_item, node.p_item);
+    TEST_ASSERT_EQUAL_PTR(p_item, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, node.front_index);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
     TEST_ASSERT_NULL(node.p_next);
 } /* test__ezq_push__list__success */
 
+/*!
+ * @brief Tests that \c ezq_push stores an item in the rear node of the
+ * underlying linked list without obtaining a new node when that node still
+ * has room.
+ */
+static void
+test__ezq_push__list_partial_node__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. No address is pushed onto the dummy
+     * allocation stack, so any allocation attempt would fail.
+     * */
+    node.p_items[0] = (void *)0xFE;
+    node.count = 1;
+    queue.alloc_fn = custom_alloc_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.dynamic.count = 1;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push(&queue, p_item);
+    if (EZQ_LIST_NODE_CAPACITY < 2)
+    {
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+        return;
+    }
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_PTR(0xFE, node.p_items[0]);
+    TEST_ASSERT_EQUAL_PTR(p_item, node.p_items[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, node.count);
+} /* test__ezq_push__list_partial_node__success */
+
+/*!
+ * @brief Tests that \c ezq_push reuses a cached node rather than
+ * dynamically allocating one when pushing to the underlying linked list.
+ */
+static void
+test__ezq_push__list_cached_node__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. No address is pushed onto the dummy
+     * allocation stack, so any allocation attempt would fail.
+     * */
+    queue.alloc_fn = custom_alloc_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.node_cache.p_top = &node;
+    queue.node_cache.count = 1;
+    queue.node_cache.limit = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push(&queue, p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_PTR(p_item, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, node.front_index);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
+    TEST_ASSERT_NULL(node.p_next);
+    TEST_ASSERT_NULL(queue.node_cache.p_top);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.node_cache.count);
+} /* test__ezq_push__list_cached_node__success */
+
+/*!
+ * @brief Tests that \c ezq_push moves the items of a full growable queue
+ * into a buffer of twice the size rather than using the linked list.
+ */
+static void
+test__ezq_push__growable_full__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[EZQ_FIXED_BUFFER_CAPACITY * 2] = { 0 };
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init_growable(&queue, 0, 0, custom_alloc_fn, custom_free_fn);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        ezq_push(&queue, (unsigned char *)0xFF + i);
+    }
+    custom_alloc_fn_push(slots);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push(&queue, (unsigned char *)0xFF + i);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(slots, queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_FIXED_BUFFER_CAPACITY * 2,
+        queue.fixed.slot_capacity
+    );
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.front_index);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY + 1, queue.fixed.count);
+    for (i = 0; i <= EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR((unsigned char *)0xFF + i, slots[i]);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_push__growable_full__success */
+
+/*!
+ * @brief Tests that \c ezq_push fails when a full growable queue needs to
+ * grow its buffer but has no dynamic memory allocation function registered.
+ */
+static void
+test__ezq_push__growable_no_alloc_fn__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+
+    /* Set any initial state. */
+    queue.flags = EZQ_FLAG_GROWABLE;
+    queue.alloc_fn = NULL;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push(&queue, p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_ALLOC_FN, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+} /* test__ezq_push__growable_no_alloc_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_push fills caller-provided storage before
+ * placing items in the linked list.
+ */
+static void
+test__ezq_push__caller_buf__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[2] = { NULL };
+    struct ezq_linkedlist_node node = { 0 };
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_init_buffer(&queue, 0, slots, 2, custom_alloc_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    custom_alloc_fn_push(&node);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < 3; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF - i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_PTR(0xFF, slots[0]);
+    TEST_ASSERT_EQUAL_PTR(0xFE, slots[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(0xFD, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        TEST_ASSERT_NULL(queue.fixed.p_items[i]);
+    }
+} /* test__ezq_push__caller_buf__success */
+
 /*!
  * @brief Tests that \c ezq_push fails when the passed \c ezq_queue pointer
  * is \c NULL .
@@ -372,227 +758,1923 @@ test__ezq_push__alloc_fail__failure(void)
 } /* test__ezq_push__alloc_fail__failure */
 
 /*!
- * @brief Tests that \c ezq_pop success when the underlying fixed-size
- * buffer contains items but the underlying linked list does not.
+ * @brief Tests that \c ezq_push_n places a batch of items in the underlying
+ * fixed-size buffer, wrapping around to its start when the back of the
+ * buffer has been reached.
  */
 static void
-test__ezq_pop__empty_list__success(void)
+test__ezq_push_n__buf_wrapped__success(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    int *p_item = NULL;
+    void *items[2] = { (void *)0xFE, (void *)0xFD };
+    unsigned int pushed = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 3)
+    {
+        return;
+    }
 
     /* Set any initial state. */
-    queue.fixed.count = 1;
-    queue.fixed.p_items[0] = (void *)0xFF;
-    queue.dynamic.count = 0;
-    queue.dynamic.p_head = NULL;
-    queue.dynamic.p_tail = NULL;
+    queue.fixed.front_index = EZQ_FIXED_BUFFER_CAPACITY - 1;
+    queue.fixed.count = 0;
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(&queue, (void **)&p_item);
+    pushed = ezq_push_n(&queue, items, 2, &estat);
     TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
-    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
-    TEST_ASSERT_NULL(queue.fixed.p_items[0]);
-    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
-
-    /* Validate that nothing else was unexpectedly modified. */
-    TEST_ASSERT_EQUAL(0, queue.dynamic.count);
-    TEST_ASSERT_NULL(queue.dynamic.p_head);
-    TEST_ASSERT_NULL(queue.dynamic.p_tail);
-} /* test__ezq_pop__empty_list__success */
+    TEST_ASSERT_EQUAL_UINT32(2, pushed);
+    TEST_ASSERT_EQUAL_PTR(
+        0xFE,
+        queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1]
+    );
+    TEST_ASSERT_EQUAL_PTR(0xFD, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+} /* test__ezq_push_n__buf_wrapped__success */
 
 /*!
- * @brief Tests that \c ezq_pop success when the underlying fixed-size
- * buffer contains items and the underlying linked list also contains
- * items.
+ * @brief Tests that \c ezq_push_n fills the underlying fixed-size buffer
+ * and places the remainder of a batch in the underlying linked list.
  */
 static void
-test__ezq_pop__non_empty_list__success(void)
+test__ezq_push_n__list__success(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    int *p_item = NULL;
+    void *items[2] = { (void *)0xFE, (void *)0xFD };
+    unsigned int pushed = 0;
     struct ezq_linkedlist_node node = { 0 };
 
     /* Set any initial state. */
-    node.p_item = (void *)0xFE;
-    node.p_next = NULL;
-    queue.free_fn = custom_free_fn;
-    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
-    queue.fixed.p_items[0] = (void *)0xFF;
-    queue.dynamic.count = 1;
-    queue.dynamic.p_head = &node;
+    custom_alloc_fn_push(&node);
+    queue.alloc_fn = custom_alloc_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY - 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_push_n(&queue, items, 2, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, pushed);
+    TEST_ASSERT_EQUAL_PTR(
+        0xFE,
+        queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1]
+    );
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_PTR(0xFD, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
+} /* test__ezq_push_n__list__success */
+
+/*!
+ * @brief Tests that \c ezq_push_n places only as many items as the queue's
+ * capacity allows and reports that the queue is full.
+ */
+static void
+test__ezq_push_n__capacity_full__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[2] = { (void *)0xFE, (void *)0xFD };
+    unsigned int pushed = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    queue.capacity = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_push_n(&queue, items, 2, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, pushed);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_NULL(queue.fixed.p_items[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+} /* test__ezq_push_n__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_push_n stops placing items at the first
+ * \c NULL item of a batch.
+ */
+static void
+test__ezq_push_n__null_item__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[3] = { (void *)0xFE, NULL, (void *)0xFD };
+    unsigned int pushed = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 3)
+    {
+        return;
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_push_n(&queue, items, 3, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, pushed);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_NULL(queue.fixed.p_items[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+} /* test__ezq_push_n__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop success when the underlying fixed-size
+ * buffer contains items but the underlying linked list does not.
+ */
+static void
+test__ezq_pop__empty_list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = NULL;
+
+    /* Set any initial state. */
+    queue.fixed.count = 1;
+    queue.fixed.p_items[0] = (void *)0xFF;
+    queue.dynamic.count = 0;
+    queue.dynamic.p_head = NULL;
+    queue.dynamic.p_tail = NULL;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    TEST_ASSERT_NULL(queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_NULL(queue.dynamic.p_tail);
+} /* test__ezq_pop__empty_list__success */
+
+/*!
+ * @brief Tests that \c ezq_pop success when the underlying fixed-size
+ * buffer contains items and the underlying linked list also contains
+ * items.
+ */
+static void
+test__ezq_pop__non_empty_list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = NULL;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    node.p_items[0] = (void *)0xFE;
+    node.count = 1;
+    node.p_next = NULL;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.fixed.p_items[0] = (void *)0xFF;
+    queue.dynamic.count = 1;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_NULL(node.p_items[0]);
+    TEST_ASSERT_NULL(node.p_next);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_NULL(queue.dynamic.p_tail);
+} /* test__ezq_pop__non_empty_list__success */
+
+/*!
+ * @brief Tests that \c ezq_pop leaves the front node of the underlying
+ * linked list in place while it still holds items.
+ */
+static void
+test__ezq_pop__list_partial_node__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = NULL;
+    struct ezq_linkedlist_node node = { 0 };
+
+    if (EZQ_LIST_NODE_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    node.p_items[0] = (void *)0xFE;
+    node.p_items[1] = (void *)0xFD;
+    node.count = 2;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.fixed.p_items[0] = (void *)0xFF;
+    queue.dynamic.count = 2;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_NULL(node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, node.front_index);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_pop__list_partial_node__success */
+
+/*!
+ * @brief Tests that \c ezq_pop retains the node emptied by moving an item
+ * from the underlying linked list when the node cache has room for it.
+ */
+static void
+test__ezq_pop__non_empty_list_cache__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = NULL;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    node.p_items[0] = (void *)0xFE;
+    node.count = 1;
+    node.p_next = NULL;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.fixed.p_items[0] = (void *)0xFF;
+    queue.dynamic.count = 1;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+    queue.node_cache.limit = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL(0, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.node_cache.p_top);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.node_cache.count);
+    TEST_ASSERT_NULL(node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_pop__non_empty_list_cache__success */
+
+/*!
+ * @brief Tests that \c ezq_pop returns the items of a grown, shrinkable
+ * queue to the fixed-size buffer once they fit in it again.
+ */
+static void
+test__ezq_pop__growable_shrink__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[EZQ_FIXED_BUFFER_CAPACITY * 2] = { 0 };
+    int *p_item = NULL;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    slots[EZQ_FIXED_BUFFER_CAPACITY * 2 - 1] = (void *)0xFF;
+    slots[0] = (void *)0xFE;
+    queue.flags = EZQ_FLAG_GROWABLE | EZQ_FLAG_SHRINK;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.p_slots = slots;
+    queue.fixed.slot_capacity = EZQ_FIXED_BUFFER_CAPACITY * 2;
+    queue.fixed.front_index = EZQ_FIXED_BUFFER_CAPACITY * 2 - 1;
+    queue.fixed.count = 2;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.front_index);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+} /* test__ezq_pop__growable_shrink__success */
+
+/*!
+ * @brief Tests that \c ezq_pop fails when passed an \c ezq_queue pointer
+ * that is \c NULL .
+ */
+static void
+test__ezq_pop__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(NULL, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_pop__null_queue__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop fails when passed an out variable
+ * pointer that is \c NULL .
+ */
+static void
+test__ezq_pop__null_out__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    queue.fixed.count = 1;
+    queue.fixed.p_items[0] = (void *)0xFF;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_OUT, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(0xFF, queue.fixed.p_items[0]);
+} /* test__ezq_pop__null_out__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop fails when there are no items in the queue.
+ */
+static void
+test__ezq_pop__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+
+    /* Set any initial state. */
+    queue.fixed.count = 0;
+    queue.dynamic.count = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_pop__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop fails when the underlying linked list
+ * contains items but the queue has no freeing function registered.
+ */
+static void
+test__ezq_pop__no_free_fn__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int *p_item = (int *)0xFF;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    node.p_items[0] = (void *)0xFE;
+    node.count = 1;
+    node.p_next = NULL;
+    queue.free_fn = NULL;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.dynamic.count = 1;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_FREE_FN, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_PTR(0xFE, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
+    TEST_ASSERT_NULL(node.p_next);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_pop__no_free_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop_n retrieves items from both the underlying
+ * fixed-size buffer and the underlying linked list, then refills the
+ * buffer from the list.
+ */
+static void
+test__ezq_pop_n__non_empty_list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[EZQ_FIXED_BUFFER_CAPACITY + 1] = { 0 };
+    unsigned int popped = 0;
+    unsigned int i = 0;
+    struct ezq_linkedlist_node node = { 0 };
+
+    if (EZQ_LIST_NODE_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        queue.fixed.p_items[i] = (unsigned char *)0xFF - i;
+    }
+    node.p_items[0] = (void *)0x0E;
+    node.p_items[1] = (void *)0x0D;
+    node.count = 2;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.dynamic.count = 2;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    popped = ezq_pop_n(&queue, items, EZQ_FIXED_BUFFER_CAPACITY + 1, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY + 1, popped);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR((unsigned char *)0xFF - i, items[i]);
+    }
+    TEST_ASSERT_EQUAL_PTR(0x0E, items[EZQ_FIXED_BUFFER_CAPACITY]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(
+        0x0D,
+        queue.fixed.p_items[queue.fixed.front_index % EZQ_FIXED_BUFFER_CAPACITY]
+    );
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_NULL(queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+} /* test__ezq_pop_n__non_empty_list__success */
+
+/*!
+ * @brief Tests that \c ezq_pop_n retrieves every remaining item and
+ * reports that the queue is empty when more items are requested than the
+ * queue holds.
+ */
+static void
+test__ezq_pop_n__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[2] = { (void *)0xAA, (void *)0xAA };
+    unsigned int popped = 0;
+
+    /* Set any initial state. */
+    queue.fixed.count = 1;
+    queue.fixed.p_items[0] = (void *)0xFF;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    popped = ezq_pop_n(&queue, items, 2, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, popped);
+    TEST_ASSERT_EQUAL_PTR(0xFF, items[0]);
+    TEST_ASSERT_EQUAL_PTR(0xAA, items[1]);
+    TEST_ASSERT_NULL(queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+} /* test__ezq_pop_n__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_push_front places an item before the front item
+ * of a queue whose buffer has room.
+ */
+static void
+test__ezq_push_front__buf__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_front(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.fixed.count);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFE, p_item);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+} /* test__ezq_push_front__buf__success */
+
+/*!
+ * @brief Tests that \c ezq_push_front moves the back item of a full buffer
+ * to the front of the linked list, prepending a node once the front node
+ * has no room before its front item.
+ */
+static void
+test__ezq_push_front__list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node nodes[2] = { { { 0 } } };
+    void *p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    custom_alloc_fn_push(&nodes[1]);
+    custom_alloc_fn_push(&nodes[0]);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_front(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&nodes[0], queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(
+        (unsigned char *)0xFF + EZQ_FIXED_BUFFER_CAPACITY - 1,
+        nodes[0].p_items[0]
+    );
+    estat = ezq_push_front(&queue, (void *)0xFD);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&nodes[1], queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_PTR(&nodes[0], queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_PTR(&nodes[1], nodes[0].p_prev);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_LIST_NODE_CAPACITY - 1,
+        nodes[1].front_index
+    );
+    TEST_ASSERT_EQUAL_UINT32(2, queue.dynamic.count);
+
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFD, p_item);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFE, p_item);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_pop(&queue, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((unsigned char *)0xFF + i, p_item);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_NULL(queue.dynamic.p_tail);
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_push_front__list__success */
+
+/*!
+ * @brief Tests that \c ezq_push_front doubles the buffer of a full growable
+ * queue and places the item before its front item.
+ */
+static void
+test__ezq_push_front__growable_full__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[EZQ_FIXED_BUFFER_CAPACITY * 2] = { 0 };
+    void *p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init_growable(&queue, 0, 0, custom_alloc_fn, custom_free_fn);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        ezq_push(&queue, (unsigned char *)0xFF + i);
+    }
+    custom_alloc_fn_push(slots);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_front(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(slots, queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY + 1, queue.fixed.count);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFE, p_item);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_push_front__growable_full__success */
+
+/*!
+ * @brief Tests that \c ezq_push_front fails when the queue is at capacity.
+ */
+static void
+test__ezq_push_front__capacity_full__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 1, custom_alloc_fn, custom_free_fn);
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_front(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_push_front__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_push_front leaves the queue unchanged when the
+ * node needed to make room in a full buffer cannot be allocated.
+ */
+static void
+test__ezq_push_front__alloc_fail__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        ezq_push(&queue, (unsigned char *)0xFF + i);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_front(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_push_front__alloc_fail__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop_back retrieves the most recently pushed item
+ * from a queue whose items are all in its buffer.
+ */
+static void
+test__ezq_pop_back__buf__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    ezq_push(&queue, (void *)0xFF);
+    ezq_push(&queue, (void *)0xFE);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop_back(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFE, p_item);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+} /* test__ezq_pop_back__buf__success */
+
+/*!
+ * @brief Tests that \c ezq_pop_back takes the back item from the linked
+ * list, retiring its rear node once empty, before taking from the buffer.
+ */
+static void
+test__ezq_pop_back__list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+    void *p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    ezq_set_node_cache_limit(&queue, 0);
+    custom_alloc_fn_push(&node);
+    for (i = 0; i <= EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop_back(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(
+        (unsigned char *)0xFF + EZQ_FIXED_BUFFER_CAPACITY,
+        p_item
+    );
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_NULL(queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+    estat = ezq_pop_back(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(
+        (unsigned char *)0xFF + EZQ_FIXED_BUFFER_CAPACITY - 1,
+        p_item
+    );
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY - 1, queue.fixed.count);
+} /* test__ezq_pop_back__list__success */
+
+/*!
+ * @brief Tests that \c ezq_pop_back fails on an empty queue.
+ */
+static void
+test__ezq_pop_back__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop_back(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(p_item);
+} /* test__ezq_pop_back__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_reserve hands out only the contiguous run of
+ * free slots before the end of the fixed size buffer.
+ */
+static void
+test__ezq_reserve__buf_wrapped__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_slots = NULL;
+    unsigned int reserved = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    queue.fixed.front_index = EZQ_FIXED_BUFFER_CAPACITY - 1;
+    queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1] = (void *)0xAA;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    reserved = ezq_reserve(&queue, 2, &pp_slots, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, reserved);
+    TEST_ASSERT_EQUAL_PTR(
+        &queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1],
+        pp_slots
+    );
+    TEST_ASSERT_NULL(pp_slots[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.reserved);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+} /* test__ezq_reserve__buf_wrapped__success */
+
+/*!
+ * @brief Tests that \c ezq_reserve hands out slots of a new linked list
+ * node once the fixed size buffer is full.
+ */
+static void
+test__ezq_reserve__list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_slots = NULL;
+    unsigned int reserved = 0;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    custom_alloc_fn_push(&node);
+    queue.alloc_fn = custom_alloc_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    reserved = ezq_reserve(&queue, 1, &pp_slots, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, reserved);
+    TEST_ASSERT_EQUAL_PTR(&node.p_items[0], pp_slots);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.reserved);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, node.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+} /* test__ezq_reserve__list__success */
+
+/*!
+ * @brief Tests that \c ezq_reserve reserves nothing once the queue's
+ * capacity has been reached.
+ */
+static void
+test__ezq_reserve__capacity_full__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_slots = NULL;
+    unsigned int reserved = 0;
+
+    /* Set any initial state. */
+    queue.capacity = 1;
+    queue.fixed.count = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    reserved = ezq_reserve(&queue, 1, &pp_slots, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, reserved);
+    TEST_ASSERT_NULL(pp_slots);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.reserved);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+} /* test__ezq_reserve__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_commit publishes items written into reserved
+ * slots of the rear linked list node.
+ */
+static void
+test__ezq_commit__list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    node.p_items[0] = (void *)0xFE;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.dynamic.p_head = &node;
+    queue.dynamic.p_tail = &node;
+    queue.reserved = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_commit(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, node.count);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.reserved);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xFE, node.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+} /* test__ezq_commit__list__success */
+
+/*!
+ * @brief Tests that \c ezq_commit fails when asked to publish more slots
+ * than were reserved.
+ */
+static void
+test__ezq_commit__over_reserved__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    queue.fixed.p_items[0] = (void *)0xFE;
+    queue.reserved = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_commit(&queue, 2);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.reserved);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+} /* test__ezq_commit__over_reserved__failure */
+
+/*!
+ * @brief Tests that \c ezq_commit fails when a reserved slot was left
+ * \c NULL .
+ */
+static void
+test__ezq_commit__null_item__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    queue.reserved = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_commit(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.reserved);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+} /* test__ezq_commit__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_commit fails once a push has abandoned the
+ * reservation, rather than publishing slots behind the pushed item.
+ */
+static void
+test__ezq_commit__abandoned_by_push__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_slots = NULL;
+    unsigned int reserved = 0;
+    unsigned int i = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. The reservation is the last two slots of the
+     * fixed size buffer.
+     * */
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY - 2; ++i)
+    {
+        estat = ezq_push(&queue, (void *)(size_t)(i + 1));
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    reserved = ezq_reserve(&queue, 2, &pp_slots, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, reserved);
+    pp_slots[0] = (void *)0xFE;
+    pp_slots[1] = (void *)0xFE;
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_commit(&queue, 2);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.reserved);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY - 1, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(
+        0xFF,
+        queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 2]
+    );
+} /* test__ezq_commit__abandoned_by_push__failure */
+
+/*!
+ * @brief Tests that \c ezq_commit fails once a pop has abandoned the
+ * reservation.
+ */
+static void
+test__ezq_commit__abandoned_by_pop__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_slots = NULL;
+    void *p_item = NULL;
+    unsigned int reserved = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    estat = ezq_push(&queue, (void *)0xAA);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    reserved = ezq_reserve(&queue, 1, &pp_slots, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, reserved);
+    pp_slots[0] = (void *)0xFE;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xAA, p_item);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_commit(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.reserved);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+} /* test__ezq_commit__abandoned_by_pop__failure */
+
+/*!
+ * @brief Tests that \c ezq_peek exposes only the run of front items before
+ * the end of the fixed size buffer.
+ */
+static void
+test__ezq_peek__buf_wrapped__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_items = NULL;
+    unsigned int peeked = 0;
+
+    if (EZQ_FIXED_BUFFER_CAPACITY < 2)
+    {
+        return;
+    }
+
+    /* Set any initial state. */
+    queue.fixed.front_index = EZQ_FIXED_BUFFER_CAPACITY - 1;
+    queue.fixed.p_items[EZQ_FIXED_BUFFER_CAPACITY - 1] = (void *)0xFE;
+    queue.fixed.p_items[0] = (void *)0xFD;
+    queue.fixed.count = 2;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    peeked = ezq_peek(&queue, &pp_items, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, peeked);
+    TEST_ASSERT_EQUAL_PTR(0xFE, pp_items[0]);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(2, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(0xFD, queue.fixed.p_items[0]);
+} /* test__ezq_peek__buf_wrapped__success */
+
+/*!
+ * @brief Tests that \c ezq_peek exposes nothing when the queue is empty.
+ */
+static void
+test__ezq_peek__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void **pp_items = NULL;
+    unsigned int peeked = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    peeked = ezq_peek(&queue, &pp_items, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, peeked);
+    TEST_ASSERT_NULL(pp_items);
+} /* test__ezq_peek__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_release removes front items in place and moves
+ * the front item of the linked list into the fixed size buffer.
+ */
+static void
+test__ezq_release__non_empty_list__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    queue.fixed.p_items[0] = (void *)0xFF;
+    node.p_items[0] = (void *)0x0E;
+    node.count = 1;
+    queue.free_fn = custom_free_fn;
+    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
+    queue.dynamic.count = 1;
+    queue.dynamic.p_head = &node;
     queue.dynamic.p_tail = &node;
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(&queue, (void **)&p_item);
+    estat = ezq_release(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(0x0E, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+} /* test__ezq_release__non_empty_list__success */
+
+/*!
+ * @brief Tests that \c ezq_release removes nothing when asked to release
+ * more items than the fixed size buffer holds.
+ */
+static void
+test__ezq_release__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    queue.fixed.p_items[0] = (void *)0xFF;
+    queue.fixed.count = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_release(&queue, 2);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(0xFF, queue.fixed.p_items[0]);
+} /* test__ezq_release__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_ipush chains items through their own links once
+ * the fixed buffer is full, without allocating.
+ */
+static void
+test__ezq_ipush__chained__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_message messages[EZQ_FIXED_BUFFER_CAPACITY + 2];
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY + 2; ++i)
+    {
+        messages[i].id = i;
+        estat = ezq_ipush(&queue, &messages[i].link);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_PTR(&messages[0].link, queue.fixed.p_items[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.links.count);
+    TEST_ASSERT_EQUAL_PTR(
+        &messages[EZQ_FIXED_BUFFER_CAPACITY].link,
+        queue.links.p_head
+    );
+    TEST_ASSERT_EQUAL_PTR(
+        &messages[EZQ_FIXED_BUFFER_CAPACITY + 1].link,
+        queue.links.p_tail
+    );
+    TEST_ASSERT_EQUAL_PTR(queue.links.p_tail, queue.links.p_head->p_next);
+    TEST_ASSERT_NULL(queue.links.p_tail->p_next);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_FIXED_BUFFER_CAPACITY + 2,
+        ezq_count(&queue, NULL)
+    );
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dynamic.count);
+    TEST_ASSERT_NULL(queue.dynamic.p_head);
+    TEST_ASSERT_EQUAL_INT(-1, g_alloc_stack.top_index);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_ipush__chained__success */
+
+/*!
+ * @brief Tests that \c ezq_ipush fails when given a \c NULL link.
+ */
+static void
+test__ezq_ipush__null_item__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ipush(&queue, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.links.count);
+} /* test__ezq_ipush__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_ipop retrieves chained items in order, moving
+ * each front link of the chain into the fixed buffer, without freeing.
+ */
+static void
+test__ezq_ipop__chained__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_message messages[EZQ_FIXED_BUFFER_CAPACITY + 2];
+    struct ezq_link *p_link = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY + 2; ++i)
+    {
+        messages[i].id = i;
+        estat = ezq_ipush(&queue, &messages[i].link);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ipop(&queue, &p_link);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        0,
+        EZQ_CONTAINER_OF(p_link, struct test_message, link)->id
+    );
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.links.count);
+
+    for (i = 1; i < EZQ_FIXED_BUFFER_CAPACITY + 2; ++i)
+    {
+        estat = ezq_ipop(&queue, &p_link);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR(&messages[i], EZQ_CONTAINER_OF(
+            p_link,
+            struct test_message,
+            link
+        ));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_count(&queue, NULL));
+    TEST_ASSERT_NULL(queue.links.p_head);
+    TEST_ASSERT_NULL(queue.links.p_tail);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_INT(-1, g_alloc_stack.top_index);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_ipop__chained__success */
+
+/*!
+ * @brief Tests that \c ezq_ipop fails when the queue is empty.
+ */
+static void
+test__ezq_ipop__empty__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_link *p_link = (struct ezq_link *)0xAA;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ipop(&queue, &p_link);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xAA, p_link);
+} /* test__ezq_ipop__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_count succeeds properly when the queue contains
+ * no items.
+ */
+static void
+test__ezq_count__zero_count__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    /* Set any initial state. */
+    queue.fixed.count = 0;
+    queue.dynamic.count = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    count = ezq_count(&queue, &estat);
+    TEST_ASSERT_EQUAL_UINT(0, count);
+    TEST_ASSERT_EQUAL(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_count__zero_count__success */
+
+/*!
+ * @brief Tests that \c ezq_count succeeds properly when the queue contains
+ * any items.
+ */
+static void
+test__ezq_count__non_zero_count__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    /* Set any initial state. */
+    queue.fixed.count = 5;
+    queue.dynamic.count = 3;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    count = ezq_count(&queue, &estat);
+    TEST_ASSERT_EQUAL_UINT(queue.fixed.count + queue.dynamic.count, count);
+    TEST_ASSERT_EQUAL(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_count__non_zero_count__success */
+
+/*!
+ * @brief Test that \c ezq_count fails when passed an \c ezq_queue pointer
+ * that is \c NULL .
+ */
+static void
+test__ezq_count__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    count = ezq_count(NULL, &estat);
+    TEST_ASSERT_EQUAL_UINT(0, count);
+    TEST_ASSERT_EQUAL(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_count__null_queue__failure */
+
+/*!
+ * @brief Tests that \c ezq_set_node_cache_limit releases cached nodes
+ * beyond a lowered limit.
+ */
+static void
+test__ezq_set_node_cache_limit__lowered__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node nodes[3] = { 0 };
+
+    /* Set any initial state. */
+    nodes[0].p_next = &nodes[1];
+    nodes[1].p_next = &nodes[2];
+    nodes[2].p_next = NULL;
+    queue.free_fn = custom_free_fn;
+    queue.node_cache.p_top = &nodes[0];
+    queue.node_cache.count = 3;
+    queue.node_cache.limit = 3;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_set_node_cache_limit(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.node_cache.limit);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.node_cache.count);
+    TEST_ASSERT_EQUAL_PTR(&nodes[2], queue.node_cache.p_top);
+    TEST_ASSERT_EQUAL_UINT(2, g_free_count);
+} /* test__ezq_set_node_cache_limit__lowered__success */
+
+/*!
+ * @brief Tests that \c ezq_set_node_cache_limit fails when it would need to
+ * release cached nodes but the queue has no freeing function registered.
+ */
+static void
+test__ezq_set_node_cache_limit__no_free_fn__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+
+    /* Set any initial state. */
+    queue.free_fn = NULL;
+    queue.node_cache.p_top = &node;
+    queue.node_cache.count = 1;
+    queue.node_cache.limit = 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_set_node_cache_limit(&queue, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_FREE_FN, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, queue.node_cache.limit);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.node_cache.count);
+    TEST_ASSERT_EQUAL_PTR(&node, queue.node_cache.p_top);
+} /* test__ezq_set_node_cache_limit__no_free_fn__failure */
+
+/*!
+ * @brief Tests that a queue in LIFO mode pops its most recently pushed
+ * items first with both \c ezq_pop and \c ezq_pop_n , including those in
+ * its linked list.
+ */
+static void
+test__ezq_set_lifo__stack__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+    void *items[EZQ_FIXED_BUFFER_CAPACITY] = { 0 };
+    void *p_item = NULL;
+    unsigned int popped = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    custom_alloc_fn_push(&node);
+    for (i = 0; i <= EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_set_lifo(&queue, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(
+        (unsigned char *)0xFF + EZQ_FIXED_BUFFER_CAPACITY,
+        p_item
+    );
+    popped = ezq_pop_n(&queue, items, EZQ_FIXED_BUFFER_CAPACITY, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, popped);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR(
+            (unsigned char *)0xFF + EZQ_FIXED_BUFFER_CAPACITY - 1 - i,
+            items[i]
+        );
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_count(&queue, NULL));
+    estat = ezq_set_lifo(&queue, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.flags & EZQ_FLAG_LIFO);
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_set_lifo__stack__success */
+
+/*!
+ * @brief Tests that \c ezq_set_lifo fails when passed a \c NULL queue.
+ */
+static void
+test__ezq_set_lifo__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_set_lifo(NULL, 1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_set_lifo__null_queue__failure */
+
+/*!
+ * @brief Tests that \c ezq_trim releases every cached node.
+ */
+static void
+test__ezq_trim__cached_nodes__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node nodes[2] = { 0 };
+
+    /* Set any initial state. */
+    nodes[0].p_next = &nodes[1];
+    nodes[1].p_next = NULL;
+    queue.free_fn = custom_free_fn;
+    queue.node_cache.p_top = &nodes[0];
+    queue.node_cache.count = 2;
+    queue.node_cache.limit = 4;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_trim(&queue);
     TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
-    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
-    TEST_ASSERT_EQUAL_PTR(0xFE, queue.fixed.p_items[0]);
-    TEST_ASSERT_NULL(node.p_item);
-    TEST_ASSERT_NULL(node.p_next);
-    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
-    TEST_ASSERT_EQUAL(0, queue.dynamic.count);
-    TEST_ASSERT_NULL(queue.dynamic.p_head);
-    TEST_ASSERT_NULL(queue.dynamic.p_tail);
-} /* test__ezq_pop__non_empty_list__success */
+    TEST_ASSERT_NULL(queue.node_cache.p_top);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.node_cache.count);
+    TEST_ASSERT_EQUAL_UINT32(4, queue.node_cache.limit);
+    TEST_ASSERT_EQUAL_UINT(2, g_free_count);
+} /* test__ezq_trim__cached_nodes__success */
 
 /*!
- * @brief Tests that \c ezq_pop fails when passed an \c ezq_queue pointer
+ * @brief Tests that \c ezq_trim fails when passed an \c ezq_queue pointer
  * that is \c NULL .
  */
 static void
-test__ezq_pop__null_queue__failure(void)
+test__ezq_trim__null_queue__failure(void)
 {
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    int *p_item = (int *)0xFF;
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(NULL, (void **)&p_item);
+    estat = ezq_trim(NULL);
     TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_trim__null_queue__failure */
 
-    /* Validate that nothing else was unexpectedly modified. */
-    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
-} /* test__ezq_pop__null_queue__failure */
+#if defined(EZQ_ENABLE_STATS) || defined(EZQ_ENABLE_SOJOURN)
+/*!
+ * @brief Gets the current reading of the dummy clock.
+ *
+ * @return The value of \c g_ticks .
+ */
+static unsigned long
+custom_clock_fn(void)
+{
+    return g_ticks;
+} /* custom_clock_fn */
+#endif /* EZQ_ENABLE_STATS || EZQ_ENABLE_SOJOURN */
 
+#ifdef EZQ_ENABLE_STATS
 /*!
- * @brief Tests that \c ezq_pop fails when passed an out variable
- * pointer that is \c NULL .
+ * @brief Tests that \c ezq_stats reports the pushes, pops, allocations and
+ * timed spell above the fixed capacity of a queue that spilled into its
+ * linked list.
  */
 static void
-test__ezq_pop__null_out__failure(void)
+test__ezq_stats__spill__success(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_stats stats;
+    struct ezq_linkedlist_node node = { 0 };
+    void *p_item = NULL;
+    unsigned int i = 0;
 
     /* Set any initial state. */
-    queue.fixed.count = 1;
-    queue.fixed.p_items[0] = (void *)0xFF;
+    estat = ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_set_stats_clock(&queue, custom_clock_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    custom_alloc_fn_push(&node);
+    g_ticks = 100;
+    for (i = 0; i <= EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF - i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    g_ticks = 105;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_ticks = 200;
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(&queue, NULL);
-    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_OUT, estat);
+    estat = ezq_stats(&queue, &stats);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY + 1, stats.pushes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.pops);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.full_rejections);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overflow_allocs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.alloc_failures);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.spills);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.spill_ticks);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY + 1, stats.high_water);
 
-    /* Validate that nothing else was unexpectedly modified. */
-    TEST_ASSERT_EQUAL_UINT32(1, queue.fixed.count);
-    TEST_ASSERT_EQUAL_PTR(0xFF, queue.fixed.p_items[0]);
-} /* test__ezq_pop__null_out__failure */
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_stats__spill__success */
 
 /*!
- * @brief Tests that \c ezq_pop fails when there are no items in the queue.
+ * @brief Tests that \c ezq_stats counts pushes refused because the queue
+ * was full and allocations that failed.
  */
 static void
-test__ezq_pop__empty__failure(void)
+test__ezq_stats__rejections__success(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    int *p_item = (int *)0xFF;
+    struct ezq_stats stats;
+    unsigned int i = 0;
 
     /* Set any initial state. */
-    queue.fixed.count = 0;
-    queue.dynamic.count = 0;
+    estat = ezq_init(
+        &queue,
+        EZQ_FIXED_BUFFER_CAPACITY + 1,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY; ++i)
+    {
+        estat = ezq_push(&queue, (unsigned char *)0xFF - i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    estat = ezq_push(&queue, (void *)0x0F);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+    queue.capacity = EZQ_FIXED_BUFFER_CAPACITY;
+    estat = ezq_push(&queue, (void *)0x0F);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(&queue, (void **)&p_item);
-    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    estat = ezq_stats(&queue, &stats);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, stats.pushes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.full_rejections);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overflow_allocs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.alloc_failures);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.spills);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, stats.high_water);
 
-    /* Validate that nothing else was unexpectedly modified. */
-    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
-} /* test__ezq_pop__empty__failure */
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_stats__rejections__success */
 
 /*!
- * @brief Tests that \c ezq_pop fails when the underlying linked list
- * contains items but the queue has no freeing function registered.
+ * @brief Tests that \c ezq_stats fails when given a \c NULL output.
  */
 static void
-test__ezq_pop__no_free_fn__failure(void)
+test__ezq_stats__null_out__failure(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    int *p_item = (int *)0xFF;
-    struct ezq_linkedlist_node node = { 0 };
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_stats(&queue, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_OUT, estat);
+} /* test__ezq_stats__null_out__failure */
+
+/*!
+ * @brief Tests that \c ezq_stats_format writes every counter in the
+ * Prometheus text format, escaping the queue label.
+ */
+static void
+test__ezq_stats_format__standard__success(void)
+{
+    struct ezq_stats stats = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    char text[2048];
+    size_t len = 0;
 
     /* Set any initial state. */
-    node.p_item = (void *)0xFE;
-    node.p_next = NULL;
-    queue.free_fn = NULL;
-    queue.fixed.count = EZQ_FIXED_BUFFER_CAPACITY;
-    queue.dynamic.count = 1;
-    queue.dynamic.p_head = &node;
-    queue.dynamic.p_tail = &node;
+    stats.pushes = 1234567;
+    stats.depth = 3;
 
     /* Invoke the function being tested and verify the expected outcome. */
-    estat = ezq_pop(&queue, (void **)&p_item);
-    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_FREE_FN, estat);
-    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.fixed.count);
-    TEST_ASSERT_EQUAL_UINT32(1, queue.dynamic.count);
-    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_head);
-    TEST_ASSERT_EQUAL_PTR(&node, queue.dynamic.p_tail);
-    TEST_ASSERT_EQUAL_PTR(0xFE, node.p_item);
-    TEST_ASSERT_NULL(node.p_next);
+    len = ezq_stats_format(&stats, "a\"b", text, sizeof(text), &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(strlen(text), len);
+    TEST_ASSERT_EQUAL_PTR(
+        text,
+        strstr(
+            text,
+            "# HELP ezq_pushes_total Items placed in the queue.\n"
+            "# TYPE ezq_pushes_total counter\n"
+            "ezq_pushes_total{queue=\"a\\\"b\"} 1234567\n"
+        )
+    );
+    TEST_ASSERT_NOT_NULL(
+        strstr(text, "\nezq_pops_total{queue=\"a\\\"b\"} 0\n")
+    );
+    TEST_ASSERT_NOT_NULL(strstr(text, "\n# TYPE ezq_depth gauge\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "\nezq_depth{queue=\"a\\\"b\"} 3\n"));
+} /* test__ezq_stats_format__standard__success */
 
-    /* Validate that nothing else was unexpectedly modified. */
-    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
-} /* test__ezq_pop__no_free_fn__failure */
+/*!
+ * @brief Tests that \c ezq_stats_format reports the full length of text
+ * that does not fit, keeping the buffer terminated.
+ */
+static void
+test__ezq_stats_format__truncated__failure(void)
+{
+    struct ezq_stats stats = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    char text[8];
+    size_t len = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    len = ezq_stats_format(&stats, NULL, text, sizeof(text), &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_TRUE(len >= sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("# HELP ", text);
+    TEST_ASSERT_EQUAL_UINT(len, ezq_stats_format(&stats, NULL, NULL, 0, NULL));
+} /* test__ezq_stats_format__truncated__failure */
+#endif /* EZQ_ENABLE_STATS */
 
+#ifdef EZQ_ENABLE_SOJOURN
 /*!
- * @brief Tests that \c ezq_count succeeds properly when the queue contains
- * no items.
+ * @brief Tests that \c ezq_sojourn_percentile reports the percentiles of
+ * how long items spent in the queue, to within the histogram's precision.
  */
 static void
-test__ezq_count__zero_count__success(void)
+test__ezq_sojourn_percentile__standard__success(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    unsigned int count = 0;
+    void *p_item = NULL;
+    unsigned long ticks = 0;
+    unsigned int i = 0;
 
     /* Set any initial state. */
-    queue.fixed.count = 0;
-    queue.dynamic.count = 0;
+    estat = ezq_init(&queue, 0, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_set_sojourn_clock(&queue, custom_clock_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 1000; ++i)
+    {
+        g_ticks = 10000UL * i;
+        estat = ezq_push(&queue, (void *)0xFF);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        g_ticks += i;
+        estat = ezq_pop(&queue, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
 
     /* Invoke the function being tested and verify the expected outcome. */
-    count = ezq_count(&queue, &estat);
-    TEST_ASSERT_EQUAL_UINT(0, count);
-    TEST_ASSERT_EQUAL(EZQ_STATUS_SUCCESS, estat);
-} /* test__ezq_count__zero_count__success */
+    ticks = ezq_sojourn_percentile(&queue, 500, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(ticks >= 500 && ticks <= 500 + 500 / 16);
+    ticks = ezq_sojourn_percentile(&queue, 990, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(ticks >= 990 && ticks <= 990 + 990 / 16);
+    ticks = ezq_sojourn_percentile(&queue, 999, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1000, ticks);
+    ticks = ezq_sojourn_percentile(&queue, 0, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, ticks);
+} /* test__ezq_sojourn_percentile__standard__success */
 
 /*!
- * @brief Tests that \c ezq_count succeeds properly when the queue contains
- * any items.
+ * @brief Tests that \c ezq_sojourn_percentile fails when no items have been
+ * timed, such as when the queue has no sojourn clock.
  */
 static void
-test__ezq_count__non_zero_count__success(void)
+test__ezq_sojourn_percentile__no_clock__failure(void)
 {
     ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
-    unsigned int count = 0;
+    void *p_item = NULL;
 
     /* Set any initial state. */
-    queue.fixed.count = 5;
-    queue.dynamic.count = 3;
+    estat = ezq_init(&queue, 0, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
 
     /* Invoke the function being tested and verify the expected outcome. */
-    count = ezq_count(&queue, &estat);
-    TEST_ASSERT_EQUAL_UINT(queue.fixed.count + queue.dynamic.count, count);
-    TEST_ASSERT_EQUAL(EZQ_STATUS_SUCCESS, estat);
-} /* test__ezq_count__non_zero_count__success */
+    (void)ezq_sojourn_percentile(&queue, 500, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+} /* test__ezq_sojourn_percentile__no_clock__failure */
 
 /*!
- * @brief Test that \c ezq_count fails when passed an \c ezq_queue pointer
- * that is \c NULL .
+ * @brief Tests that \c ezq_sojourn times a sample of the items of a queue
+ * deeper than \c EZQ_SOJOURN_STAMPS , matching each stamp to its own item
+ * across batch pushes and pops.
  */
 static void
-test__ezq_count__null_queue__failure(void)
+test__ezq_sojourn__sampled__success(void)
 {
+    ezq_queue queue = { 0 };
     ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_sojourn_summary summary;
+    void *slots[2 * EZQ_SOJOURN_STAMPS];
+    void *items[EZQ_SOJOURN_STAMPS + 1];
     unsigned int count = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_init_buffer(
+        &queue,
+        0,
+        slots,
+        2 * EZQ_SOJOURN_STAMPS,
+        NULL,
+        NULL
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_set_sojourn_clock(&queue, custom_clock_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i <= EZQ_SOJOURN_STAMPS; ++i)
+    {
+        items[i] = (unsigned char *)0xFF + i;
+    }
+    g_ticks = 10;
+    estat = ezq_push(&queue, items[0]);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_ticks = 20;
+    count = ezq_push_n(&queue, &items[1], EZQ_SOJOURN_STAMPS, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_SOJOURN_STAMPS, count);
+    g_ticks = 50;
+    count = ezq_pop_n(&queue, items, EZQ_SOJOURN_STAMPS + 1, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_SOJOURN_STAMPS + 1, count);
 
     /* Invoke the function being tested and verify the expected outcome. */
-    count = ezq_count(NULL, &estat);
-    TEST_ASSERT_EQUAL_UINT(0, count);
-    TEST_ASSERT_EQUAL(EZQ_STATUS_NULL_QUEUE, estat);
-} /* test__ezq_count__null_queue__failure */
+    estat = ezq_sojourn(&queue, &summary);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_SOJOURN_STAMPS, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(30, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(40, summary.p999);
+    TEST_ASSERT_EQUAL_UINT32(40, summary.max);
+} /* test__ezq_sojourn__sampled__success */
+
+/*!
+ * @brief Tests that \c ezq_sojourn fails when given a \c NULL output.
+ */
+static void
+test__ezq_sojourn__null_out__failure(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sojourn(&queue, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_OUT, estat);
+} /* test__ezq_sojourn__null_out__failure */
+
+/*!
+ * @brief Tests that items placed at the front or taken from the back of a
+ * queue are timed like any others.
+ */
+static void
+test__ezq_sojourn__deque__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node nodes[2] = { { { 0 } } };
+    struct ezq_sojourn_summary summary = { 0 };
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_set_sojourn_clock(&queue, custom_clock_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    custom_alloc_fn_push(&nodes[1]);
+    custom_alloc_fn_push(&nodes[0]);
+    g_ticks = 0;
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_ticks = 10;
+    estat = ezq_push(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_ticks = 20;
+    estat = ezq_push_front(&queue, (void *)0xFD);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    g_ticks = 25;
+    estat = ezq_pop_back(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFE, p_item);
+    g_ticks = 28;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFD, p_item);
+    g_ticks = 40;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(0xFF, p_item);
+    estat = ezq_sojourn(&queue, &summary);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(3, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(15, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(40, summary.max);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, queue.sojourn.stamp_count);
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sojourn__deque__success */
+
+/*!
+ * @brief Tests that \c ezq_sojourn_reset empties the histogram while items
+ * already queued remain stamped.
+ */
+static void
+test__ezq_sojourn_reset__standard__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_linkedlist_node node = { 0 };
+    void *p_item = NULL;
+    unsigned long ticks = 0;
+
+    /* Set any initial state. */
+    estat = ezq_init(&queue, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_set_sojourn_clock(&queue, custom_clock_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    custom_alloc_fn_push(&node);
+    g_ticks = 0;
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_push(&queue, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_ticks = 7;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sojourn_reset(&queue);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    (void)ezq_sojourn_percentile(&queue, 500, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    g_ticks = 9;
+    estat = ezq_pop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    ticks = ezq_sojourn_percentile(&queue, 500, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(9, ticks);
+
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sojourn_reset__standard__success */
+#endif /* EZQ_ENABLE_SOJOURN */
 
 /*!
  * @brief Tests that \c ezq_destroy succeeds when called on an empty queue.
@@ -634,7 +2716,8 @@ test__ezq_destroy__non_null_cleanup_fn__success(void)
     /* Set any initial state. */
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        nodes[i].p_item = (unsigned char *)0xFF - i;
+        nodes[i].p_items[0] = (unsigned char *)0xFF - i;
+        nodes[i].count = 1;
         if (i + 1 >= sizeof(nodes)/sizeof(nodes[0]))
         {
             nodes[i].p_next = NULL;
@@ -661,7 +2744,7 @@ test__ezq_destroy__non_null_cleanup_fn__success(void)
     TEST_ASSERT_EQUAL(sizeof(nodes)/sizeof(nodes[0]), cleanup_count);
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        TEST_ASSERT_NULL(nodes[i].p_item);
+        TEST_ASSERT_NULL(nodes[i].p_items[0]);
         TEST_ASSERT_NULL(nodes[i].p_next);
     }
 } /* test__ezq_destroy__non_null_cleanup_fn__success */
@@ -681,7 +2764,8 @@ test__ezq_destroy__null_cleanup_fn__success(void)
     /* Set any initial state. */
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        nodes[i].p_item = (unsigned char *)0xFF - i;
+        nodes[i].p_items[0] = (unsigned char *)0xFF - i;
+        nodes[i].count = 1;
         if (i + 1 >= sizeof(nodes)/sizeof(nodes[0]))
         {
             nodes[i].p_next = NULL;
@@ -707,11 +2791,38 @@ test__ezq_destroy__null_cleanup_fn__success(void)
     TEST_ASSERT_EQUAL_UINT(0, queue.capacity);
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        TEST_ASSERT_NULL(nodes[i].p_item);
+        TEST_ASSERT_NULL(nodes[i].p_items[0]);
         TEST_ASSERT_NULL(nodes[i].p_next);
     }
 } /* test__ezq_destroy__null_cleanup_fn__success */
 
+/*!
+ * @brief Tests that \c ezq_destroy leaves caller-provided storage to the
+ * caller, and so needs no free function for it.
+ */
+static void
+test__ezq_destroy__caller_buf__success(void)
+{
+    ezq_queue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *slots[2] = { NULL };
+
+    /* Set any initial state. */
+    estat = ezq_init_buffer(&queue, 0, slots, 2, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_push(&queue, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NULL(queue.fixed.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.fixed.count);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.flags);
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+} /* test__ezq_destroy__caller_buf__success */
+
 /*!
  * @brief Test that \c ezq_destroy fails when passed an \c ezq_queue
  * pointer that is \c NULL .
@@ -741,7 +2852,8 @@ test__ezq_destroy__no_free_fn__failure(void)
     /* Set any initial state. */
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        nodes[i].p_item = (unsigned char *)0xFF - i;
+        nodes[i].p_items[0] = (unsigned char *)0xFF - i;
+        nodes[i].count = 1;
         if (i + 1 >= sizeof(nodes)/sizeof(nodes[0]))
         {
             nodes[i].p_next = NULL;
@@ -774,7 +2886,10 @@ test__ezq_destroy__no_free_fn__failure(void)
     TEST_ASSERT_EQUAL_UINT(sizeof(nodes)/sizeof(nodes[0]), queue.capacity);
     for (i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i)
     {
-        TEST_ASSERT_EQUAL_PTR((unsigned char *)0xFF - i, nodes[i].p_item);
+        TEST_ASSERT_EQUAL_PTR(
+            (unsigned char *)0xFF - i,
+            nodes[i].p_items[0]
+        );
         if (i + 1 >= sizeof(nodes)/sizeof(nodes[0]))
         {
             TEST_ASSERT_NULL(nodes[i].p_next);
@@ -802,9 +2917,25 @@ int main(int argc, char **argv) {
     RUN_TEST(test__ezq_init__standard__success);
     RUN_TEST(test__ezq_init__null_queue__failure);
 
+    /* ezq_init_growable */
+    RUN_TEST(test__ezq_init_growable__standard__success);
+    RUN_TEST(test__ezq_init_growable__null_queue__failure);
+
+    /* ezq_init_buffer */
+    RUN_TEST(test__ezq_init_buffer__standard__success);
+    RUN_TEST(test__ezq_init_buffer__null_queue__failure);
+    RUN_TEST(test__ezq_init_buffer__zero_slots__failure);
+    RUN_TEST(test__ezq_init_buffer__non_pow2_slots__failure);
+
     /* ezq_push */
     RUN_TEST(test__ezq_push__buf__success);
+    RUN_TEST(test__ezq_push__buf_wrapped__success);
     RUN_TEST(test__ezq_push__list__success);
+    RUN_TEST(test__ezq_push__list_partial_node__success);
+    RUN_TEST(test__ezq_push__list_cached_node__success);
+    RUN_TEST(test__ezq_push__growable_full__success);
+    RUN_TEST(test__ezq_push__growable_no_alloc_fn__failure);
+    RUN_TEST(test__ezq_push__caller_buf__success);
     RUN_TEST(test__ezq_push__null_queue__failure);
     RUN_TEST(test__ezq_push__null_item__failure);
     RUN_TEST(test__ezq_push__capacity_full_buf__failure);
@@ -812,23 +2943,114 @@ int main(int argc, char **argv) {
     RUN_TEST(test__ezq_push__no_alloc_fn__failure);
     RUN_TEST(test__ezq_push__alloc_fail__failure);
 
+    /* ezq_push_n */
+    RUN_TEST(test__ezq_push_n__buf_wrapped__success);
+    RUN_TEST(test__ezq_push_n__list__success);
+    RUN_TEST(test__ezq_push_n__capacity_full__failure);
+    RUN_TEST(test__ezq_push_n__null_item__failure);
+
     /* ezq_pop */
     RUN_TEST(test__ezq_pop__empty_list__success);
     RUN_TEST(test__ezq_pop__non_empty_list__success);
+    RUN_TEST(test__ezq_pop__list_partial_node__success);
+    RUN_TEST(test__ezq_pop__non_empty_list_cache__success);
+    RUN_TEST(test__ezq_pop__growable_shrink__success);
     RUN_TEST(test__ezq_pop__null_queue__failure);
     RUN_TEST(test__ezq_pop__null_out__failure);
     RUN_TEST(test__ezq_pop__empty__failure);
     RUN_TEST(test__ezq_pop__no_free_fn__failure);
 
+    /* ezq_pop_n */
+    RUN_TEST(test__ezq_pop_n__non_empty_list__success);
+    RUN_TEST(test__ezq_pop_n__empty__failure);
+
+    /* ezq_push_front */
+    RUN_TEST(test__ezq_push_front__buf__success);
+    RUN_TEST(test__ezq_push_front__list__success);
+    RUN_TEST(test__ezq_push_front__growable_full__success);
+    RUN_TEST(test__ezq_push_front__capacity_full__failure);
+    RUN_TEST(test__ezq_push_front__alloc_fail__failure);
+
+    /* ezq_pop_back */
+    RUN_TEST(test__ezq_pop_back__buf__success);
+    RUN_TEST(test__ezq_pop_back__list__success);
+    RUN_TEST(test__ezq_pop_back__empty__failure);
+
+    /* ezq_reserve */
+    RUN_TEST(test__ezq_reserve__buf_wrapped__success);
+    RUN_TEST(test__ezq_reserve__list__success);
+    RUN_TEST(test__ezq_reserve__capacity_full__failure);
+
+    /* ezq_commit */
+    RUN_TEST(test__ezq_commit__list__success);
+    RUN_TEST(test__ezq_commit__over_reserved__failure);
+    RUN_TEST(test__ezq_commit__null_item__failure);
+    RUN_TEST(test__ezq_commit__abandoned_by_push__failure);
+    RUN_TEST(test__ezq_commit__abandoned_by_pop__failure);
+
+    /* ezq_peek */
+    RUN_TEST(test__ezq_peek__buf_wrapped__success);
+    RUN_TEST(test__ezq_peek__empty__failure);
+
+    /* ezq_release */
+    RUN_TEST(test__ezq_release__non_empty_list__success);
+    RUN_TEST(test__ezq_release__empty__failure);
+
+    /* ezq_ipush */
+    RUN_TEST(test__ezq_ipush__chained__success);
+    RUN_TEST(test__ezq_ipush__null_item__failure);
+
+    /* ezq_ipop */
+    RUN_TEST(test__ezq_ipop__chained__success);
+    RUN_TEST(test__ezq_ipop__empty__failure);
+
     /* ezq_count */
     RUN_TEST(test__ezq_count__zero_count__success);
     RUN_TEST(test__ezq_count__non_zero_count__success);
     RUN_TEST(test__ezq_count__null_queue__failure);
 
+    /* ezq_set_node_cache_limit */
+    RUN_TEST(test__ezq_set_node_cache_limit__lowered__success);
+    RUN_TEST(test__ezq_set_node_cache_limit__no_free_fn__failure);
+
+    /* ezq_set_lifo */
+    RUN_TEST(test__ezq_set_lifo__stack__success);
+    RUN_TEST(test__ezq_set_lifo__null_queue__failure);
+
+    /* ezq_trim */
+    RUN_TEST(test__ezq_trim__cached_nodes__success);
+    RUN_TEST(test__ezq_trim__null_queue__failure);
+
+#ifdef EZQ_ENABLE_STATS
+    /* ezq_stats */
+    RUN_TEST(test__ezq_stats__spill__success);
+    RUN_TEST(test__ezq_stats__rejections__success);
+    RUN_TEST(test__ezq_stats__null_out__failure);
+
+    /* ezq_stats_format */
+    RUN_TEST(test__ezq_stats_format__standard__success);
+    RUN_TEST(test__ezq_stats_format__truncated__failure);
+#endif /* EZQ_ENABLE_STATS */
+
+#ifdef EZQ_ENABLE_SOJOURN
+    /* ezq_sojourn_percentile */
+    RUN_TEST(test__ezq_sojourn_percentile__standard__success);
+    RUN_TEST(test__ezq_sojourn_percentile__no_clock__failure);
+
+    /* ezq_sojourn */
+    RUN_TEST(test__ezq_sojourn__sampled__success);
+    RUN_TEST(test__ezq_sojourn__deque__success);
+    RUN_TEST(test__ezq_sojourn__null_out__failure);
+
+    /* ezq_sojourn_reset */
+    RUN_TEST(test__ezq_sojourn_reset__standard__success);
+#endif /* EZQ_ENABLE_SOJOURN */
+
     /* ezq_destroy */
     RUN_TEST(test__ezq_destroy__empty_queue__success);
     RUN_TEST(test__ezq_destroy__null_cleanup_fn__success);
     RUN_TEST(test__ezq_destroy__non_null_cleanup_fn__success);
+    RUN_TEST(test__ezq_destroy__caller_buf__success);
     RUN_TEST(test__ezq_destroy__null_queue__failure);
     RUN_TEST(test__ezq_destroy__no_free_fn__failure);
 
@@ -0,0 +1,313 @@
+#include <assert.h>
+#include "easyqueue_compact.h"
+
+#ifndef NULL
+ #define NULL ((void *)0)
+#endif /* NULL */
+
+/* Gets the ring index of the item offset places behind the front item. The
+ * ring's capacity is always a power of two, so the front index increases
+ * monotonically and is masked into range.
+ */
+#define EZQ_CRING_INDEX(p_queue, offset) \
+    (((p_queue)->front_index + (offset)) & ((p_queue)->slot_capacity - 1))
+
+/*!
+ * @brief Moves the items of the queue into a newly allocated ring able to
+ * hold \c new_capacity items, releasing the old ring.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_cqueue to resize.
+ * @param[in] new_capacity Number of items the new ring must hold. Must be a
+ * power of two no less than the number of items in the queue.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the ring was replaced, otherwise
+ * \c EZQ_STATUS_ALLOC_FAILURE , in which case the ring is left unchanged.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_cresize_unsafe(
+    ezq_cqueue * const p_queue,
+    const unsigned int new_capacity
+);
+
+ezq_status EZQ_API
+ezq_cinit(
+    ezq_cqueue * const p_queue,
+    const unsigned int capacity,
+    const ezq_allocator * const p_allocator
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_allocator || NULL == p_allocator->alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == p_allocator->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    p_queue->p_slots = NULL;
+    p_queue->p_allocator = p_allocator;
+    p_queue->front_index = 0;
+    p_queue->count = 0;
+    p_queue->slot_capacity = 0;
+    p_queue->capacity = capacity;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_cinit */
+
+ezq_status EZQ_API
+ezq_cpush(ezq_cqueue * const p_queue, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+    if (p_queue->capacity > 0 && p_queue->count >= p_queue->capacity)
+    {
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    /* Allocate the ring on first use, and double it once it is full. */
+    if (p_queue->count >= p_queue->slot_capacity)
+    {
+        if (p_queue->slot_capacity > (unsigned int)-1 / 2)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+        estat = ezq_cresize_unsafe(
+            p_queue,
+            0 == p_queue->slot_capacity
+                ? EZQ_COMPACT_MIN_SLOTS
+                : p_queue->slot_capacity * 2
+        );
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+
+    p_queue->p_slots[EZQ_CRING_INDEX(p_queue, p_queue->count)] = p_item;
+    ++p_queue->count;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_cpush */
+
+ezq_status EZQ_API
+ezq_cpop(ezq_cqueue * const p_queue, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    *pp_item = p_queue->p_slots[EZQ_CRING_INDEX(p_queue, 0)];
+    ++p_queue->front_index;
+    --p_queue->count;
+
+    /* Halve a ring that has grown beyond its minimum size once no more than
+     * a quarter of it is in use. The ring is kept if that fails.
+     * */
+    if (
+        p_queue->slot_capacity > EZQ_COMPACT_MIN_SLOTS
+        && p_queue->count <= p_queue->slot_capacity / 4
+    )
+    {
+        (void)ezq_cresize_unsafe(p_queue, p_queue->slot_capacity / 2);
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_cpop */
+
+unsigned int EZQ_API
+ezq_ccount(const ezq_cqueue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    count = p_queue->count;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_ccount */
+
+ezq_status EZQ_API
+ezq_ctrim(ezq_cqueue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int new_capacity = EZQ_COMPACT_MIN_SLOTS;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    if (0 == p_queue->count)
+    {
+        if (NULL != p_queue->p_slots)
+        {
+            p_queue->p_allocator->free_fn(p_queue->p_slots);
+        }
+        p_queue->p_slots = NULL;
+        p_queue->front_index = 0;
+        p_queue->slot_capacity = 0;
+        goto done;
+    }
+
+    while (new_capacity < p_queue->count)
+    {
+        new_capacity *= 2;
+    }
+    if (new_capacity < p_queue->slot_capacity)
+    {
+        estat = ezq_cresize_unsafe(p_queue, new_capacity);
+    }
+
+done:
+    return estat;
+} /* ezq_ctrim */
+
+ezq_status EZQ_API
+ezq_cdestroy(
+    ezq_cqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    for (i = 0; NULL != item_cleanup_fn && i < p_queue->count; ++i)
+    {
+        item_cleanup_fn(
+            p_queue->p_slots[EZQ_CRING_INDEX(p_queue, i)],
+            p_args
+        );
+    }
+    if (NULL != p_queue->p_slots)
+    {
+        p_queue->p_allocator->free_fn(p_queue->p_slots);
+    }
+
+    p_queue->p_slots = NULL;
+    p_queue->p_allocator = NULL;
+    p_queue->front_index = 0;
+    p_queue->count = 0;
+    p_queue->slot_capacity = 0;
+    p_queue->capacity = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_cdestroy */
+
+static ezq_status EZQ_API
+ezq_cresize_unsafe(
+    ezq_cqueue * const p_queue,
+    const unsigned int new_capacity
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void ** p_new = NULL;
+    size_t size = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+    assert(new_capacity >= p_queue->count);
+    assert(0 == (new_capacity & (new_capacity - 1)));
+
+    /* Guard against the size calculation wrapping on narrow targets. */
+    size = (size_t)new_capacity * sizeof(*p_new);
+    if (size / sizeof(*p_new) != new_capacity)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    p_new = (void **)p_queue->p_allocator->alloc_fn(size);
+    if (NULL == p_new)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    for (i = 0; i < p_queue->count; ++i)
+    {
+        p_new[i] = p_queue->p_slots[EZQ_CRING_INDEX(p_queue, i)];
+    }
+    if (NULL != p_queue->p_slots)
+    {
+        p_queue->p_allocator->free_fn(p_queue->p_slots);
+    }
+
+    p_queue->p_slots = p_new;
+    p_queue->front_index = 0;
+    p_queue->slot_capacity = new_capacity;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_cresize_unsafe */
@@ -0,0 +1,334 @@
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_compact.h"
+
+size_t g_alloc_size; /* size last requested from custom_alloc_fn */
+unsigned int g_alloc_count; /* number of calls made to custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global allocation counters.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_size = 0;
+    g_alloc_count = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of calls made to it and allocates with
+ * \c malloc() .
+ *
+ * @param[in] size Number of bytes to allocate.
+ *
+ * @return The allocated address.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    g_alloc_size = size;
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases with
+ * \c free() .
+ *
+ * @param[in] ptr Address to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/* Allocation functions shared by every queue under test. */
+static const ezq_allocator g_allocator = { custom_alloc_fn, custom_free_fn };
+
+/*!
+ * @brief Tests that \c ezq_cinit initializes a queue without allocating.
+ */
+static void
+test__ezq_cinit__standard__success(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NULL(queue.p_slots);
+    TEST_ASSERT_EQUAL_PTR(&g_allocator, queue.p_allocator);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_ccount(&queue, NULL));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_cinit__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_cinit fails when given no allocation functions.
+ */
+static void
+test__ezq_cinit__no_alloc_fn__failure(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cinit(&queue, 0, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_ALLOC_FN, estat);
+} /* test__ezq_cinit__no_alloc_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_cpush allocates the ring on the first push and
+ * doubles it once it is full, keeping a wrapped ring's items in order.
+ */
+static void
+test__ezq_cpush__grow_wrapped__success(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cpush(&queue, (void *)1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(1, g_alloc_count);
+    TEST_ASSERT_EQUAL_UINT(
+        EZQ_COMPACT_MIN_SLOTS * sizeof(void *),
+        g_alloc_size
+    );
+    TEST_ASSERT_EQUAL_UINT32(EZQ_COMPACT_MIN_SLOTS, queue.slot_capacity);
+
+    estat = ezq_cpop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i <= EZQ_COMPACT_MIN_SLOTS; ++i)
+    {
+        estat = ezq_cpush(&queue, (unsigned char *)0 + 2 + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT(2, g_alloc_count);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+    TEST_ASSERT_EQUAL_UINT32(2 * EZQ_COMPACT_MIN_SLOTS, queue.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_COMPACT_MIN_SLOTS + 1,
+        ezq_ccount(&queue, NULL)
+    );
+    for (i = 0; i <= EZQ_COMPACT_MIN_SLOTS; ++i)
+    {
+        estat = ezq_cpop(&queue, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((unsigned char *)0 + 2 + i, p_item);
+    }
+
+    estat = ezq_cdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+} /* test__ezq_cpush__grow_wrapped__success */
+
+/*!
+ * @brief Tests that \c ezq_cpush fails once the queue's capacity has been
+ * reached.
+ */
+static void
+test__ezq_cpush__capacity_full__failure(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 1, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_cpush(&queue, (void *)1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cpush(&queue, (void *)2);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_ccount(&queue, NULL));
+
+    estat = ezq_cdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_cpush__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_cpop halves a grown ring once no more than a
+ * quarter of it is in use.
+ */
+static void
+test__ezq_cpop__shrink__success(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_item = NULL;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i <= EZQ_COMPACT_MIN_SLOTS; ++i)
+    {
+        estat = ezq_cpush(&queue, (unsigned char *)0 + 1 + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2 * EZQ_COMPACT_MIN_SLOTS, queue.slot_capacity);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i <= EZQ_COMPACT_MIN_SLOTS; ++i)
+    {
+        estat = ezq_cpop(&queue, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((unsigned char *)0 + 1 + i, p_item);
+    }
+    TEST_ASSERT_EQUAL_UINT32(EZQ_COMPACT_MIN_SLOTS, queue.slot_capacity);
+    TEST_ASSERT_NOT_NULL(queue.p_slots);
+
+    estat = ezq_cdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+} /* test__ezq_cpop__shrink__success */
+
+/*!
+ * @brief Tests that \c ezq_cpop fails when the queue is empty.
+ */
+static void
+test__ezq_cpop__empty__failure(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_item = (void *)0xAA;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cpop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xAA, p_item);
+} /* test__ezq_cpop__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_ctrim releases the ring of an empty queue.
+ */
+static void
+test__ezq_ctrim__empty__success(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_cpush(&queue, (void *)1);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_cpop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ctrim(&queue);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NULL(queue.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(&g_allocator, queue.p_allocator);
+} /* test__ezq_ctrim__empty__success */
+
+/*!
+ * @brief Tests that \c ezq_cdestroy invokes the cleanup function on every
+ * remaining item and releases the ring.
+ */
+static void
+test__ezq_cdestroy__non_null_cleanup_fn__success(void)
+{
+    ezq_cqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_cinit(&queue, 0, &g_allocator);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < 3; ++i)
+    {
+        estat = ezq_cpush(&queue, (unsigned char *)0 + 1 + i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_cdestroy(&queue, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+    TEST_ASSERT_NULL(queue.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.count);
+} /* test__ezq_cdestroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue compact queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_cinit */
+    RUN_TEST(test__ezq_cinit__standard__success);
+    RUN_TEST(test__ezq_cinit__no_alloc_fn__failure);
+
+    /* ezq_cpush */
+    RUN_TEST(test__ezq_cpush__grow_wrapped__success);
+    RUN_TEST(test__ezq_cpush__capacity_full__failure);
+
+    /* ezq_cpop */
+    RUN_TEST(test__ezq_cpop__shrink__success);
+    RUN_TEST(test__ezq_cpop__empty__failure);
+
+    /* ezq_ctrim */
+    RUN_TEST(test__ezq_ctrim__empty__success);
+
+    /* ezq_cdestroy */
+    RUN_TEST(test__ezq_cdestroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
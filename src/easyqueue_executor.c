@@ -0,0 +1,855 @@
+#define _GNU_SOURCE
+#include <assert.h>
+#include <sched.h>
+#include "easyqueue_executor.h"
+
+/* Worker whose thread is the calling thread, if any; lets tasks submitted
+ * from a running task go straight onto that worker's deque.
+ */
+static _Thread_local struct ezq_executor_worker * g_p_current_worker = NULL;
+
+/*!
+ * @brief Initializes the mutex and condition variables of an executor,
+ * leaving none of them initialized if any fails.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor whose
+ * synchronization objects to initialize.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if all were initialized, otherwise
+ * \c EZQ_STATUS_UNKNOWN .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_executor_sync_init(ezq_executor * const p_executor);
+
+/*!
+ * @brief Asks the workers to exit once they finish their current tasks and
+ * waits for the first \c started of them to do so.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor to stop.
+ * @param[in] started Number of workers whose threads were started.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_stop(ezq_executor * const p_executor, const unsigned int started);
+
+/*!
+ * @brief Destroys the deques of the first \c deques workers, the
+ * submission queue and the synchronization objects of an executor.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor to release.
+ * @param[in] deques Number of workers whose deques were initialized.
+ * @param[in] item_cleanup_fn Optional function to invoke on each task that
+ * remains queued.
+ * @param[in] p_args Optional argument passed to \c item_cleanup_fn .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_release(
+    ezq_executor * const p_executor,
+    const unsigned int deques,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+);
+
+/*!
+ * @brief Runs tasks on behalf of a worker until the executor stops.
+ *
+ * @param[in,out] p_arg Address of the \c ezq_executor_worker to run.
+ *
+ * @return \c NULL
+ */
+static void *
+ezq_executor_run(void *p_arg);
+
+/*!
+ * @brief Finds the next task for a worker to run: the newest task of its
+ * own deque, else a batch from the submission queue, else half of the
+ * tasks of another worker. Any further tasks of a batch are placed on the
+ * worker's deque.
+ *
+ * @param[in,out] p_worker Address of the worker looking for a task.
+ *
+ * @return The address of the task to run, or \c NULL if none was found.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds, and may only be
+ * called from the worker's own thread.
+ */
+static struct ezq_task * EZQ_API
+ezq_executor_find(struct ezq_executor_worker * const p_worker);
+
+/*!
+ * @brief Runs a task and counts it as finished.
+ *
+ * @param[in,out] p_worker Address of the worker running the task.
+ * @param[in,out] p_task Address of the task to run.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_execute(
+    struct ezq_executor_worker * const p_worker,
+    struct ezq_task * const p_task
+);
+
+/*!
+ * @brief Parks a worker until a task is submitted or the executor stops,
+ * unless either has already happened.
+ *
+ * @param[in,out] p_worker Address of the worker to park.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_park(struct ezq_executor_worker * const p_worker);
+
+/*!
+ * @brief Wakes up to \c count parked workers, only taking the lock if any
+ * worker is parked.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor whose workers
+ * to wake.
+ * @param[in] count Number of tasks just made available.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_notify(ezq_executor * const p_executor, const unsigned int count);
+
+/*!
+ * @brief Counts \c count pending tasks as finished, waking any threads
+ * draining the executor if none remain.
+ *
+ * @param[in,out] p_executor Address of the \c ezq_executor whose tasks
+ * finished.
+ * @param[in] count Number of tasks that finished.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_executor_finish(ezq_executor * const p_executor, const unsigned int count);
+
+/*!
+ * @brief Adds to a counter that only the calling thread writes, without an
+ * atomic read-modify-write operation.
+ *
+ * @param[in,out] p_counter Address of the counter to add to.
+ * @param[in] count Amount to add.
+ */
+static inline void
+ezq_executor_bump(atomic_ulong * const p_counter, const unsigned long count)
+{
+    atomic_store_explicit(
+        p_counter,
+        atomic_load_explicit(p_counter, memory_order_relaxed) + count,
+        memory_order_relaxed
+    );
+} /* ezq_executor_bump */
+
+ezq_status EZQ_API
+ezq_executor_init(
+    ezq_executor * const p_executor,
+    struct ezq_executor_worker * const p_workers,
+    const unsigned int worker_count,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_executor_worker * p_worker = NULL;
+    unsigned int i = 0;
+
+    if (NULL == p_executor || NULL == p_workers)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == worker_count)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    estat = ezq_mpmc_init(
+        &p_executor->submissions,
+        capacity,
+        alloc_fn,
+        free_fn
+    );
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+    estat = ezq_executor_sync_init(p_executor);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        (void)ezq_mpmc_destroy(&p_executor->submissions, NULL, NULL);
+        goto done;
+    }
+
+    p_executor->p_workers = p_workers;
+    p_executor->worker_count = worker_count;
+    atomic_init(&p_executor->pending, 0);
+    atomic_init(&p_executor->sleepers, 0);
+    atomic_init(&p_executor->drainers, 0);
+    atomic_init(&p_executor->stopping, 0);
+
+    for (i = 0; i < worker_count; ++i)
+    {
+        p_worker = &p_workers[i];
+        estat = ezq_wsdeque_init(
+            &p_worker->deque,
+            capacity,
+            alloc_fn,
+            free_fn
+        );
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            ezq_executor_release(p_executor, i, NULL, NULL);
+            goto done;
+        }
+        p_worker->p_executor = p_executor;
+        p_worker->index = i;
+        p_worker->victim = 1;
+        atomic_init(&p_worker->executed, 0);
+        atomic_init(&p_worker->injected, 0);
+        atomic_init(&p_worker->stolen, 0);
+        atomic_init(&p_worker->parks, 0);
+    }
+
+    /* Workers may steal from one another as soon as they start, so every
+     * deque is initialized before the first thread is created.
+     * */
+    for (i = 0; i < worker_count; ++i)
+    {
+        if (
+            0 != pthread_create(
+                &p_workers[i].thread,
+                NULL,
+                ezq_executor_run,
+                &p_workers[i]
+            )
+        )
+        {
+            ezq_executor_stop(p_executor, i);
+            ezq_executor_release(p_executor, worker_count, NULL, NULL);
+            estat = EZQ_STATUS_UNKNOWN;
+            goto done;
+        }
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_executor_init */
+
+ezq_status EZQ_API
+ezq_executor_set_affinity(
+    ezq_executor * const p_executor,
+    const unsigned int worker,
+    const unsigned int cpu
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+#if defined(__linux__)
+    cpu_set_t cpus;
+#endif /* __linux__ */
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (worker >= p_executor->worker_count)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if (
+        0 != pthread_setaffinity_np(
+            p_executor->p_workers[worker].thread,
+            sizeof(cpus),
+            &cpus
+        )
+    )
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+    estat = EZQ_STATUS_SUCCESS;
+#else
+    (void)cpu;
+    estat = EZQ_STATUS_UNKNOWN;
+#endif /* __linux__ */
+
+done:
+    return estat;
+} /* ezq_executor_set_affinity */
+
+ezq_status EZQ_API
+ezq_executor_submit(
+    ezq_executor * const p_executor,
+    struct ezq_task * const p_task
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    (void)ezq_executor_submit_batch(p_executor, &p_task, 1, &estat);
+
+    return estat;
+} /* ezq_executor_submit */
+
+unsigned int EZQ_API
+ezq_executor_submit_batch(
+    ezq_executor * const p_executor,
+    struct ezq_task * const * const pp_tasks,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_status push_estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_executor_worker * p_worker = g_p_current_worker;
+    void * items[EZQ_EXECUTOR_BATCH];
+    unsigned int limit = count;
+    unsigned int chunk = 0;
+    unsigned int pushed = 0;
+    unsigned int submitted = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_tasks && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    for (i = 0; i < limit; ++i)
+    {
+        if (NULL == pp_tasks[i] || NULL == pp_tasks[i]->run_fn)
+        {
+            limit = i;
+            estat = EZQ_STATUS_NULL_ITEM;
+            break;
+        }
+    }
+    if (0 == limit)
+    {
+        goto done;
+    }
+
+    /* Tasks are counted as pending before they are queued, so that a
+     * worker finishing one can never take the count below zero.
+     * */
+    (void)atomic_fetch_add(&p_executor->pending, limit);
+
+    if (NULL != p_worker && p_executor == p_worker->p_executor)
+    {
+        for (; submitted < limit; ++submitted)
+        {
+            estat = ezq_wsdeque_push(&p_worker->deque, pp_tasks[submitted]);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                estat = EZQ_STATUS_SUCCESS;
+                break;
+            }
+        }
+    }
+
+    while (submitted < limit)
+    {
+        chunk = limit - submitted < EZQ_EXECUTOR_BATCH
+            ? limit - submitted
+            : EZQ_EXECUTOR_BATCH;
+        for (i = 0; i < chunk; ++i)
+        {
+            items[i] = pp_tasks[submitted + i];
+        }
+        pushed = ezq_mpmc_push_n(
+            &p_executor->submissions,
+            items,
+            chunk,
+            &push_estat
+        );
+        submitted += pushed;
+        if (EZQ_STATUS_SUCCESS != push_estat)
+        {
+            estat = push_estat;
+            break;
+        }
+    }
+
+    if (submitted < limit)
+    {
+        ezq_executor_finish(p_executor, limit - submitted);
+    }
+    if (submitted > 0)
+    {
+        ezq_executor_notify(p_executor, submitted);
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return submitted;
+} /* ezq_executor_submit_batch */
+
+unsigned int EZQ_API
+ezq_executor_pending(
+    const ezq_executor * const p_executor,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int pending = 0;
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    pending = atomic_load(&p_executor->pending);
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return pending;
+} /* ezq_executor_pending */
+
+ezq_status EZQ_API
+ezq_executor_drain(ezq_executor * const p_executor)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* Advertising this thread before reading the pending count pairs with
+     * the count being lowered before the drainers are read in
+     * ezq_executor_finish(): either the finishing worker sees this thread
+     * and signals it, or this thread sees that no tasks remain.
+     * */
+    (void)pthread_mutex_lock(&p_executor->lock);
+    (void)atomic_fetch_add(&p_executor->drainers, 1);
+    while (atomic_load(&p_executor->pending) > 0)
+    {
+        (void)pthread_cond_wait(&p_executor->drained, &p_executor->lock);
+    }
+    (void)atomic_fetch_sub(&p_executor->drainers, 1);
+    (void)pthread_mutex_unlock(&p_executor->lock);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_executor_drain */
+
+ezq_status EZQ_API
+ezq_executor_stats(
+    const ezq_executor * const p_executor,
+    const unsigned int worker,
+    struct ezq_executor_stats * const p_stats
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    const struct ezq_executor_worker * p_worker = NULL;
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_stats)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (worker >= p_executor->worker_count)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    p_worker = &p_executor->p_workers[worker];
+    p_stats->executed = atomic_load_explicit(
+        &p_worker->executed,
+        memory_order_relaxed
+    );
+    p_stats->injected = atomic_load_explicit(
+        &p_worker->injected,
+        memory_order_relaxed
+    );
+    p_stats->stolen = atomic_load_explicit(
+        &p_worker->stolen,
+        memory_order_relaxed
+    );
+    p_stats->parks = atomic_load_explicit(
+        &p_worker->parks,
+        memory_order_relaxed
+    );
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_executor_stats */
+
+ezq_status EZQ_API
+ezq_executor_destroy(
+    ezq_executor * const p_executor,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_executor)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    if (NULL != p_executor->p_workers)
+    {
+        ezq_executor_stop(p_executor, p_executor->worker_count);
+        ezq_executor_release(
+            p_executor,
+            p_executor->worker_count,
+            item_cleanup_fn,
+            p_args
+        );
+    }
+
+    p_executor->p_workers = NULL;
+    p_executor->worker_count = 0;
+    atomic_store_explicit(&p_executor->pending, 0, memory_order_relaxed);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_executor_destroy */
+
+static ezq_status EZQ_API
+ezq_executor_sync_init(ezq_executor * const p_executor)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    assert(NULL != p_executor);
+
+    if (0 != pthread_mutex_init(&p_executor->lock, NULL))
+    {
+        goto done;
+    }
+    if (0 != pthread_cond_init(&p_executor->wake, NULL))
+    {
+        (void)pthread_mutex_destroy(&p_executor->lock);
+        goto done;
+    }
+    if (0 != pthread_cond_init(&p_executor->drained, NULL))
+    {
+        (void)pthread_cond_destroy(&p_executor->wake);
+        (void)pthread_mutex_destroy(&p_executor->lock);
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_executor_sync_init */
+
+static void EZQ_API
+ezq_executor_stop(ezq_executor * const p_executor, const unsigned int started)
+{
+    unsigned int i = 0;
+
+    assert(NULL != p_executor);
+
+    /* Parked workers re-check the flag under the lock before waiting, so
+     * setting it before broadcasting wakes every one of them.
+     * */
+    atomic_store(&p_executor->stopping, 1);
+    (void)pthread_mutex_lock(&p_executor->lock);
+    (void)pthread_cond_broadcast(&p_executor->wake);
+    (void)pthread_mutex_unlock(&p_executor->lock);
+
+    for (i = 0; i < started; ++i)
+    {
+        (void)pthread_join(p_executor->p_workers[i].thread, NULL);
+    }
+} /* ezq_executor_stop */
+
+static void EZQ_API
+ezq_executor_release(
+    ezq_executor * const p_executor,
+    const unsigned int deques,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    unsigned int i = 0;
+
+    assert(NULL != p_executor);
+
+    for (i = 0; i < deques; ++i)
+    {
+        (void)ezq_wsdeque_destroy(
+            &p_executor->p_workers[i].deque,
+            item_cleanup_fn,
+            p_args
+        );
+    }
+    (void)ezq_mpmc_destroy(&p_executor->submissions, item_cleanup_fn, p_args);
+    (void)pthread_cond_destroy(&p_executor->drained);
+    (void)pthread_cond_destroy(&p_executor->wake);
+    (void)pthread_mutex_destroy(&p_executor->lock);
+} /* ezq_executor_release */
+
+static void *
+ezq_executor_run(void *p_arg)
+{
+    struct ezq_executor_worker * const p_worker = p_arg;
+    ezq_executor * const p_executor = p_worker->p_executor;
+    struct ezq_task * p_task = NULL;
+    unsigned int idle = 0;
+
+    g_p_current_worker = p_worker;
+    while (!atomic_load_explicit(&p_executor->stopping, memory_order_acquire))
+    {
+        p_task = ezq_executor_find(p_worker);
+        if (NULL != p_task)
+        {
+            ezq_executor_execute(p_worker, p_task);
+            idle = 0;
+        }
+        else if (++idle < EZQ_EXECUTOR_SPIN_LIMIT)
+        {
+            (void)sched_yield();
+        }
+        else
+        {
+            ezq_executor_park(p_worker);
+            idle = 0;
+        }
+    }
+    g_p_current_worker = NULL;
+
+    return NULL;
+} /* ezq_executor_run */
+
+static struct ezq_task * EZQ_API
+ezq_executor_find(struct ezq_executor_worker * const p_worker)
+{
+    ezq_executor * p_executor = NULL;
+    struct ezq_executor_worker * p_victim = NULL;
+    void * tasks[EZQ_EXECUTOR_BATCH];
+    void * p_task = NULL;
+    unsigned int found = 0;
+    unsigned int victim = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_worker);
+
+    if (EZQ_STATUS_SUCCESS == ezq_wsdeque_pop(&p_worker->deque, &p_task))
+    {
+        goto done;
+    }
+
+    p_executor = p_worker->p_executor;
+    found = ezq_mpmc_pop_n(
+        &p_executor->submissions,
+        tasks,
+        EZQ_EXECUTOR_BATCH,
+        NULL
+    );
+    if (found > 0)
+    {
+        ezq_executor_bump(&p_worker->injected, found);
+    }
+    else
+    {
+        /* Keep robbing the last worker that had tasks to spare, and move
+         * on to the next one round the pool when it runs dry.
+         * */
+        for (i = 1; i < p_executor->worker_count && 0 == found; ++i)
+        {
+            victim = (p_worker->index + p_worker->victim)
+                % p_executor->worker_count;
+            p_victim = &p_executor->p_workers[victim];
+            found = ezq_wsdeque_steal_half(
+                &p_victim->deque,
+                tasks,
+                EZQ_EXECUTOR_BATCH,
+                NULL
+            );
+            if (0 == found)
+            {
+                p_worker->victim =
+                    p_worker->victim % (p_executor->worker_count - 1) + 1;
+            }
+        }
+        if (found > 0)
+        {
+            ezq_executor_bump(&p_worker->stolen, found);
+        }
+    }
+    if (0 == found)
+    {
+        goto done;
+    }
+
+    /* The rest of the batch goes on this worker's deque newest first, so
+     * that it is popped in the order it was taken and may be stolen by
+     * workers woken to share it.
+     * */
+    p_task = tasks[0];
+    for (i = found - 1; i > 0; --i)
+    {
+        if (EZQ_STATUS_SUCCESS != ezq_wsdeque_push(&p_worker->deque, tasks[i]))
+        {
+            ezq_executor_execute(p_worker, tasks[i]);
+        }
+    }
+    if (found > 1)
+    {
+        ezq_executor_notify(p_executor, found - 1);
+    }
+
+done:
+    return p_task;
+} /* ezq_executor_find */
+
+static void EZQ_API
+ezq_executor_execute(
+    struct ezq_executor_worker * const p_worker,
+    struct ezq_task * const p_task
+)
+{
+    assert(NULL != p_worker);
+    assert(NULL != p_task);
+
+    /* The task may release itself when it runs, so it is not touched
+     * afterwards.
+     * */
+    p_task->run_fn(p_task);
+    ezq_executor_bump(&p_worker->executed, 1);
+    ezq_executor_finish(p_worker->p_executor, 1);
+} /* ezq_executor_execute */
+
+static void EZQ_API
+ezq_executor_park(struct ezq_executor_worker * const p_worker)
+{
+    ezq_executor * p_executor = NULL;
+    unsigned int i = 0;
+    int idle = 1;
+
+    assert(NULL != p_worker);
+
+    p_executor = p_worker->p_executor;
+
+    /* Advertising this worker before looking for tasks one last time pairs
+     * with the fence after a task is queued in ezq_executor_notify():
+     * either the submitter sees this worker and signals it, which it can
+     * only do once this worker is waiting, or this worker sees the task.
+     * */
+    (void)pthread_mutex_lock(&p_executor->lock);
+    (void)atomic_fetch_add(&p_executor->sleepers, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load(&p_executor->stopping)
+        || ezq_mpmc_count(&p_executor->submissions, NULL) > 0)
+    {
+        idle = 0;
+    }
+    for (i = 0; i < p_executor->worker_count && idle; ++i)
+    {
+        if (ezq_wsdeque_count(&p_executor->p_workers[i].deque, NULL) > 0)
+        {
+            idle = 0;
+        }
+    }
+    if (idle)
+    {
+        ezq_executor_bump(&p_worker->parks, 1);
+        (void)pthread_cond_wait(&p_executor->wake, &p_executor->lock);
+    }
+
+    (void)atomic_fetch_sub(&p_executor->sleepers, 1);
+    (void)pthread_mutex_unlock(&p_executor->lock);
+} /* ezq_executor_park */
+
+static void EZQ_API
+ezq_executor_notify(ezq_executor * const p_executor, const unsigned int count)
+{
+    assert(NULL != p_executor);
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (0 == atomic_load(&p_executor->sleepers))
+    {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&p_executor->lock);
+    if (count > 1)
+    {
+        (void)pthread_cond_broadcast(&p_executor->wake);
+    }
+    else
+    {
+        (void)pthread_cond_signal(&p_executor->wake);
+    }
+    (void)pthread_mutex_unlock(&p_executor->lock);
+} /* ezq_executor_notify */
+
+static void EZQ_API
+ezq_executor_finish(ezq_executor * const p_executor, const unsigned int count)
+{
+    assert(NULL != p_executor);
+
+    if (count != atomic_fetch_sub(&p_executor->pending, count)
+        || 0 == atomic_load(&p_executor->drainers))
+    {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&p_executor->lock);
+    (void)pthread_cond_broadcast(&p_executor->drained);
+    (void)pthread_mutex_unlock(&p_executor->lock);
+} /* ezq_executor_finish */
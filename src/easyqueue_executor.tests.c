@@ -0,0 +1,501 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_executor.h"
+
+#define TEST_WORKER_COUNT (4)
+#define TEST_TASK_COUNT (1000)
+#define TEST_SPAWN_DEPTH (12)
+
+/*!
+ * @struct test_task
+ * @brief Structure wrapping an \c ezq_task as the unit tests' own tasks
+ * do.
+ */
+struct test_task
+{
+    struct ezq_task task; /* task submitted to the executor */
+    unsigned int depth; /* levels of tasks still to spawn below this one */
+};
+
+ezq_executor g_executor; /* executor under test */
+struct ezq_executor_worker g_workers[TEST_WORKER_COUNT]; /* its workers */
+struct test_task g_tasks[TEST_TASK_COUNT]; /* tasks handed to it */
+atomic_uint g_run_count; /* number of tasks that have run */
+atomic_int g_blocking; /* non-zero while block_task_fn is running */
+atomic_int g_release; /* non-zero once block_task_fn may return */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global task state.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    unsigned int i = 0;
+
+    for (i = 0; i < TEST_TASK_COUNT; ++i)
+    {
+        g_tasks[i].task.run_fn = NULL;
+        g_tasks[i].depth = 0;
+    }
+    atomic_init(&g_run_count, 0);
+    atomic_init(&g_blocking, 0);
+    atomic_init(&g_release, 0);
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of tasks run.
+ *
+ * @param[in] p_task UNUSED
+ */
+static void
+count_task_fn(struct ezq_task * const p_task)
+{
+    (void)p_task;
+    atomic_fetch_add(&g_run_count, 1);
+}
+
+/*!
+ * @brief Occupies its worker until \c g_release is set or the executor
+ * starts stopping.
+ *
+ * @param[in] p_task UNUSED
+ */
+static void
+block_task_fn(struct ezq_task * const p_task)
+{
+    (void)p_task;
+    atomic_store(&g_blocking, 1);
+    while (!atomic_load(&g_release) && !atomic_load(&g_executor.stopping))
+    {
+        sched_yield();
+    }
+    atomic_fetch_add(&g_run_count, 1);
+}
+
+/*!
+ * @brief Submits two child tasks one level shallower, unless the task is
+ * a leaf, and then releases the task. A child that cannot be submitted is
+ * simply never counted as run.
+ *
+ * @param[in] p_task Address of the \c ezq_task of a \c malloc allocated
+ * \c test_task .
+ */
+static void
+spawn_task_fn(struct ezq_task * const p_task)
+{
+    struct test_task *p_test_task =
+        EZQ_CONTAINER_OF(p_task, struct test_task, task);
+    struct test_task *p_child = NULL;
+    unsigned int i = 0;
+
+    for (i = 0; i < 2 && p_test_task->depth > 0; ++i)
+    {
+        p_child = malloc(sizeof(*p_child));
+        if (NULL == p_child)
+        {
+            continue;
+        }
+        p_child->task.run_fn = spawn_task_fn;
+        p_child->depth = p_test_task->depth - 1;
+        if (EZQ_STATUS_SUCCESS
+            != ezq_executor_submit(&g_executor, &p_child->task))
+        {
+            free(p_child);
+        }
+    }
+    atomic_fetch_add(&g_run_count, 1);
+    free(p_test_task);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Submits a blocking task to a single worker executor and waits for
+ * the worker to start running it.
+ */
+static void
+start_blocked_executor(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    estat = ezq_executor_init(&g_executor, g_workers, 1, 2, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_tasks[0].task.run_fn = block_task_fn;
+    estat = ezq_executor_submit(&g_executor, &g_tasks[0].task);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    while (!atomic_load(&g_blocking))
+    {
+        sched_yield();
+    }
+}
+
+/*!
+ * @brief Tests that \c ezq_executor_init refuses to start an executor
+ * without workers.
+ */
+static void
+test__ezq_executor_init__zero_workers__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_init(&g_executor, g_workers, 0, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+    estat = ezq_executor_init(&g_executor, NULL, 1, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_executor_init__zero_workers__failure */
+
+/*!
+ * @brief Tests that every task submitted with \c ezq_executor_submit runs
+ * exactly once before \c ezq_executor_drain returns, and that the workers'
+ * counters account for each of them.
+ */
+static void
+test__ezq_executor_submit__standard__success(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_executor_stats stats = { 0 };
+    unsigned long executed = 0;
+    unsigned long injected = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_executor_init(
+        &g_executor,
+        g_workers,
+        TEST_WORKER_COUNT,
+        64,
+        malloc,
+        free
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_TASK_COUNT; ++i)
+    {
+        g_tasks[i].task.run_fn = count_task_fn;
+        do
+        {
+            estat = ezq_executor_submit(&g_executor, &g_tasks[i].task);
+        } while (EZQ_STATUS_FULL == estat);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    estat = ezq_executor_drain(&g_executor);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(TEST_TASK_COUNT, atomic_load(&g_run_count));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_executor_pending(&g_executor, NULL));
+
+    for (i = 0; i < TEST_WORKER_COUNT; ++i)
+    {
+        estat = ezq_executor_stats(&g_executor, i, &stats);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        executed += stats.executed;
+        injected += stats.injected;
+    }
+    TEST_ASSERT_EQUAL_UINT32(TEST_TASK_COUNT, executed);
+    TEST_ASSERT_EQUAL_UINT32(TEST_TASK_COUNT, injected);
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_submit__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_executor_submit refuses a task without a
+ * function to run.
+ */
+static void
+test__ezq_executor_submit__null_run_fn__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_executor_init(&g_executor, g_workers, 1, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_submit(&g_executor, &g_tasks[0].task);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    estat = ezq_executor_submit(&g_executor, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_executor_pending(&g_executor, NULL));
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_submit__null_run_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_executor_submit fails once the submission queue
+ * is full, and that the refused task is not counted as pending.
+ */
+static void
+test__ezq_executor_submit__full__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Set any initial state. The only worker is kept busy while the
+     * submission queue fills up.
+     * */
+    start_blocked_executor();
+    for (i = 1; i <= 2; ++i)
+    {
+        g_tasks[i].task.run_fn = count_task_fn;
+        estat = ezq_executor_submit(&g_executor, &g_tasks[i].task);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    g_tasks[3].task.run_fn = count_task_fn;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_submit(&g_executor, &g_tasks[3].task);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(3, ezq_executor_pending(&g_executor, NULL));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    atomic_store(&g_release, 1);
+    estat = ezq_executor_drain(&g_executor);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(3, atomic_load(&g_run_count));
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_submit__full__failure */
+
+/*!
+ * @brief Tests that tasks submitted by running tasks are spread across the
+ * workers and all run before \c ezq_executor_drain returns.
+ */
+static void
+test__ezq_executor_submit__nested__success(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_executor_stats stats = { 0 };
+    struct test_task *p_root = NULL;
+    unsigned long executed = 0;
+    unsigned long injected = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_executor_init(
+        &g_executor,
+        g_workers,
+        TEST_WORKER_COUNT,
+        16,
+        malloc,
+        free
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    p_root = malloc(sizeof(*p_root));
+    TEST_ASSERT_NOT_NULL(p_root);
+    p_root->task.run_fn = spawn_task_fn;
+    p_root->depth = TEST_SPAWN_DEPTH;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_submit(&g_executor, &p_root->task);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_executor_drain(&g_executor);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        (1u << (TEST_SPAWN_DEPTH + 1)) - 1,
+        atomic_load(&g_run_count)
+    );
+
+    /* Validate that nothing else was unexpectedly modified. Only the root
+     * task passed through the submission queue.
+     * */
+    for (i = 0; i < TEST_WORKER_COUNT; ++i)
+    {
+        estat = ezq_executor_stats(&g_executor, i, &stats);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        executed += stats.executed;
+        injected += stats.injected;
+    }
+    TEST_ASSERT_EQUAL_UINT32((1u << (TEST_SPAWN_DEPTH + 1)) - 1, executed);
+    TEST_ASSERT_EQUAL_UINT32(1, injected);
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_submit__nested__success */
+
+/*!
+ * @brief Tests that \c ezq_executor_submit_batch stops submitting at the
+ * first task without a function to run.
+ */
+static void
+test__ezq_executor_submit_batch__null_run_fn__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_task *tasks[3] = { NULL };
+    unsigned int submitted = 0;
+
+    /* Set any initial state. */
+    estat = ezq_executor_init(&g_executor, g_workers, 2, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_tasks[0].task.run_fn = count_task_fn;
+    g_tasks[2].task.run_fn = count_task_fn;
+    tasks[0] = &g_tasks[0].task;
+    tasks[1] = &g_tasks[1].task;
+    tasks[2] = &g_tasks[2].task;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    submitted = ezq_executor_submit_batch(&g_executor, tasks, 3, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, submitted);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_executor_drain(&g_executor);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&g_run_count));
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_submit_batch__null_run_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_executor_set_affinity pins a worker to a CPU the
+ * process may run on, and refuses workers that do not exist.
+ */
+static void
+test__ezq_executor_set_affinity__standard__success(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    cpu_set_t allowed;
+    cpu_set_t pinned;
+    unsigned int cpu = 0;
+
+    /* Set any initial state. */
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        sched_getaffinity(0, sizeof(allowed), &allowed)
+    );
+    while (!CPU_ISSET(cpu, &allowed))
+    {
+        ++cpu;
+    }
+    estat = ezq_executor_init(&g_executor, g_workers, 2, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_set_affinity(&g_executor, 1, cpu);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        pthread_getaffinity_np(g_workers[1].thread, sizeof(pinned), &pinned)
+    );
+    TEST_ASSERT_EQUAL_INT(1, CPU_COUNT(&pinned));
+    TEST_ASSERT_TRUE(CPU_ISSET(cpu, &pinned));
+
+    estat = ezq_executor_set_affinity(&g_executor, 2, cpu);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_set_affinity__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_executor_stats refuses workers that do not
+ * exist.
+ */
+static void
+test__ezq_executor_stats__invalid_worker__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_executor_stats stats = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+    /* Set any initial state. */
+    estat = ezq_executor_init(&g_executor, g_workers, 1, 16, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_stats(&g_executor, 1, &stats);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0xFF, stats.executed);
+
+    estat = ezq_executor_destroy(&g_executor, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_executor_stats__invalid_worker__failure */
+
+/*!
+ * @brief Tests that \c ezq_executor_destroy lets the running task finish
+ * and passes every task that never ran to the cleanup function.
+ */
+static void
+test__ezq_executor_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    start_blocked_executor();
+    for (i = 1; i <= 2; ++i)
+    {
+        g_tasks[i].task.run_fn = count_task_fn;
+        estat = ezq_executor_submit(&g_executor, &g_tasks[i].task);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_executor_destroy(&g_executor, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&g_run_count));
+    TEST_ASSERT_EQUAL_UINT(2, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_executor_pending(&g_executor, NULL));
+} /* test__ezq_executor_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue executor unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_executor_init */
+    RUN_TEST(test__ezq_executor_init__zero_workers__failure);
+
+    /* ezq_executor_submit / ezq_executor_drain */
+    RUN_TEST(test__ezq_executor_submit__standard__success);
+    RUN_TEST(test__ezq_executor_submit__null_run_fn__failure);
+    RUN_TEST(test__ezq_executor_submit__full__failure);
+    RUN_TEST(test__ezq_executor_submit__nested__success);
+
+    /* ezq_executor_submit_batch */
+    RUN_TEST(test__ezq_executor_submit_batch__null_run_fn__failure);
+
+    /* ezq_executor_set_affinity / ezq_executor_stats */
+    RUN_TEST(test__ezq_executor_set_affinity__standard__success);
+    RUN_TEST(test__ezq_executor_stats__invalid_worker__failure);
+
+    /* ezq_executor_destroy */
+    RUN_TEST(test__ezq_executor_destroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
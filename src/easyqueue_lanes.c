@@ -0,0 +1,302 @@
+#include <assert.h>
+#include "easyqueue_lanes.h"
+
+#ifndef NULL
+ #define NULL ((void *)0)
+#endif /* NULL */
+
+/* Gets the bit of a lane within its word of the occupancy bitmap. Lanes are
+ * assigned from the most significant of the low 32 bits down, so that the
+ * most urgent non-empty lane is found by counting leading zeros.
+ */
+#define EZQ_LANE_BIT(lane) \
+    (0x80000000UL >> ((lane) % EZQ_LANE_WORD_BITS))
+
+/*!
+ * @brief Counts the leading zeros of the low 32 bits of a bitmap word.
+ *
+ * @param[in] word Bitmap word to count the leading zeros of. Must have at
+ * least one of its low 32 bits set.
+ *
+ * @return The number of zeros above the most significant set bit of the low
+ * 32 bits of \c word .
+ */
+static unsigned int EZQ_API
+ezq_lclz_unsafe(const unsigned long word);
+
+/*!
+ * @brief Finds the most urgent lane of a queue holding any items.
+ *
+ * @param[in] p_queue Address of an \c ezq_lqueue to search. Must hold at
+ * least one item.
+ *
+ * @return The index of the lowest non-empty lane.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static unsigned int EZQ_API
+ezq_lfirst_unsafe(const ezq_lqueue * const p_queue);
+
+ezq_status EZQ_API
+ezq_linit(
+    ezq_lqueue * const p_queue,
+    ezq_queue * const p_lanes,
+    const unsigned int lane_count,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue || NULL == p_lanes)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (lane_count < 1 || lane_count > EZQ_LANES_MAX)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    for (i = 0; i < lane_count; ++i)
+    {
+        estat = ezq_init(&p_lanes[i], 0, alloc_fn, free_fn);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+    for (i = 0; i < EZQ_LANE_WORDS; ++i)
+    {
+        p_queue->occupied[i] = 0;
+    }
+
+    p_queue->p_lanes = p_lanes;
+    p_queue->lane_count = lane_count;
+    p_queue->count = 0;
+    p_queue->capacity = capacity;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_linit */
+
+ezq_status EZQ_API
+ezq_lpush(
+    ezq_lqueue * const p_queue,
+    void * const p_item,
+    const unsigned int lane
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int index = lane;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+    if (p_queue->capacity > 0 && p_queue->count >= p_queue->capacity)
+    {
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    if (index >= p_queue->lane_count)
+    {
+        index = p_queue->lane_count - 1;
+    }
+    estat = ezq_push(&p_queue->p_lanes[index], p_item);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    p_queue->occupied[index / EZQ_LANE_WORD_BITS] |= EZQ_LANE_BIT(index);
+    ++p_queue->count;
+
+done:
+    return estat;
+} /* ezq_lpush */
+
+ezq_status EZQ_API
+ezq_lpop(
+    ezq_lqueue * const p_queue,
+    void ** const pp_item,
+    unsigned int * const p_lane
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int index = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    index = ezq_lfirst_unsafe(p_queue);
+    estat = ezq_pop(&p_queue->p_lanes[index], pp_item);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    if (0 == ezq_count(&p_queue->p_lanes[index], NULL))
+    {
+        p_queue->occupied[index / EZQ_LANE_WORD_BITS] &=
+            ~EZQ_LANE_BIT(index);
+    }
+    --p_queue->count;
+    if (NULL != p_lane)
+    {
+        *p_lane = index;
+    }
+
+done:
+    return estat;
+} /* ezq_lpop */
+
+unsigned int EZQ_API
+ezq_lcount(const ezq_lqueue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    count = p_queue->count;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_lcount */
+
+ezq_status EZQ_API
+ezq_ldestroy(
+    ezq_lqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    for (i = 0; i < p_queue->lane_count; ++i)
+    {
+        estat = ezq_destroy(&p_queue->p_lanes[i], item_cleanup_fn, p_args);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+    for (i = 0; i < EZQ_LANE_WORDS; ++i)
+    {
+        p_queue->occupied[i] = 0;
+    }
+
+    p_queue->p_lanes = NULL;
+    p_queue->lane_count = 0;
+    p_queue->count = 0;
+    p_queue->capacity = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ldestroy */
+
+static unsigned int EZQ_API
+ezq_lclz_unsafe(const unsigned long word)
+{
+#if defined(__GNUC__)
+    assert(0 != (word & 0xFFFFFFFFUL));
+
+    return (unsigned int)__builtin_clzl(word & 0xFFFFFFFFUL)
+        - (unsigned int)(sizeof(word) * 8 - EZQ_LANE_WORD_BITS);
+#else
+    unsigned int zeros = 0;
+    unsigned long bits = word & 0xFFFFFFFFUL;
+
+    assert(0 != bits);
+
+    /* Halve the window in which the most significant set bit lies. */
+    if (0 == (bits & 0xFFFF0000UL))
+    {
+        zeros += 16;
+        bits <<= 16;
+    }
+    if (0 == (bits & 0xFF000000UL))
+    {
+        zeros += 8;
+        bits <<= 8;
+    }
+    if (0 == (bits & 0xF0000000UL))
+    {
+        zeros += 4;
+        bits <<= 4;
+    }
+    if (0 == (bits & 0xC0000000UL))
+    {
+        zeros += 2;
+        bits <<= 2;
+    }
+    if (0 == (bits & 0x80000000UL))
+    {
+        zeros += 1;
+    }
+
+    return zeros;
+#endif /* __GNUC__ */
+} /* ezq_lclz_unsafe */
+
+static unsigned int EZQ_API
+ezq_lfirst_unsafe(const ezq_lqueue * const p_queue)
+{
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+    assert(p_queue->count > 0);
+
+    while (0 == p_queue->occupied[i])
+    {
+        ++i;
+        assert(i < EZQ_LANE_WORDS);
+    }
+
+    return i * EZQ_LANE_WORD_BITS + ezq_lclz_unsafe(p_queue->occupied[i]);
+} /* ezq_lfirst_unsafe */
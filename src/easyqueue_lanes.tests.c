@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_lanes.h"
+
+unsigned int g_alloc_count; /* number of calls made to custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/* Lanes of the queues under test, kept off the stack given their size. */
+ezq_queue g_lanes[EZQ_LANES_MAX];
+
+/*!
+ * @brief Resets the global allocation counters.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_count = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of calls made to it and allocates with
+ * \c malloc() .
+ *
+ * @param[in] size Number of bytes to allocate.
+ *
+ * @return The allocated address.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases with
+ * \c free() .
+ *
+ * @param[in] ptr Address to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Tests that \c ezq_linit initializes a queue and each of its lanes.
+ */
+static void
+test__ezq_linit__standard__success(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_linit(
+        &queue,
+        g_lanes,
+        EZQ_LANES_MAX,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_lcount(&queue, NULL));
+    for (i = 0; i < EZQ_LANE_WORDS; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0, queue.occupied[i]);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(custom_alloc_fn, g_lanes[0].alloc_fn);
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_linit__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_linit fails when asked for more lanes than
+ * \c EZQ_LANES_MAX .
+ */
+static void
+test__ezq_linit__invalid_lane_count__failure(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_linit(
+        &queue,
+        g_lanes,
+        EZQ_LANES_MAX + 1,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+    estat = ezq_linit(&queue, g_lanes, 0, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+} /* test__ezq_linit__invalid_lane_count__failure */
+
+/*!
+ * @brief Tests that \c ezq_lpop takes items from the most urgent non-empty
+ * lane first, and in the order they were pushed within a lane.
+ */
+static void
+test__ezq_lpop__strict_priority__success(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    const unsigned int lanes[6] = {
+        EZQ_LANES_MAX - 1, EZQ_LANES_MAX / 2, 0, EZQ_LANES_MAX / 2, 0,
+        EZQ_LANES_MAX - 1
+    };
+    const unsigned int order[6] = { 2, 4, 1, 3, 0, 5 };
+    int values[6] = { 0 };
+    int *p_item = NULL;
+    unsigned int lane = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_linit(
+        &queue,
+        g_lanes,
+        EZQ_LANES_MAX,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < 6; ++i)
+    {
+        estat = ezq_lpush(&queue, &values[i], lanes[i]);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < 6; ++i)
+    {
+        estat = ezq_lpop(&queue, (void **)&p_item, &lane);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR(&values[order[i]], p_item);
+        TEST_ASSERT_EQUAL_UINT32(lanes[order[i]], lane);
+    }
+    estat = ezq_lpop(&queue, (void **)&p_item, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    for (i = 0; i < EZQ_LANE_WORDS; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0, queue.occupied[i]);
+    }
+    estat = ezq_ldestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_lpop__strict_priority__success */
+
+/*!
+ * @brief Tests that \c ezq_lpop fails on an empty queue.
+ */
+static void
+test__ezq_lpop__empty__failure(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_linit(&queue, g_lanes, 8, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_lpop(&queue, &p_item, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_NULL(p_item);
+} /* test__ezq_lpop__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_lpush places items for lanes beyond the last in
+ * the last lane.
+ */
+static void
+test__ezq_lpush__lane_out_of_range__success(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int value = 0;
+
+    /* Set any initial state. */
+    estat = ezq_linit(&queue, g_lanes, 8, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_lpush(&queue, &value, 100);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_count(&g_lanes[7], NULL));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_lcount(&queue, NULL));
+    estat = ezq_ldestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_lpush__lane_out_of_range__success */
+
+/*!
+ * @brief Tests that \c ezq_lpush fails once the lanes together hold the
+ * queue's capacity.
+ */
+static void
+test__ezq_lpush__capacity_full__failure(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int values[2] = { 0 };
+
+    /* Set any initial state. */
+    estat = ezq_linit(&queue, g_lanes, 8, 1, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_lpush(&queue, &values[0], 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_lpush(&queue, &values[1], 5);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_count(&g_lanes[5], NULL));
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_lcount(&queue, NULL));
+    estat = ezq_ldestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_lpush__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_ldestroy invokes the cleanup function on each
+ * remaining item of every lane and releases their memory.
+ */
+static void
+test__ezq_ldestroy__non_null_cleanup_fn__success(void)
+{
+    ezq_lqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int value = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_linit(&queue, g_lanes, 4, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY + 2; ++i)
+    {
+        estat = ezq_lpush(&queue, &value, i % 2);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ldestroy(&queue, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(EZQ_FIXED_BUFFER_CAPACITY + 2, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(queue.p_lanes);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.count);
+} /* test__ezq_ldestroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue lane queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_linit */
+    RUN_TEST(test__ezq_linit__standard__success);
+    RUN_TEST(test__ezq_linit__invalid_lane_count__failure);
+
+    /* ezq_lpush */
+    RUN_TEST(test__ezq_lpush__lane_out_of_range__success);
+    RUN_TEST(test__ezq_lpush__capacity_full__failure);
+
+    /* ezq_lpop */
+    RUN_TEST(test__ezq_lpop__strict_priority__success);
+    RUN_TEST(test__ezq_lpop__empty__failure);
+
+    /* ezq_ldestroy */
+    RUN_TEST(test__ezq_ldestroy__non_null_cleanup_fn__success);
+
+    (void)argc;
+    (void)argv;
+    return UNITY_END();
+} /* main */
@@ -0,0 +1,607 @@
+#include "easyqueue_mpmc.h"
+#include "easyqueue_ring.h"
+
+/*!
+ * @brief Claims up to \c max consecutive tickets from the counter pointed
+ * to by \c p_pos whose slots are ready for use.
+ *
+ * A slot is ready for ticket \c t once its sequence number equals
+ * \c t+offset , i.e. \c offset is \c 0 when claiming slots to fill and
+ * \c 1 when claiming slots to empty.
+ *
+ * @param[in,out] p_mpmc Address of the \c ezq_mpmc whose slots to claim.
+ * @param[in,out] p_pos Address of the ticket counter to claim from.
+ * @param[in] offset Distance between a ticket and the sequence number of a
+ * slot ready for it.
+ * @param[in] max Maximum number of tickets to claim. Must be non-zero.
+ * @param[in] retry Non-zero if the claim should be retried whenever another
+ * thread claims the same tickets first.
+ * @param[in] not_ready Status to report if the slot of the next ticket is
+ * not ready.
+ * @param[out] p_first Address in which to store the first claimed ticket.
+ * @param[out] p_claimed Address in which to store the number of tickets
+ * claimed.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if at least one ticket was claimed,
+ * \c not_ready if the next slot is not ready, or \c EZQ_STATUS_BUSY if
+ * \c retry is zero and another thread claimed the tickets first.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_mpmc_claim(
+    ezq_mpmc * const p_mpmc,
+    atomic_uint * const p_pos,
+    const unsigned int offset,
+    const unsigned int max,
+    const int retry,
+    const ezq_status not_ready,
+    unsigned int * const p_first,
+    unsigned int * const p_claimed
+);
+
+/*!
+ * @brief Fills the slots of \c count consecutive claimed tickets with the
+ * items of \c pp_items and publishes them to consumers.
+ *
+ * @param[in,out] p_mpmc Address of the \c ezq_mpmc whose slots to fill.
+ * @param[in] first First claimed ticket.
+ * @param[in] pp_items Array of items to place in the slots.
+ * @param[in] count Number of claimed tickets.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_mpmc_fill(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int first,
+    void * const * const pp_items,
+    const unsigned int count
+);
+
+/*!
+ * @brief Empties the slots of \c count consecutive claimed tickets into
+ * \c pp_items and hands the slots back to producers.
+ *
+ * @param[in,out] p_mpmc Address of the \c ezq_mpmc whose slots to empty.
+ * @param[in] first First claimed ticket.
+ * @param[out] pp_items Array in which to store the items of the slots.
+ * @param[in] count Number of claimed tickets.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_mpmc_empty(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int first,
+    void ** const pp_items,
+    const unsigned int count
+);
+
+ezq_status EZQ_API
+ezq_mpmc_init(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int slot_capacity = 0;
+    size_t size = 0;
+    struct ezq_mpmc_slot * p_slots = NULL;
+    unsigned int i = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == capacity || capacity > EZQ_RING_MAX_CAPACITY)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    if (NULL == alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    /* A single slot would be ready for the next producer as soon as it was
+     * filled, so at least two are needed.
+     * */
+    slot_capacity = ezq_ring_round_pow2(capacity < 2 ? 2 : capacity);
+    size = (size_t)slot_capacity * sizeof(*p_slots);
+    if (size / sizeof(*p_slots) != slot_capacity)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    p_slots = alloc_fn(size);
+    if (NULL == p_slots)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < slot_capacity; ++i)
+    {
+        atomic_init(&p_slots[i].seq, i);
+        p_slots[i].p_item = NULL;
+    }
+
+    p_mpmc->p_slots = p_slots;
+    p_mpmc->mask = slot_capacity - 1;
+    p_mpmc->free_fn = free_fn;
+    atomic_init(&p_mpmc->tail, 0);
+    atomic_init(&p_mpmc->head, 0);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpmc_init */
+
+unsigned int EZQ_API
+ezq_mpmc_capacity(const ezq_mpmc * const p_mpmc)
+{
+    return NULL == p_mpmc || NULL == p_mpmc->p_slots ? 0 : p_mpmc->mask + 1;
+} /* ezq_mpmc_capacity */
+
+unsigned int EZQ_API
+ezq_mpmc_count(const ezq_mpmc * const p_mpmc, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+    unsigned int count = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* As with ezq_spsc_count, reading the head first keeps the difference
+     * from going negative, but it may exceed the capacity.
+     * */
+    head = atomic_load_explicit(&p_mpmc->head, memory_order_acquire);
+    tail = atomic_load_explicit(&p_mpmc->tail, memory_order_acquire);
+    count = tail - head;
+    if (NULL != p_mpmc->p_slots && count > p_mpmc->mask + 1)
+    {
+        count = p_mpmc->mask + 1;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_mpmc_count */
+
+ezq_status EZQ_API
+ezq_mpmc_push(ezq_mpmc * const p_mpmc, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    (void)ezq_mpmc_push_n(p_mpmc, &p_item, 1, &estat);
+
+    return estat;
+} /* ezq_mpmc_push */
+
+ezq_status EZQ_API
+ezq_mpmc_try_push(ezq_mpmc * const p_mpmc, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int first = 0;
+    unsigned int claimed = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    estat = ezq_mpmc_claim(
+        p_mpmc,
+        &p_mpmc->tail,
+        0,
+        1,
+        0,
+        EZQ_STATUS_FULL,
+        &first,
+        &claimed
+    );
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    ezq_mpmc_fill(p_mpmc, first, &p_item, claimed);
+
+done:
+    return estat;
+} /* ezq_mpmc_try_push */
+
+unsigned int EZQ_API
+ezq_mpmc_push_n(
+    ezq_mpmc * const p_mpmc,
+    void * const * const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_status claim_estat = EZQ_STATUS_UNKNOWN;
+    unsigned int limit = count;
+    unsigned int first = 0;
+    unsigned int claimed = 0;
+    unsigned int pushed = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_items && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    for (first = 0; first < limit; ++first)
+    {
+        if (NULL == pp_items[first])
+        {
+            limit = first;
+            estat = EZQ_STATUS_NULL_ITEM;
+            break;
+        }
+    }
+
+    while (pushed < limit)
+    {
+        claim_estat = ezq_mpmc_claim(
+            p_mpmc,
+            &p_mpmc->tail,
+            0,
+            limit - pushed,
+            1,
+            EZQ_STATUS_FULL,
+            &first,
+            &claimed
+        );
+        if (EZQ_STATUS_SUCCESS != claim_estat)
+        {
+            estat = claim_estat;
+            break;
+        }
+
+        ezq_mpmc_fill(p_mpmc, first, pp_items + pushed, claimed);
+        pushed += claimed;
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return pushed;
+} /* ezq_mpmc_push_n */
+
+ezq_status EZQ_API
+ezq_mpmc_pop(ezq_mpmc * const p_mpmc, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    (void)ezq_mpmc_pop_n(p_mpmc, pp_item, 1, &estat);
+
+    return estat;
+} /* ezq_mpmc_pop */
+
+ezq_status EZQ_API
+ezq_mpmc_try_pop(ezq_mpmc * const p_mpmc, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int first = 0;
+    unsigned int claimed = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    estat = ezq_mpmc_claim(
+        p_mpmc,
+        &p_mpmc->head,
+        1,
+        1,
+        0,
+        EZQ_STATUS_EMPTY,
+        &first,
+        &claimed
+    );
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    ezq_mpmc_empty(p_mpmc, first, pp_item, claimed);
+
+done:
+    return estat;
+} /* ezq_mpmc_try_pop */
+
+unsigned int EZQ_API
+ezq_mpmc_pop_n(
+    ezq_mpmc * const p_mpmc,
+    void ** const pp_items,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_status claim_estat = EZQ_STATUS_UNKNOWN;
+    unsigned int first = 0;
+    unsigned int claimed = 0;
+    unsigned int popped = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_items && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    while (popped < count)
+    {
+        claim_estat = ezq_mpmc_claim(
+            p_mpmc,
+            &p_mpmc->head,
+            1,
+            count - popped,
+            1,
+            EZQ_STATUS_EMPTY,
+            &first,
+            &claimed
+        );
+        if (EZQ_STATUS_SUCCESS != claim_estat)
+        {
+            estat = claim_estat;
+            break;
+        }
+
+        ezq_mpmc_empty(p_mpmc, first, pp_items + popped, claimed);
+        popped += claimed;
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return popped;
+} /* ezq_mpmc_pop_n */
+
+ezq_status EZQ_API
+ezq_mpmc_destroy(
+    ezq_mpmc * const p_mpmc,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+
+    if (NULL == p_mpmc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    if (NULL != p_mpmc->p_slots)
+    {
+        head = atomic_load_explicit(&p_mpmc->head, memory_order_acquire);
+        tail = atomic_load_explicit(&p_mpmc->tail, memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            if (NULL != item_cleanup_fn)
+            {
+                item_cleanup_fn(
+                    p_mpmc->p_slots[head & p_mpmc->mask].p_item,
+                    p_args
+                );
+            }
+        }
+
+        p_mpmc->free_fn(p_mpmc->p_slots);
+    }
+
+    p_mpmc->p_slots = NULL;
+    p_mpmc->mask = 0;
+    p_mpmc->free_fn = NULL;
+    atomic_store_explicit(&p_mpmc->tail, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_mpmc->head, 0, memory_order_relaxed);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpmc_destroy */
+
+static ezq_status EZQ_API
+ezq_mpmc_claim(
+    ezq_mpmc * const p_mpmc,
+    atomic_uint * const p_pos,
+    const unsigned int offset,
+    const unsigned int max,
+    const int retry,
+    const ezq_status not_ready,
+    unsigned int * const p_first,
+    unsigned int * const p_claimed
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int pos = 0;
+    unsigned int seq = 0;
+    unsigned int ready = 0;
+
+    assert(NULL != p_mpmc);
+    assert(NULL != p_pos);
+    assert(max > 0);
+    assert(NULL != p_first);
+    assert(NULL != p_claimed);
+
+    pos = atomic_load_explicit(p_pos, memory_order_relaxed);
+    for (;;)
+    {
+        /* Count the consecutive slots from pos that are ready. The acquire
+         * loads pair with the release stores publishing each slot, so once
+         * the tickets are claimed the slots' contents are visible.
+         * */
+        for (ready = 0; ready < max; ++ready)
+        {
+            seq = atomic_load_explicit(
+                &p_mpmc->p_slots[(pos + ready) & p_mpmc->mask].seq,
+                memory_order_acquire
+            );
+            if (seq != pos + ready + offset)
+            {
+                break;
+            }
+        }
+
+        if (0 == ready)
+        {
+            /* A sequence number behind the ticket means the slot is still
+             * in use from the previous lap (when filling) or not yet filled
+             * (when emptying). One ahead of it means another thread already
+             * took the ticket, so the counter has moved on.
+             * */
+            if ((int)(seq - (pos + offset)) < 0)
+            {
+                estat = not_ready;
+                goto done;
+            }
+            if (!retry)
+            {
+                estat = EZQ_STATUS_BUSY;
+                goto done;
+            }
+            pos = atomic_load_explicit(p_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if (
+            atomic_compare_exchange_strong_explicit(
+                p_pos,
+                &pos,
+                pos + ready,
+                memory_order_relaxed,
+                memory_order_relaxed
+            )
+        )
+        {
+            break;
+        }
+        if (!retry)
+        {
+            estat = EZQ_STATUS_BUSY;
+            goto done;
+        }
+    }
+
+    *p_first = pos;
+    *p_claimed = ready;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpmc_claim */
+
+static void EZQ_API
+ezq_mpmc_fill(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int first,
+    void * const * const pp_items,
+    const unsigned int count
+)
+{
+    struct ezq_mpmc_slot * p_slot = NULL;
+    unsigned int i = 0;
+
+    assert(NULL != p_mpmc);
+    assert(NULL != pp_items);
+
+    for (i = 0; i < count; ++i)
+    {
+        p_slot = &p_mpmc->p_slots[(first + i) & p_mpmc->mask];
+        p_slot->p_item = pp_items[i];
+        atomic_store_explicit(
+            &p_slot->seq,
+            first + i + 1,
+            memory_order_release
+        );
+    }
+} /* ezq_mpmc_fill */
+
+static void EZQ_API
+ezq_mpmc_empty(
+    ezq_mpmc * const p_mpmc,
+    const unsigned int first,
+    void ** const pp_items,
+    const unsigned int count
+)
+{
+    struct ezq_mpmc_slot * p_slot = NULL;
+    unsigned int i = 0;
+
+    assert(NULL != p_mpmc);
+    assert(NULL != pp_items);
+
+    /* Each slot becomes ready for the producer holding the ticket one lap
+     * ahead of the one that filled it.
+     * */
+    for (i = 0; i < count; ++i)
+    {
+        p_slot = &p_mpmc->p_slots[(first + i) & p_mpmc->mask];
+        pp_items[i] = p_slot->p_item;
+        p_slot->p_item = NULL;
+        atomic_store_explicit(
+            &p_slot->seq,
+            first + i + p_mpmc->mask + 1,
+            memory_order_release
+        );
+    }
+} /* ezq_mpmc_empty */
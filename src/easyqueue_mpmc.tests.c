@@ -0,0 +1,547 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_mpmc.h"
+
+#define TEST_SLOT_CAPACITY (8)
+#define TEST_THREAD_COUNT (2)
+#define TEST_TRANSFER_COUNT (50000u)
+
+/* ring handed out by custom_alloc_fn */
+struct ezq_mpmc_slot g_slots[TEST_SLOT_CAPACITY];
+size_t g_alloc_size; /* size last requested from custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global dummy allocation state.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    unsigned int i = 0;
+
+    for (i = 0; i < TEST_SLOT_CAPACITY; ++i)
+    {
+        atomic_init(&g_slots[i].seq, 0xAA);
+        g_slots[i].p_item = (void *)0xAA;
+    }
+    g_alloc_size = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Returns the global dummy ring if it is large enough.
+ *
+ * @param[in] size Number of bytes requested.
+ *
+ * @return The address of the global dummy ring, or \c NULL if \c size
+ * exceeds its size.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    g_alloc_size = size;
+    return size <= sizeof(g_slots) ? g_slots : NULL;
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] ptr UNUSED
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    (void)ptr;
+    ++g_free_count;
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Pushes the values \c 1 to \c TEST_TRANSFER_COUNT onto the passed
+ * queue, alternating between single and batched pushes and yielding
+ * whenever the queue is full.
+ *
+ * @param[in,out] p_arg Address of an \c ezq_mpmc to push onto.
+ *
+ * @return \c NULL
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    ezq_mpmc *p_mpmc = p_arg;
+    void *items[3] = { NULL };
+    uintptr_t next = 1;
+    unsigned int count = 0;
+
+    while (next <= TEST_TRANSFER_COUNT)
+    {
+        if (next % 2)
+        {
+            if (EZQ_STATUS_SUCCESS == ezq_mpmc_push(p_mpmc, (void *)next))
+            {
+                ++next;
+                continue;
+            }
+        }
+        else
+        {
+            for (count = 0; count < 3 && next + count <= TEST_TRANSFER_COUNT;
+                ++count)
+            {
+                items[count] = (void *)(next + count);
+            }
+            next += ezq_mpmc_push_n(p_mpmc, items, count, NULL);
+        }
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+/*!
+ * @struct consumer_args
+ * @brief Structure describing the work of a \c consumer_thread .
+ */
+struct consumer_args
+{
+    ezq_mpmc *p_mpmc; /* queue to pop from */
+    atomic_uint *p_remaining; /* number of items still to be popped */
+    uintptr_t sum; /* sum of the values popped by this consumer */
+};
+
+/*!
+ * @brief Pops items from the passed queue, alternating between single and
+ * batched pops, until no items remain to be popped across all consumers.
+ *
+ * @param[in,out] p_arg Address of a \c consumer_args structure, whose
+ * \c sum is updated with the sum of the popped values.
+ *
+ * @return \c NULL
+ */
+static void *
+consumer_thread(void *p_arg)
+{
+    struct consumer_args *p_args = p_arg;
+    void *items[4] = { NULL };
+    unsigned int popped = 0;
+    unsigned int i = 0;
+
+    while (atomic_load(p_args->p_remaining) > 0)
+    {
+        if (atomic_load(p_args->p_remaining) % 2)
+        {
+            popped = EZQ_STATUS_SUCCESS
+                == ezq_mpmc_pop(p_args->p_mpmc, &items[0]) ? 1 : 0;
+        }
+        else
+        {
+            popped = ezq_mpmc_pop_n(p_args->p_mpmc, items, 4, NULL);
+        }
+        for (i = 0; i < popped; ++i)
+        {
+            p_args->sum += (uintptr_t)items[i];
+        }
+        if (popped > 0)
+        {
+            atomic_fetch_sub(p_args->p_remaining, popped);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_mpmc_init rounds the capacity up to at least
+ * two slots and numbers each slot with its own index.
+ */
+static void
+test__ezq_mpmc_init__standard__success(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpmc_init(&mpmc, 1, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(g_slots, mpmc.p_slots);
+    TEST_ASSERT_EQUAL_UINT(2 * sizeof(g_slots[0]), g_alloc_size);
+    TEST_ASSERT_EQUAL_UINT32(2, ezq_mpmc_capacity(&mpmc));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_mpmc_count(&mpmc, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&g_slots[0].seq));
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&g_slots[1].seq));
+    TEST_ASSERT_NULL(g_slots[0].p_item);
+    TEST_ASSERT_NULL(g_slots[1].p_item);
+} /* test__ezq_mpmc_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_init fails when asked for a capacity of
+ * \c 0 .
+ */
+static void
+test__ezq_mpmc_init__zero_capacity__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpmc_init(&mpmc, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(mpmc.p_slots);
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_size);
+} /* test__ezq_mpmc_init__zero_capacity__failure */
+
+/*!
+ * @brief Tests that items pushed with \c ezq_mpmc_push are retrieved in
+ * order by \c ezq_mpmc_pop , including once the ring has wrapped around.
+ */
+static void
+test__ezq_mpmc_push_pop__wrapped__success(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    for (i = 1; i <= TEST_SLOT_CAPACITY * 3; ++i)
+    {
+        estat = ezq_mpmc_push(&mpmc, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(1, ezq_mpmc_count(&mpmc, NULL));
+
+        estat = ezq_mpmc_pop(&mpmc, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_mpmc_count(&mpmc, NULL));
+} /* test__ezq_mpmc_push_pop__wrapped__success */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_push fails once the ring is full.
+ */
+static void
+test__ezq_mpmc_push__full__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= TEST_SLOT_CAPACITY; ++i)
+    {
+        estat = ezq_mpmc_push(&mpmc, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpmc_push(&mpmc, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        TEST_SLOT_CAPACITY,
+        ezq_mpmc_count(&mpmc, NULL)
+    );
+    TEST_ASSERT_EQUAL_PTR((void *)1, g_slots[0].p_item);
+} /* test__ezq_mpmc_push__full__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_try_push gives up rather than retrying
+ * when another producer has already taken the ticket it read.
+ */
+static void
+test__ezq_mpmc_try_push__contended__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. The first slot appears to have been filled
+     * by another producer that has not yet been seen to advance the tail.
+     * */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_slots[0].p_item = (void *)0xFE;
+    atomic_store(&g_slots[0].seq, 1);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpmc_try_push(&mpmc, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_BUSY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xFE, g_slots[0].p_item);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&mpmc.tail));
+} /* test__ezq_mpmc_try_push__contended__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_push_n places only as many items as there
+ * are free slots and reports that the queue is full.
+ */
+static void
+test__ezq_mpmc_push_n__full__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[TEST_SLOT_CAPACITY + 2] = { NULL };
+    unsigned int pushed = 0;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < TEST_SLOT_CAPACITY + 2; ++i)
+    {
+        items[i] = (void *)(i + 1);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_mpmc_push_n(&mpmc, items, TEST_SLOT_CAPACITY + 2, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(TEST_SLOT_CAPACITY, pushed);
+    for (i = 0; i < TEST_SLOT_CAPACITY; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(i + 1), g_slots[i].p_item);
+        TEST_ASSERT_EQUAL_UINT32(i + 1, atomic_load(&g_slots[i].seq));
+    }
+} /* test__ezq_mpmc_push_n__full__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_push_n stops placing items at the first
+ * \c NULL item of a batch.
+ */
+static void
+test__ezq_mpmc_push_n__null_item__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[3] = { (void *)0xFE, NULL, (void *)0xFD };
+    unsigned int pushed = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_mpmc_push_n(&mpmc, items, 3, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, pushed);
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_mpmc_count(&mpmc, NULL));
+    TEST_ASSERT_EQUAL_PTR((void *)0xFE, g_slots[0].p_item);
+} /* test__ezq_mpmc_push_n__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_pop_n retrieves every remaining item, in
+ * order, and reports that the queue is empty when more items are requested
+ * than the queue holds.
+ */
+static void
+test__ezq_mpmc_pop_n__empty__failure(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[4] = { NULL };
+    unsigned int popped = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_SUCCESS,
+        ezq_mpmc_push(&mpmc, (void *)0xFF)
+    );
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_SUCCESS,
+        ezq_mpmc_push(&mpmc, (void *)0xFE)
+    );
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    popped = ezq_mpmc_pop_n(&mpmc, items, 4, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, popped);
+    TEST_ASSERT_EQUAL_PTR((void *)0xFF, items[0]);
+    TEST_ASSERT_EQUAL_PTR((void *)0xFE, items[1]);
+    TEST_ASSERT_NULL(items[2]);
+    TEST_ASSERT_EQUAL_UINT32(
+        TEST_SLOT_CAPACITY,
+        atomic_load(&g_slots[0].seq)
+    );
+} /* test__ezq_mpmc_pop_n__empty__failure */
+
+/*!
+ * @brief Tests that every item pushed by several producer threads is popped
+ * exactly once by several concurrently running consumers.
+ */
+static void
+test__ezq_mpmc_pop__concurrent_producers__success(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producers[TEST_THREAD_COUNT];
+    pthread_t consumers[TEST_THREAD_COUNT];
+    struct consumer_args args[TEST_THREAD_COUNT];
+    atomic_uint remaining;
+    uintptr_t sum = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(&mpmc, 64, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    atomic_init(&remaining, TEST_THREAD_COUNT * TEST_TRANSFER_COUNT);
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        args[i].p_mpmc = &mpmc;
+        args[i].p_remaining = &remaining;
+        args[i].sum = 0;
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&consumers[i], NULL, consumer_thread, &args[i])
+        );
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&producers[i], NULL, producer_thread, &mpmc)
+        );
+    }
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(consumers[i], NULL));
+        sum += args[i].sum;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&remaining));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_mpmc_count(&mpmc, NULL));
+    TEST_ASSERT_EQUAL_UINT64(
+        (uint64_t)TEST_THREAD_COUNT * TEST_TRANSFER_COUNT
+            * (TEST_TRANSFER_COUNT + 1) / 2,
+        sum
+    );
+
+    estat = ezq_mpmc_destroy(&mpmc, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_mpmc_pop__concurrent_producers__success */
+
+/*!
+ * @brief Tests that \c ezq_mpmc_destroy invokes the cleanup function on
+ * each remaining item and releases the ring.
+ */
+static void
+test__ezq_mpmc_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_mpmc mpmc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_mpmc_init(
+        &mpmc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_SUCCESS,
+        ezq_mpmc_push(&mpmc, (void *)0xFF)
+    );
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpmc_destroy(&mpmc, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(1, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+    TEST_ASSERT_NULL(mpmc.p_slots);
+} /* test__ezq_mpmc_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue MPMC unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_mpmc_init */
+    RUN_TEST(test__ezq_mpmc_init__standard__success);
+    RUN_TEST(test__ezq_mpmc_init__zero_capacity__failure);
+
+    /* ezq_mpmc_push / ezq_mpmc_pop */
+    RUN_TEST(test__ezq_mpmc_push_pop__wrapped__success);
+    RUN_TEST(test__ezq_mpmc_push__full__failure);
+    RUN_TEST(test__ezq_mpmc_try_push__contended__failure);
+    RUN_TEST(test__ezq_mpmc_pop__concurrent_producers__success);
+
+    /* ezq_mpmc_push_n / ezq_mpmc_pop_n */
+    RUN_TEST(test__ezq_mpmc_push_n__full__failure);
+    RUN_TEST(test__ezq_mpmc_push_n__null_item__failure);
+    RUN_TEST(test__ezq_mpmc_pop_n__empty__failure);
+
+    /* ezq_mpmc_destroy */
+    RUN_TEST(test__ezq_mpmc_destroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
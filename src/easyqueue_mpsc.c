@@ -0,0 +1,191 @@
+#include "easyqueue_mpsc.h"
+
+ezq_status EZQ_API
+ezq_mpsc_init(ezq_mpsc * const p_mpsc)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_mpsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    atomic_init(&p_mpsc->stub.p_next, NULL);
+    atomic_init(&p_mpsc->p_tail, &p_mpsc->stub);
+    p_mpsc->p_head = &p_mpsc->stub;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpsc_init */
+
+ezq_status EZQ_API
+ezq_mpsc_push(ezq_mpsc * const p_mpsc, struct ezq_mpsc_node * const p_node)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_mpsc_node * p_prev = NULL;
+
+    if (NULL == p_mpsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_node)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Swapping in the new tail orders the producers. Until the previous
+     * tail is linked to the new one, the consumer sees the list end early
+     * and reports EZQ_STATUS_BUSY.
+     * */
+    atomic_store_explicit(&p_node->p_next, NULL, memory_order_relaxed);
+    p_prev = atomic_exchange_explicit(
+        &p_mpsc->p_tail,
+        p_node,
+        memory_order_acq_rel
+    );
+    atomic_store_explicit(&p_prev->p_next, p_node, memory_order_release);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpsc_push */
+
+ezq_status EZQ_API
+ezq_mpsc_pop(ezq_mpsc * const p_mpsc, struct ezq_mpsc_node ** const pp_node)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_mpsc_node * p_head = NULL;
+    struct ezq_mpsc_node * p_next = NULL;
+
+    if (NULL == p_mpsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_node)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Step over the stub if it is at the front. */
+    p_head = p_mpsc->p_head;
+    p_next = atomic_load_explicit(&p_head->p_next, memory_order_acquire);
+    if (&p_mpsc->stub == p_head)
+    {
+        if (NULL == p_next)
+        {
+            estat = &p_mpsc->stub == atomic_load_explicit(
+                &p_mpsc->p_tail,
+                memory_order_acquire
+            ) ? EZQ_STATUS_EMPTY : EZQ_STATUS_BUSY;
+            goto done;
+        }
+        p_mpsc->p_head = p_next;
+        p_head = p_next;
+        p_next = atomic_load_explicit(&p_head->p_next, memory_order_acquire);
+    }
+
+    /* The front node can be handed out once it links to a successor. */
+    if (NULL != p_next)
+    {
+        p_mpsc->p_head = p_next;
+        *pp_node = p_head;
+        estat = EZQ_STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* Otherwise it may be the last node, which cannot be unlinked while it
+     * is the tail. Push the stub behind it so that it gains a successor,
+     * unless a producer is already part-way through linking one in.
+     * */
+    if (p_head != atomic_load_explicit(&p_mpsc->p_tail, memory_order_acquire))
+    {
+        estat = EZQ_STATUS_BUSY;
+        goto done;
+    }
+    (void)ezq_mpsc_push(p_mpsc, &p_mpsc->stub);
+
+    p_next = atomic_load_explicit(&p_head->p_next, memory_order_acquire);
+    if (NULL == p_next)
+    {
+        estat = EZQ_STATUS_BUSY;
+        goto done;
+    }
+    p_mpsc->p_head = p_next;
+    *pp_node = p_head;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_mpsc_pop */
+
+unsigned int EZQ_API
+ezq_mpsc_drain(
+    ezq_mpsc * const p_mpsc,
+    void (*node_fn)(struct ezq_mpsc_node *p_node, void *p_args),
+    void * const p_args,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_mpsc_node * p_node = NULL;
+    struct ezq_mpsc_node * p_last = NULL;
+    int is_last = 0;
+    unsigned int drained = 0;
+
+    if (NULL == p_mpsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == node_fn)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Stop at the node that was the tail when the drain began, so that
+     * producers pushing continuously cannot keep the consumer here forever.
+     * If that was the stub, every older node is ahead of it in the list.
+     * */
+    p_last = atomic_load_explicit(&p_mpsc->p_tail, memory_order_acquire);
+    estat = EZQ_STATUS_EMPTY;
+    while (!is_last)
+    {
+        if (&p_mpsc->stub == p_last && &p_mpsc->stub == p_mpsc->p_head)
+        {
+            break;
+        }
+
+        estat = ezq_mpsc_pop(p_mpsc, &p_node);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            break;
+        }
+
+        is_last = p_last == p_node;
+        node_fn(p_node, p_args);
+        ++drained;
+    }
+
+    /* Running out of nodes is the expected way for a drain to end. */
+    if (EZQ_STATUS_EMPTY == estat)
+    {
+        estat = EZQ_STATUS_SUCCESS;
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return drained;
+} /* ezq_mpsc_drain */
@@ -0,0 +1,348 @@
+#include <pthread.h>
+#include <sched.h>
+#include <unity/unity.h>
+#include "easyqueue_mpsc.h"
+
+#define TEST_THREAD_COUNT (3)
+#define TEST_TRANSFER_COUNT (20000u)
+
+/*!
+ * @struct test_message
+ * @brief Structure representing a caller's message with an embedded
+ * \c ezq_mpsc_node .
+ */
+struct test_message
+{
+    unsigned int producer; /* index of the thread that sent the message */
+    unsigned int sequence; /* position of the message in its sender's stream */
+    struct ezq_mpsc_node node; /* link used by the queue */
+};
+
+/*!
+ * @struct drain_record
+ * @brief Structure collecting the messages passed to \c record_node_fn .
+ */
+struct drain_record
+{
+    unsigned int count; /* number of messages recorded */
+    unsigned int sequences[8]; /* sequence numbers of the first messages */
+};
+
+ezq_mpsc g_mpsc; /* queue shared with producer_thread */
+struct test_message g_messages[TEST_THREAD_COUNT][TEST_TRANSFER_COUNT];
+
+void setUp(void) { } /* UNUSED; required definition for Unity tests */
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Records the sequence number of the message containing \c p_node .
+ *
+ * @param[in] p_node Node embedded in a \c test_message .
+ * @param[in,out] p_args Address of a \c drain_record .
+ */
+static void
+record_node_fn(struct ezq_mpsc_node *p_node, void *p_args)
+{
+    struct drain_record *p_record = p_args;
+    struct test_message *p_message = EZQ_CONTAINER_OF(
+        p_node,
+        struct test_message,
+        node
+    );
+
+    if (p_record->count < 8)
+    {
+        p_record->sequences[p_record->count] = p_message->sequence;
+    }
+    ++p_record->count;
+}
+
+/*!
+ * @brief Pushes this thread's \c TEST_TRANSFER_COUNT messages onto the
+ * shared queue.
+ *
+ * @param[in] p_arg Address of the sending thread's row of \c g_messages .
+ *
+ * @return \c NULL
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    struct test_message *p_messages = p_arg;
+    unsigned int i = 0;
+
+    for (i = 0; i < TEST_TRANSFER_COUNT; ++i)
+    {
+        (void)ezq_mpsc_push(&g_mpsc, &p_messages[i].node);
+        if (0 == i % 64)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_mpsc_init leaves the queue holding only its
+ * stub node.
+ */
+static void
+test__ezq_mpsc_init__standard__success(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&mpsc.stub, mpsc.p_head);
+    TEST_ASSERT_EQUAL_PTR(&mpsc.stub, atomic_load(&mpsc.p_tail));
+    TEST_ASSERT_NULL(atomic_load(&mpsc.stub.p_next));
+} /* test__ezq_mpsc_init__standard__success */
+
+/*!
+ * @brief Tests that nodes pushed with \c ezq_mpsc_push are retrieved in
+ * order by \c ezq_mpsc_pop , including the final node, which requires the
+ * stub node to be pushed behind it.
+ */
+static void
+test__ezq_mpsc_push_pop__standard__success(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_message messages[3] = { { 0 } };
+    struct ezq_mpsc_node *p_node = NULL;
+    unsigned int round = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the functions being tested and verify the expected outcome.
+     * The second round starts with the stub behind the last popped node.
+     * */
+    for (round = 0; round < 2; ++round)
+    {
+        for (i = 0; i < 3; ++i)
+        {
+            messages[i].sequence = i;
+            estat = ezq_mpsc_push(&mpsc, &messages[i].node);
+            TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        }
+        for (i = 0; i < 3; ++i)
+        {
+            estat = ezq_mpsc_pop(&mpsc, &p_node);
+            TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+            TEST_ASSERT_EQUAL_PTR(&messages[i].node, p_node);
+            TEST_ASSERT_EQUAL_UINT32(
+                i,
+                EZQ_CONTAINER_OF(p_node, struct test_message, node)->sequence
+            );
+        }
+        estat = ezq_mpsc_pop(&mpsc, &p_node);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    }
+} /* test__ezq_mpsc_push_pop__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_mpsc_push fails when passed a \c NULL node.
+ */
+static void
+test__ezq_mpsc_push__null_item__failure(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpsc_push(&mpsc, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    TEST_ASSERT_EQUAL_PTR(&mpsc.stub, atomic_load(&mpsc.p_tail));
+} /* test__ezq_mpsc_push__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpsc_pop reports a busy queue, rather than an
+ * empty one, while a producer has swapped in a new tail but not yet linked
+ * it to the previous one.
+ */
+static void
+test__ezq_mpsc_pop__partial_push__failure(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_message message = { 0 };
+    struct ezq_mpsc_node *p_node = NULL;
+
+    /* Set any initial state, stopping a push after its exchange. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    atomic_init(&message.node.p_next, NULL);
+    atomic_store(&mpsc.p_tail, &message.node);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_mpsc_pop(&mpsc, &p_node);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_BUSY, estat);
+    TEST_ASSERT_NULL(p_node);
+
+    /* Completing the push makes the node available. */
+    atomic_store(&mpsc.stub.p_next, &message.node);
+    estat = ezq_mpsc_pop(&mpsc, &p_node);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&message.node, p_node);
+} /* test__ezq_mpsc_pop__partial_push__failure */
+
+/*!
+ * @brief Tests that \c ezq_mpsc_drain passes every queued node, in order,
+ * to the passed function and leaves the queue empty.
+ */
+static void
+test__ezq_mpsc_drain__standard__success(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_message messages[5] = { { 0 } };
+    struct drain_record record = { 0 };
+    struct ezq_mpsc_node *p_node = NULL;
+    unsigned int drained = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < 5; ++i)
+    {
+        messages[i].sequence = i + 1;
+        TEST_ASSERT_EQUAL_UINT8(
+            EZQ_STATUS_SUCCESS,
+            ezq_mpsc_push(&mpsc, &messages[i].node)
+        );
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    drained = ezq_mpsc_drain(&mpsc, record_node_fn, &record, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(5, drained);
+    TEST_ASSERT_EQUAL_UINT32(5, record.count);
+    for (i = 0; i < 5; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT32(i + 1, record.sequences[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, ezq_mpsc_pop(&mpsc, &p_node));
+} /* test__ezq_mpsc_drain__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_mpsc_drain succeeds without invoking the passed
+ * function when the queue is empty.
+ */
+static void
+test__ezq_mpsc_drain__empty__success(void)
+{
+    ezq_mpsc mpsc;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct drain_record record = { 0 };
+    unsigned int drained = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpsc_init(&mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    drained = ezq_mpsc_drain(&mpsc, record_node_fn, &record, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, drained);
+    TEST_ASSERT_EQUAL_UINT32(0, record.count);
+} /* test__ezq_mpsc_drain__empty__success */
+
+/*!
+ * @brief Tests that every message pushed by several producer threads is
+ * popped exactly once by the consumer, and that each producer's messages
+ * arrive in the order they were sent.
+ */
+static void
+test__ezq_mpsc_pop__concurrent_producers__success(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producers[TEST_THREAD_COUNT];
+    unsigned int next[TEST_THREAD_COUNT] = { 0 };
+    struct ezq_mpsc_node *p_node = NULL;
+    struct test_message *p_message = NULL;
+    unsigned int received = 0;
+    unsigned int i = 0;
+    unsigned int j = 0;
+
+    /* Set any initial state. */
+    estat = ezq_mpsc_init(&g_mpsc);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        for (j = 0; j < TEST_TRANSFER_COUNT; ++j)
+        {
+            g_messages[i][j].producer = i;
+            g_messages[i][j].sequence = j;
+        }
+    }
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&producers[i], NULL, producer_thread, g_messages[i])
+        );
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    while (received < TEST_THREAD_COUNT * TEST_TRANSFER_COUNT)
+    {
+        estat = ezq_mpsc_pop(&g_mpsc, &p_node);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            sched_yield();
+            continue;
+        }
+
+        p_message = EZQ_CONTAINER_OF(p_node, struct test_message, node);
+        TEST_ASSERT_EQUAL_UINT32(
+            next[p_message->producer],
+            p_message->sequence
+        );
+        ++next[p_message->producer];
+        ++received;
+    }
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+    }
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, ezq_mpsc_pop(&g_mpsc, &p_node));
+} /* test__ezq_mpsc_pop__concurrent_producers__success */
+
+/*!
+ * @brief Runs all of the Easyqueue MPSC unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_mpsc_init */
+    RUN_TEST(test__ezq_mpsc_init__standard__success);
+
+    /* ezq_mpsc_push / ezq_mpsc_pop */
+    RUN_TEST(test__ezq_mpsc_push_pop__standard__success);
+    RUN_TEST(test__ezq_mpsc_push__null_item__failure);
+    RUN_TEST(test__ezq_mpsc_pop__partial_push__failure);
+    RUN_TEST(test__ezq_mpsc_pop__concurrent_producers__success);
+
+    /* ezq_mpsc_drain */
+    RUN_TEST(test__ezq_mpsc_drain__standard__success);
+    RUN_TEST(test__ezq_mpsc_drain__empty__success);
+
+    return UNITY_END();
+} /* main */
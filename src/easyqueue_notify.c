@@ -0,0 +1,146 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+#if defined(__linux__)
+ #include <sys/eventfd.h>
+#endif /* __linux__ */
+#include "easyqueue_notify.h"
+
+ezq_status EZQ_API
+ezq_notifier_init(ezq_notifier * const p_notifier)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+#if !defined(__linux__)
+    int fds[2] = { -1, -1 };
+#endif /* !__linux__ */
+
+    if (NULL == p_notifier)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+#if defined(__linux__)
+    p_notifier->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    p_notifier->write_fd = p_notifier->fd;
+#else
+    if (0 != pipe(fds)
+        || -1 == fcntl(fds[0], F_SETFL, O_NONBLOCK)
+        || -1 == fcntl(fds[1], F_SETFL, O_NONBLOCK)
+        || -1 == fcntl(fds[0], F_SETFD, FD_CLOEXEC)
+        || -1 == fcntl(fds[1], F_SETFD, FD_CLOEXEC))
+    {
+        if (-1 != fds[0])
+        {
+            (void)close(fds[0]);
+            (void)close(fds[1]);
+        }
+        fds[0] = -1;
+    }
+    p_notifier->fd = fds[0];
+    p_notifier->write_fd = fds[1];
+#endif /* __linux__ */
+    if (-1 == p_notifier->fd)
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+    atomic_init(&p_notifier->armed, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_notifier_init */
+
+int EZQ_API
+ezq_notifier_fd(const ezq_notifier * const p_notifier)
+{
+    return NULL == p_notifier ? -1 : p_notifier->fd;
+} /* ezq_notifier_fd */
+
+ezq_status EZQ_API
+ezq_notifier_signal(ezq_notifier * const p_notifier)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t one = 1;
+
+    if (NULL == p_notifier)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* Only the signal that disarms the notifier writes; the rest of a
+     * burst finds it already disarmed.
+     * */
+    estat = EZQ_STATUS_SUCCESS;
+    if (0 == atomic_exchange(&p_notifier->armed, 0))
+    {
+        goto done;
+    }
+    /* A full pipe or eventfd counter is readable already. */
+    if (-1 == write(p_notifier->write_fd, &one, sizeof(one))
+        && EAGAIN != errno)
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+    }
+
+done:
+    return estat;
+} /* ezq_notifier_signal */
+
+ezq_status EZQ_API
+ezq_notifier_ack(ezq_notifier * const p_notifier)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t value = 0;
+
+    if (NULL == p_notifier)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* Clear the descriptor before re-arming, so that a signal made after
+     * re-arming is never read away here. An eventfd is cleared by a single
+     * read; a pipe is read until empty.
+     * */
+    while ((ssize_t)sizeof(value) == read(p_notifier->fd, &value, sizeof(value))
+        && p_notifier->write_fd != p_notifier->fd)
+    {
+    }
+    atomic_store(&p_notifier->armed, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_notifier_ack */
+
+ezq_status EZQ_API
+ezq_notifier_destroy(ezq_notifier * const p_notifier)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_notifier)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    if (p_notifier->write_fd != p_notifier->fd)
+    {
+        (void)close(p_notifier->write_fd);
+    }
+    (void)close(p_notifier->fd);
+    p_notifier->fd = -1;
+    p_notifier->write_fd = -1;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_notifier_destroy */
@@ -0,0 +1,195 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <unity/unity.h>
+#include "easyqueue_notify.h"
+
+void setUp(void) { } /* UNUSED; required definition for Unity tests */
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Checks whether the passed descriptor is readable without waiting.
+ *
+ * @param[in] fd Descriptor to check.
+ *
+ * @return Non-zero if \c fd is readable.
+ */
+static int
+is_readable(const int fd)
+{
+    struct pollfd pfd = { 0 };
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    return 1 == poll(&pfd, 1, 0) && (pfd.revents & POLLIN);
+}
+
+/*!
+ * @brief Tests that \c ezq_notifier_init opens an armed descriptor that is
+ * not yet readable.
+ */
+static void
+test__ezq_notifier_init__standard__success(void)
+{
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(ezq_notifier_fd(&notifier) >= 0);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&notifier.armed));
+    TEST_ASSERT_FALSE(is_readable(ezq_notifier_fd(&notifier)));
+    TEST_ASSERT_TRUE(
+        fcntl(ezq_notifier_fd(&notifier), F_GETFL) & O_NONBLOCK
+    );
+
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_notifier_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_notifier_fd reports \c -1 for a \c NULL
+ * notifier.
+ */
+static void
+test__ezq_notifier_fd__null_notifier__failure(void)
+{
+    /* Invoke the function being tested and verify the expected outcome. */
+    TEST_ASSERT_EQUAL_INT(-1, ezq_notifier_fd(NULL));
+} /* test__ezq_notifier_fd__null_notifier__failure */
+
+/*!
+ * @brief Tests that a burst of calls to \c ezq_notifier_signal makes the
+ * descriptor readable with a single write.
+ */
+static void
+test__ezq_notifier_signal__burst__success(void)
+{
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t value = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < 3; ++i)
+    {
+        estat = ezq_notifier_signal(&notifier);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&notifier.armed));
+    }
+    TEST_ASSERT_TRUE(is_readable(ezq_notifier_fd(&notifier)));
+    TEST_ASSERT_EQUAL_INT(
+        sizeof(value),
+        read(ezq_notifier_fd(&notifier), &value, sizeof(value))
+    );
+    TEST_ASSERT_EQUAL_UINT64(1, value);
+    TEST_ASSERT_FALSE(is_readable(ezq_notifier_fd(&notifier)));
+
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_notifier_signal__burst__success */
+
+/*!
+ * @brief Tests that \c ezq_notifier_signal fails when given a \c NULL
+ * notifier.
+ */
+static void
+test__ezq_notifier_signal__null_notifier__failure(void)
+{
+    /* Invoke the function being tested and verify the expected outcome. */
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_NULL_QUEUE,
+        ezq_notifier_signal(NULL)
+    );
+} /* test__ezq_notifier_signal__null_notifier__failure */
+
+/*!
+ * @brief Tests that \c ezq_notifier_ack clears the descriptor and re-arms
+ * the notifier so that the next signal writes again.
+ */
+static void
+test__ezq_notifier_ack__signalled__success(void)
+{
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_notifier_signal(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_notifier_ack(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&notifier.armed));
+    TEST_ASSERT_FALSE(is_readable(ezq_notifier_fd(&notifier)));
+
+    estat = ezq_notifier_signal(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(is_readable(ezq_notifier_fd(&notifier)));
+
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_notifier_ack__signalled__success */
+
+/*!
+ * @brief Tests that \c ezq_notifier_destroy closes the descriptor.
+ */
+static void
+test__ezq_notifier_destroy__standard__success(void)
+{
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    int fd = -1;
+
+    /* Set any initial state. */
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    fd = ezq_notifier_fd(&notifier);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_INT(-1, ezq_notifier_fd(&notifier));
+    TEST_ASSERT_EQUAL_INT(-1, fcntl(fd, F_GETFD));
+} /* test__ezq_notifier_destroy__standard__success */
+
+/*!
+ * @brief Runs all of the Easyqueue notifier unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_notifier_init */
+    RUN_TEST(test__ezq_notifier_init__standard__success);
+
+    /* ezq_notifier_fd */
+    RUN_TEST(test__ezq_notifier_fd__null_notifier__failure);
+
+    /* ezq_notifier_signal */
+    RUN_TEST(test__ezq_notifier_signal__burst__success);
+    RUN_TEST(test__ezq_notifier_signal__null_notifier__failure);
+
+    /* ezq_notifier_ack */
+    RUN_TEST(test__ezq_notifier_ack__signalled__success);
+
+    /* ezq_notifier_destroy */
+    RUN_TEST(test__ezq_notifier_destroy__standard__success);
+
+    return UNITY_END();
+} /* main */
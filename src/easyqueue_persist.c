@@ -0,0 +1,692 @@
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "easyqueue_persist.h"
+#include "easyqueue_ring.h"
+
+/* The head and tail are shared through the mapping, which only works for
+ * atomics that need no lock of their own.
+ */
+#if ATOMIC_INT_LOCK_FREE != 2
+ #error "ezq_persist requires a lock-free atomic_uint"
+#endif /* ATOMIC_INT_LOCK_FREE != 2 */
+
+/* Value of the magic field of every ezq_persist file. */
+static const char ezq_persist_magic[8] = "EZQPRST";
+
+/*!
+ * @brief Gets the slot of the ring that the record at position \c pos is
+ * kept in.
+ *
+ * @param[in] p_persist Address of the \c ezq_persist holding the record.
+ * @param[in] pos Position of the record.
+ *
+ * @return The address of the slot.
+ */
+static inline struct ezq_persist_record *
+ezq_persist_slot(const ezq_persist * const p_persist, const unsigned int pos)
+{
+    return (struct ezq_persist_record *)(
+        p_persist->p_ring + (size_t)(pos & p_persist->mask) * p_persist->stride
+    );
+} /* ezq_persist_slot */
+
+/*!
+ * @brief Computes the 32-bit FNV-1a hash of a record's position and data.
+ *
+ * @param[in] seq Position the record was pushed at.
+ * @param[in] p_data Address of the record's data.
+ * @param[in] size Number of bytes of data.
+ *
+ * @return The checksum of the record.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static unsigned int EZQ_API
+ezq_persist_checksum(
+    const unsigned int seq,
+    const unsigned char * const p_data,
+    const size_t size
+);
+
+/*!
+ * @brief Writes the header of a newly created file and syncs it, with the
+ * magic value written last so that a file left half-created by a crash is
+ * created again.
+ *
+ * @param[in,out] p_persist Address of the \c ezq_persist whose file was
+ * just created.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the header is on the disk, otherwise
+ * \c EZQ_STATUS_UNKNOWN .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_persist_create(ezq_persist * const p_persist);
+
+/*!
+ * @brief Moves the head of a reopened file past any slots reused since it
+ * was stored, then sets the tail to just past the last of the consecutive
+ * records from the head that pass validation.
+ *
+ * @param[in,out] p_persist Address of the \c ezq_persist to recover.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_persist_recover(ezq_persist * const p_persist);
+
+/*!
+ * @brief Writes the pages of the mapping covering a range of bytes back
+ * to the file and waits for them to reach the disk.
+ *
+ * @param[in] p_persist Address of the \c ezq_persist whose mapping to
+ * write back.
+ * @param[in] offset Offset of the first byte to write back.
+ * @param[in] length Number of bytes to write back.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the pages are on the disk, otherwise
+ * \c EZQ_STATUS_UNKNOWN .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_persist_flush(
+    const ezq_persist * const p_persist,
+    const size_t offset,
+    const size_t length
+);
+
+ezq_status EZQ_API
+ezq_persist_open(
+    ezq_persist * const p_persist,
+    const char * const path,
+    const unsigned int record_size,
+    const unsigned int capacity,
+    const unsigned int sync_every
+)
+{
+    static const char zeros[sizeof(ezq_persist_magic)] = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_persist_header header;
+    struct stat st;
+    long page_size = 0;
+    unsigned int slot_capacity = 0;
+    size_t stride = 0;
+    size_t data_offset = 0;
+    size_t size = 0;
+    void * p_map = MAP_FAILED;
+    int fd = -1;
+    int created = 0;
+
+    if (NULL == p_persist || NULL == path)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == record_size || 0 == capacity
+        || capacity > EZQ_RING_MAX_CAPACITY)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0)
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+
+    /* The ring starts on the page after the header, and each slot is
+     * rounded up to keep the positions and checksums aligned.
+     * */
+    slot_capacity = ezq_ring_round_pow2(capacity);
+    stride = (offsetof(struct ezq_persist_record, data) + record_size + 7)
+        & ~(size_t)7;
+    data_offset = (sizeof(header) + (size_t)page_size - 1)
+        / (size_t)page_size * (size_t)page_size;
+    if (stride < record_size
+        || stride > ((size_t)-1 - data_offset) / slot_capacity)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    size = data_offset + (size_t)slot_capacity * stride;
+    if ((off_t)size < 0 || (size_t)(off_t)size != size)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+    if (0 != flock(fd, LOCK_EX | LOCK_NB))
+    {
+        estat = EWOULDBLOCK == errno
+            ? EZQ_STATUS_BUSY
+            : EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+    if (0 != fstat(fd, &st))
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+
+    if (0 == st.st_size)
+    {
+        if (0 != ftruncate(fd, (off_t)size))
+        {
+            estat = EZQ_STATUS_UNKNOWN;
+            goto done;
+        }
+        created = 1;
+    }
+    else
+    {
+        if ((size_t)st.st_size < sizeof(header))
+        {
+            estat = EZQ_STATUS_CORRUPT;
+            goto done;
+        }
+        if ((ssize_t)sizeof(header) != pread(fd, &header, sizeof(header), 0))
+        {
+            estat = EZQ_STATUS_UNKNOWN;
+            goto done;
+        }
+        if (0 == memcmp(header.magic, zeros, sizeof(zeros))
+            && (off_t)size == st.st_size)
+        {
+            created = 1;
+        }
+        else if (0 != memcmp(header.magic, ezq_persist_magic,
+                             sizeof(ezq_persist_magic))
+                 || EZQ_PERSIST_VERSION != header.version
+                 || data_offset != header.data_offset)
+        {
+            estat = EZQ_STATUS_CORRUPT;
+            goto done;
+        }
+        else if (record_size != header.record_size
+                 || slot_capacity != header.capacity)
+        {
+            estat = EZQ_STATUS_INVALID_CAPACITY;
+            goto done;
+        }
+        else if ((off_t)size != st.st_size)
+        {
+            estat = EZQ_STATUS_CORRUPT;
+            goto done;
+        }
+    }
+
+    p_map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == p_map)
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+
+    p_persist->p_header = p_map;
+    p_persist->p_ring = (unsigned char *)p_map + data_offset;
+    p_persist->size = size;
+    p_persist->page_size = (size_t)page_size;
+    p_persist->stride = stride;
+    p_persist->mask = slot_capacity - 1;
+    p_persist->record_size = record_size;
+    p_persist->sync_every = sync_every;
+    p_persist->fd = fd;
+
+    if (created)
+    {
+        estat = ezq_persist_create(p_persist);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+    else
+    {
+        ezq_persist_recover(p_persist);
+    }
+
+    /* Recovered records may only have reached the page cache before the
+     * previous process exited, so the first sync writes them all back.
+     * */
+    p_persist->cached_head = atomic_load_explicit(
+        &p_persist->p_header->head,
+        memory_order_relaxed
+    );
+    p_persist->synced_tail = p_persist->cached_head;
+    p_persist->cached_tail = atomic_load_explicit(
+        &p_persist->p_header->tail,
+        memory_order_relaxed
+    );
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        if (MAP_FAILED != p_map)
+        {
+            (void)munmap(p_map, size);
+            p_persist->p_header = NULL;
+        }
+        if (fd >= 0)
+        {
+            (void)close(fd);
+        }
+    }
+    return estat;
+} /* ezq_persist_open */
+
+unsigned int EZQ_API
+ezq_persist_capacity(const ezq_persist * const p_persist)
+{
+    return NULL == p_persist || NULL == p_persist->p_header
+        ? 0
+        : p_persist->mask + 1;
+} /* ezq_persist_capacity */
+
+unsigned int EZQ_API
+ezq_persist_count(
+    const ezq_persist * const p_persist,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+    unsigned int count = 0;
+
+    if (NULL == p_persist || NULL == p_persist->p_header)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* As with ezq_spsc_count, reading the head first keeps the difference
+     * from going negative.
+     * */
+    head = atomic_load_explicit(
+        &p_persist->p_header->head,
+        memory_order_acquire
+    );
+    tail = atomic_load_explicit(
+        &p_persist->p_header->tail,
+        memory_order_acquire
+    );
+    count = tail - head;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_persist_count */
+
+ezq_status EZQ_API
+ezq_persist_push(ezq_persist * const p_persist, const void * const p_record)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_persist_record * p_slot = NULL;
+    unsigned int tail = 0;
+
+    if (NULL == p_persist || NULL == p_persist->p_header)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_record)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    tail = atomic_load_explicit(
+        &p_persist->p_header->tail,
+        memory_order_relaxed
+    );
+    if (tail - p_persist->cached_head > p_persist->mask)
+    {
+        p_persist->cached_head = atomic_load_explicit(
+            &p_persist->p_header->head,
+            memory_order_acquire
+        );
+        if (tail - p_persist->cached_head > p_persist->mask)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+    }
+
+    p_slot = ezq_persist_slot(p_persist, tail);
+    p_slot->seq = tail;
+    memcpy(p_slot->data, p_record, p_persist->record_size);
+    p_slot->checksum = ezq_persist_checksum(
+        tail,
+        p_slot->data,
+        p_persist->record_size
+    );
+    atomic_store_explicit(
+        &p_persist->p_header->tail,
+        tail + 1,
+        memory_order_release
+    );
+
+    estat = EZQ_STATUS_SUCCESS;
+    if (0 != p_persist->sync_every
+        && tail + 1 - p_persist->synced_tail >= p_persist->sync_every)
+    {
+        estat = ezq_persist_sync(p_persist);
+    }
+
+done:
+    return estat;
+} /* ezq_persist_push */
+
+ezq_status EZQ_API
+ezq_persist_pop(ezq_persist * const p_persist, void * const p_record)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+
+    if (NULL == p_persist || NULL == p_persist->p_header)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_record)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    head = atomic_load_explicit(
+        &p_persist->p_header->head,
+        memory_order_relaxed
+    );
+    if (head == p_persist->cached_tail)
+    {
+        p_persist->cached_tail = atomic_load_explicit(
+            &p_persist->p_header->tail,
+            memory_order_acquire
+        );
+        if (head == p_persist->cached_tail)
+        {
+            estat = EZQ_STATUS_EMPTY;
+            goto done;
+        }
+    }
+
+    memcpy(
+        p_record,
+        ezq_persist_slot(p_persist, head)->data,
+        p_persist->record_size
+    );
+    atomic_store_explicit(
+        &p_persist->p_header->head,
+        head + 1,
+        memory_order_release
+    );
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_persist_pop */
+
+ezq_status EZQ_API
+ezq_persist_sync(ezq_persist * const p_persist)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    size_t ring_offset = 0;
+    unsigned int slot_capacity = 0;
+    unsigned int tail = 0;
+    unsigned int first = 0;
+    unsigned int pending = 0;
+
+    if (NULL == p_persist || NULL == p_persist->p_header)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    ring_offset = (size_t)(
+        p_persist->p_ring - (unsigned char *)p_persist->p_header
+    );
+    slot_capacity = p_persist->mask + 1;
+    tail = atomic_load_explicit(
+        &p_persist->p_header->tail,
+        memory_order_acquire
+    );
+    first = p_persist->synced_tail & p_persist->mask;
+    pending = tail - p_persist->synced_tail;
+    if (pending > slot_capacity)
+    {
+        pending = slot_capacity;
+    }
+
+    /* Records are written back before the header, so that the tail on the
+     * disk rarely runs ahead of its records; recovery copes if it does.
+     * The pending records may wrap around the end of the ring.
+     * */
+    estat = EZQ_STATUS_SUCCESS;
+    if (first + pending > slot_capacity)
+    {
+        estat = ezq_persist_flush(
+            p_persist,
+            ring_offset,
+            (size_t)(first + pending - slot_capacity) * p_persist->stride
+        );
+        pending = slot_capacity - first;
+    }
+    if (EZQ_STATUS_SUCCESS == estat && pending > 0)
+    {
+        estat = ezq_persist_flush(
+            p_persist,
+            ring_offset + (size_t)first * p_persist->stride,
+            (size_t)pending * p_persist->stride
+        );
+    }
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    estat = ezq_persist_flush(
+        p_persist,
+        0,
+        sizeof(struct ezq_persist_header)
+    );
+    if (EZQ_STATUS_SUCCESS == estat)
+    {
+        p_persist->synced_tail = tail;
+    }
+
+done:
+    return estat;
+} /* ezq_persist_sync */
+
+ezq_status EZQ_API
+ezq_persist_close(ezq_persist * const p_persist)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_persist || NULL == p_persist->p_header)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    estat = ezq_persist_sync(p_persist);
+    (void)munmap(p_persist->p_header, p_persist->size);
+    (void)close(p_persist->fd);
+
+    p_persist->p_header = NULL;
+    p_persist->p_ring = NULL;
+    p_persist->size = 0;
+    p_persist->mask = 0;
+    p_persist->fd = -1;
+
+done:
+    return estat;
+} /* ezq_persist_close */
+
+static unsigned int EZQ_API
+ezq_persist_checksum(
+    const unsigned int seq,
+    const unsigned char * const p_data,
+    const size_t size
+)
+{
+    unsigned int hash = 2166136261u;
+    size_t i = 0;
+
+    assert(NULL != p_data);
+
+    for (i = 0; i < sizeof(seq); ++i)
+    {
+        hash = ((hash ^ ((seq >> (8 * i)) & 0xFFu)) * 16777619u)
+            & 0xFFFFFFFFu;
+    }
+    for (i = 0; i < size; ++i)
+    {
+        hash = ((hash ^ p_data[i]) * 16777619u) & 0xFFFFFFFFu;
+    }
+
+    return hash;
+} /* ezq_persist_checksum */
+
+static ezq_status EZQ_API
+ezq_persist_create(ezq_persist * const p_persist)
+{
+    struct ezq_persist_header * p_header = NULL;
+
+    assert(NULL != p_persist);
+
+    p_header = p_persist->p_header;
+
+    p_header->version = EZQ_PERSIST_VERSION;
+    p_header->record_size = p_persist->record_size;
+    p_header->capacity = p_persist->mask + 1;
+    p_header->data_offset = (unsigned int)(
+        p_persist->p_ring - (unsigned char *)p_header
+    );
+    atomic_init(&p_header->tail, 0);
+    atomic_init(&p_header->head, 0);
+    memcpy(p_header->magic, ezq_persist_magic, sizeof(ezq_persist_magic));
+
+    return ezq_persist_flush(p_persist, 0, sizeof(*p_header));
+} /* ezq_persist_create */
+
+static void EZQ_API
+ezq_persist_recover(ezq_persist * const p_persist)
+{
+    const struct ezq_persist_record * p_slot = NULL;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+
+    assert(NULL != p_persist);
+
+    /* The stored head may be older than the records in the ring, since a
+     * push reuses a slot as soon as the head in memory has passed it. A
+     * valid record in the head's slot from a later lap was pushed at a
+     * position at most mask ahead of the head at the time, so the head
+     * had already passed every position before that.
+     * */
+    head = atomic_load_explicit(
+        &p_persist->p_header->head,
+        memory_order_relaxed
+    );
+    p_slot = ezq_persist_slot(p_persist, head);
+    while (p_slot->seq - head - 1 < (unsigned int)-1 / 2
+        && 0 == ((p_slot->seq - head) & p_persist->mask)
+        && p_slot->checksum == ezq_persist_checksum(
+            p_slot->seq,
+            p_slot->data,
+            p_persist->record_size
+        ))
+    {
+        head = p_slot->seq - p_persist->mask;
+        p_slot = ezq_persist_slot(p_persist, head);
+    }
+    atomic_store_explicit(
+        &p_persist->p_header->head,
+        head,
+        memory_order_relaxed
+    );
+
+    /* The stored tail is not trusted, since the header page may have
+     * reached the disk before or after the records it describes. A record
+     * belongs to the queue if it carries its own position and checksum; a
+     * slot last written on an earlier lap carries an older position.
+     * */
+    for (tail = head; tail - head <= p_persist->mask; ++tail)
+    {
+        p_slot = ezq_persist_slot(p_persist, tail);
+        if (tail != p_slot->seq
+            || p_slot->checksum != ezq_persist_checksum(
+                tail,
+                p_slot->data,
+                p_persist->record_size
+            ))
+        {
+            break;
+        }
+    }
+    atomic_store_explicit(
+        &p_persist->p_header->tail,
+        tail,
+        memory_order_relaxed
+    );
+} /* ezq_persist_recover */
+
+static ezq_status EZQ_API
+ezq_persist_flush(
+    const ezq_persist * const p_persist,
+    const size_t offset,
+    const size_t length
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    size_t start = 0;
+
+    assert(NULL != p_persist);
+
+    /* msync only accepts page-aligned addresses. */
+    start = offset / p_persist->page_size * p_persist->page_size;
+    if (0 != msync(
+            (unsigned char *)p_persist->p_header + start,
+            offset + length - start,
+            MS_SYNC
+        ))
+    {
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_persist_flush */
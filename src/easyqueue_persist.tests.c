@@ -0,0 +1,577 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <unity/unity.h>
+#include "easyqueue_persist.h"
+
+#define TEST_TRANSFER_COUNT (100000u)
+
+char g_path[32]; /* path of the file backing the queue under test */
+
+/*!
+ * @brief Creates an empty file for the queue under test to use.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    int fd = -1;
+
+    strcpy(g_path, "/tmp/ezq_persist_XXXXXX");
+    fd = mkstemp(g_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+}
+
+/*!
+ * @brief Removes the file created by \c setUp .
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void tearDown(void)
+{
+    (void)unlink(g_path);
+}
+
+/*!
+ * @brief Releases the mapping and descriptor of an open queue without
+ * syncing it, as though its process had crashed.
+ *
+ * @param[in,out] p_persist Address of the \c ezq_persist to abandon.
+ */
+static void
+crash(ezq_persist * const p_persist)
+{
+    TEST_ASSERT_EQUAL_INT(0, munmap(p_persist->p_header, p_persist->size));
+    TEST_ASSERT_EQUAL_INT(0, close(p_persist->fd));
+}
+
+/*!
+ * @brief Pushes consecutive values onto the passed queue, retrying while
+ * it is full.
+ *
+ * @param[in,out] p_arg Address of the \c ezq_persist to push onto.
+ *
+ * @return \c NULL
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    ezq_persist *p_persist = p_arg;
+    unsigned int i = 0;
+
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        while (EZQ_STATUS_SUCCESS != ezq_persist_push(p_persist, &i))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_persist_open creates an empty queue in an empty
+ * file, rounding the capacity up to a power of two.
+ */
+static void
+test__ezq_persist_open__new_file__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 5, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(8, ezq_persist_capacity(&persist));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_persist_count(&persist, &estat));
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_PERSIST_VERSION,
+        persist.p_header->version
+    );
+    TEST_ASSERT_EQUAL_UINT32(8, persist.p_header->capacity);
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_persist_capacity(&persist));
+} /* test__ezq_persist_open__new_file__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_open refuses records of zero bytes.
+ */
+static void
+test__ezq_persist_open__zero_record_size__failure(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, 0, 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+} /* test__ezq_persist_open__zero_record_size__failure */
+
+/*!
+ * @brief Tests that \c ezq_persist_open refuses to reopen a file with a
+ * different record size or capacity from those it was created with.
+ */
+static void
+test__ezq_persist_open__different_geometry__failure(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 8, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+    estat = ezq_persist_open(&persist, g_path, 2 * sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 3, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__different_geometry__failure */
+
+/*!
+ * @brief Tests that \c ezq_persist_open refuses a file that is not an
+ * \c ezq_persist ring.
+ */
+static void
+test__ezq_persist_open__foreign_file__failure(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    char contents[512];
+    FILE *p_file = NULL;
+
+    /* Set any initial state. */
+    memset(contents, 'x', sizeof(contents));
+    p_file = fopen(g_path, "wb");
+    TEST_ASSERT_NOT_NULL(p_file);
+    TEST_ASSERT_EQUAL_UINT(
+        sizeof(contents),
+        fwrite(contents, 1, sizeof(contents), p_file)
+    );
+    TEST_ASSERT_EQUAL_INT(0, fclose(p_file));
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_CORRUPT, estat);
+} /* test__ezq_persist_open__foreign_file__failure */
+
+/*!
+ * @brief Tests that \c ezq_persist_open refuses a file that another
+ * \c ezq_persist has open.
+ */
+static void
+test__ezq_persist_open__already_open__failure(void)
+{
+    ezq_persist persist;
+    ezq_persist other;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&other, g_path, sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_BUSY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_persist_open(&other, g_path, sizeof(unsigned int), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_persist_close(&other);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__already_open__failure */
+
+/*!
+ * @brief Tests that records are popped in the order they were pushed, and
+ * that the queue reports when it is full and when it is empty.
+ */
+static void
+test__ezq_persist_pop__fifo__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int record = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 4; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    estat = ezq_persist_push(&persist, &i);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= 4; ++i)
+    {
+        estat = ezq_persist_pop(&persist, &record);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(i, record);
+    }
+    record = 0xFF;
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0xFF, record);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_persist_count(&persist, NULL));
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_pop__fifo__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_push and \c ezq_persist_pop refuse
+ * \c NULL records.
+ */
+static void
+test__ezq_persist_push__null_record__failure(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int record = 1;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_persist_push(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_push(&persist, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+    estat = ezq_persist_pop(&persist, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_OUT, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_persist_count(&persist, NULL));
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_push__null_record__failure */
+
+/*!
+ * @brief Tests that the records left in a closed queue are popped, in
+ * order, after it is reopened.
+ */
+static void
+test__ezq_persist_open__reopen__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int record = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. The ring is wrapped before it is closed. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 6; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        if (i <= 3)
+        {
+            estat = ezq_persist_pop(&persist, &record);
+            TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        }
+    }
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(3, ezq_persist_count(&persist, NULL));
+    for (i = 4; i <= 6; ++i)
+    {
+        estat = ezq_persist_pop(&persist, &record);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(i, record);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__reopen__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_open drops the records from the first
+ * one whose checksum fails onwards.
+ */
+static void
+test__ezq_persist_open__torn_record__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int record = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. The data of the second record is changed
+     * without updating its checksum, as a torn write would leave it.
+     * */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 3; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    persist.p_ring[persist.stride + 8] ^= 0xFF;
+    crash(&persist);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_persist_count(&persist, NULL));
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, record);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__torn_record__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_open keeps valid records pushed after
+ * the stored tail, and not records left from an earlier lap of the ring.
+ */
+static void
+test__ezq_persist_open__stale_tail__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int record = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. Slot 3 still holds the record pushed at
+     * position 3 when the tail is wound back from position 7 to 5.
+     * */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < 7; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        if (i < 4)
+        {
+            estat = ezq_persist_pop(&persist, &record);
+            TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        }
+    }
+    atomic_store(&persist.p_header->tail, 5);
+    crash(&persist);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(3, ezq_persist_count(&persist, NULL));
+    for (i = 4; i < 7; ++i)
+    {
+        estat = ezq_persist_pop(&persist, &record);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(i, record);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__stale_tail__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_open skips a slot at the stored head
+ * that a later lap has reused, and keeps the records after it.
+ */
+static void
+test__ezq_persist_open__stale_head__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_persist_header header;
+    unsigned int record = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. Slot 0 is reused by the record pushed at
+     * position 4 after the header is synced, and the header page is put
+     * back as synced, as though only the ring had reached the disk.
+     * */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 100; i < 104; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    estat = ezq_persist_sync(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    memcpy(&header, persist.p_header, sizeof(header));
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(100, record);
+    estat = ezq_persist_push(&persist, &i);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    memcpy(persist.p_header, &header, sizeof(header));
+    crash(&persist);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 4, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(4, ezq_persist_count(&persist, NULL));
+    for (i = 101; i <= 104; ++i)
+    {
+        estat = ezq_persist_pop(&persist, &record);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(i, record);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_persist_pop(&persist, &record);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_open__stale_head__success */
+
+/*!
+ * @brief Tests that \c ezq_persist_push syncs the queue once every
+ * \c sync_every pushes.
+ */
+static void
+test__ezq_persist_sync__batched__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(i), 8, 3);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= 7; ++i)
+    {
+        estat = ezq_persist_push(&persist, &i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(i / 3 * 3, persist.synced_tail);
+    }
+    estat = ezq_persist_sync(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(7, persist.synced_tail);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(7, ezq_persist_count(&persist, NULL));
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_sync__batched__success */
+
+/*!
+ * @brief Tests that every record pushed by a producer thread is popped
+ * once, in order, by a consumer running at the same time.
+ */
+static void
+test__ezq_persist_pop__concurrent__success(void)
+{
+    ezq_persist persist;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producer;
+    unsigned int record = 0;
+    unsigned int expected = 1;
+
+    /* Set any initial state. */
+    estat = ezq_persist_open(&persist, g_path, sizeof(record), 64, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        pthread_create(&producer, NULL, producer_thread, &persist)
+    );
+    while (expected <= TEST_TRANSFER_COUNT)
+    {
+        if (EZQ_STATUS_SUCCESS == ezq_persist_pop(&persist, &record))
+        {
+            TEST_ASSERT_EQUAL_UINT32(expected, record);
+            ++expected;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(producer, NULL));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_persist_count(&persist, NULL));
+
+    estat = ezq_persist_close(&persist);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_persist_pop__concurrent__success */
+
+/*!
+ * @brief Runs all of the Easyqueue persistent queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_persist_open */
+    RUN_TEST(test__ezq_persist_open__new_file__success);
+    RUN_TEST(test__ezq_persist_open__zero_record_size__failure);
+    RUN_TEST(test__ezq_persist_open__different_geometry__failure);
+    RUN_TEST(test__ezq_persist_open__foreign_file__failure);
+    RUN_TEST(test__ezq_persist_open__already_open__failure);
+    RUN_TEST(test__ezq_persist_open__reopen__success);
+    RUN_TEST(test__ezq_persist_open__torn_record__success);
+    RUN_TEST(test__ezq_persist_open__stale_tail__success);
+    RUN_TEST(test__ezq_persist_open__stale_head__success);
+
+    /* ezq_persist_push / ezq_persist_pop */
+    RUN_TEST(test__ezq_persist_pop__fifo__success);
+    RUN_TEST(test__ezq_persist_push__null_record__failure);
+    RUN_TEST(test__ezq_persist_pop__concurrent__success);
+
+    /* ezq_persist_sync */
+    RUN_TEST(test__ezq_persist_sync__batched__success);
+
+    return UNITY_END();
+} /* main */
@@ -0,0 +1,549 @@
+#include <assert.h>
+#include "easyqueue_pqueue.h"
+
+#ifndef NULL
+ #define NULL ((void *)0)
+#endif /* NULL */
+
+/* Number of children of each node of the heap. */
+#define EZQ_PHEAP_ARITY (4)
+
+/* Gets the index of the parent of the entry at index i of the heap. */
+#define EZQ_PHEAP_PARENT(i) (((i) - 1) / EZQ_PHEAP_ARITY)
+
+/* Gets the index of the first child of the entry at index i of the heap. */
+#define EZQ_PHEAP_FIRST_CHILD(i) ((i) * EZQ_PHEAP_ARITY + 1)
+
+/*!
+ * @brief Determines whether one entry of the queue should be popped before
+ * another, by the queue's comparator or else by priority.
+ *
+ * @param[in] p_queue Address of the \c ezq_pqueue holding the entries.
+ * @param[in] p_a Address of the first entry.
+ * @param[in] p_b Address of the second entry.
+ *
+ * @return Non-zero if \c p_a should be popped before \c p_b , otherwise
+ * \c 0 .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static int EZQ_API
+ezq_pbefore_unsafe(
+    const ezq_pqueue * const p_queue,
+    const struct ezq_pqueue_entry * const p_a,
+    const struct ezq_pqueue_entry * const p_b
+);
+
+/*!
+ * @brief Moves the entry at \c index towards the root of the heap until its
+ * parent should be popped no later than it.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue whose heap to repair.
+ * @param[in] index Index of the entry to move.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_psift_up_unsafe(ezq_pqueue * const p_queue, unsigned int index);
+
+/*!
+ * @brief Moves the entry at \c index away from the root of the heap until
+ * none of its children should be popped before it.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue whose heap to repair.
+ * @param[in] index Index of the entry to move.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_psift_down_unsafe(ezq_pqueue * const p_queue, unsigned int index);
+
+/*!
+ * @brief Ensures the heap array can hold at least \c min_capacity entries,
+ * moving the entries into a newly allocated array of at least double the
+ * size if it cannot.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_pqueue to make room in.
+ * @param[in] min_capacity Number of entries the array must be able to hold.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the array can hold \c min_capacity
+ * entries, otherwise \c EZQ_STATUS_ALLOC_FAILURE , in which case the array
+ * is left unchanged.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_preserve_unsafe(
+    ezq_pqueue * const p_queue,
+    const unsigned int min_capacity
+);
+
+ezq_status EZQ_API
+ezq_pinit(
+    ezq_pqueue * const p_queue,
+    const unsigned int capacity,
+    int (*cmp_fn)(const void *p_a, const void *p_b),
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    p_queue->p_entries = NULL;
+    p_queue->count = 0;
+    p_queue->slot_capacity = 0;
+    p_queue->capacity = capacity;
+    p_queue->cmp_fn = cmp_fn;
+    p_queue->alloc_fn = alloc_fn;
+    p_queue->free_fn = free_fn;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_pinit */
+
+ezq_status EZQ_API
+ezq_ppush(
+    ezq_pqueue * const p_queue,
+    void * const p_item,
+    const long priority
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+    if (
+        (p_queue->capacity > 0 && p_queue->count >= p_queue->capacity)
+        || (unsigned int)-1 == p_queue->count
+    )
+    {
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    estat = ezq_preserve_unsafe(p_queue, p_queue->count + 1);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    p_queue->p_entries[p_queue->count].p_item = p_item;
+    p_queue->p_entries[p_queue->count].priority = priority;
+    ++p_queue->count;
+    ezq_psift_up_unsafe(p_queue, p_queue->count - 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ppush */
+
+unsigned int EZQ_API
+ezq_ppush_n(
+    ezq_pqueue * const p_queue,
+    void * const * const pp_items,
+    const long * const p_priorities,
+    const unsigned int count,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_status grow_estat = EZQ_STATUS_UNKNOWN;
+    unsigned int limit = count;
+    unsigned int room = 0;
+    unsigned int pushed = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_items && count > 0)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Determine how many items can be pushed, remembering why the rest (if
+     * any) cannot be.
+     * */
+    estat = EZQ_STATUS_SUCCESS;
+    room = (unsigned int)-1 - p_queue->count;
+    if (p_queue->capacity > 0)
+    {
+        room = p_queue->count < p_queue->capacity
+            ? p_queue->capacity - p_queue->count : 0;
+    }
+    if (limit > room)
+    {
+        limit = room;
+        estat = EZQ_STATUS_FULL;
+    }
+    for (i = 0; i < limit; ++i)
+    {
+        if (NULL == pp_items[i])
+        {
+            limit = i;
+            estat = EZQ_STATUS_NULL_ITEM;
+            break;
+        }
+    }
+
+    /* Grow the array once to fit every item, or else fill what room it
+     * already has.
+     * */
+    grow_estat = limit > 0
+        ? ezq_preserve_unsafe(p_queue, p_queue->count + limit)
+        : EZQ_STATUS_SUCCESS;
+    if (EZQ_STATUS_SUCCESS != grow_estat)
+    {
+        limit = p_queue->slot_capacity - p_queue->count;
+        estat = grow_estat;
+    }
+
+    for (pushed = 0; pushed < limit; ++pushed)
+    {
+        p_queue->p_entries[p_queue->count + pushed].p_item = pp_items[pushed];
+        p_queue->p_entries[p_queue->count + pushed].priority =
+            NULL == p_priorities ? 0 : p_priorities[pushed];
+    }
+    p_queue->count += pushed;
+
+    /* Rebuilding the heap bottom-up costs time linear in its size, which
+     * beats sifting up each item once the batch is as large as the heap
+     * was.
+     * */
+    if (p_queue->count > 1 && pushed >= p_queue->count - pushed)
+    {
+        for (i = EZQ_PHEAP_PARENT(p_queue->count - 1) + 1; i > 0; --i)
+        {
+            ezq_psift_down_unsafe(p_queue, i - 1);
+        }
+    }
+    else
+    {
+        for (i = p_queue->count - pushed; i < p_queue->count; ++i)
+        {
+            ezq_psift_up_unsafe(p_queue, i);
+        }
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return pushed;
+} /* ezq_ppush_n */
+
+ezq_status EZQ_API
+ezq_ppop(ezq_pqueue * const p_queue, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    /* Fill the root with the last entry and let it sink into place. */
+    *pp_item = p_queue->p_entries[0].p_item;
+    --p_queue->count;
+    if (p_queue->count > 0)
+    {
+        p_queue->p_entries[0] = p_queue->p_entries[p_queue->count];
+        ezq_psift_down_unsafe(p_queue, 0);
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ppop */
+
+ezq_status EZQ_API
+ezq_ppeek(const ezq_pqueue * const p_queue, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    *pp_item = p_queue->p_entries[0].p_item;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_ppeek */
+
+unsigned int EZQ_API
+ezq_pcount(const ezq_pqueue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    count = p_queue->count;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_pcount */
+
+ezq_status EZQ_API
+ezq_pdestroy(
+    ezq_pqueue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL != p_queue->p_entries && NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    for (i = 0; NULL != item_cleanup_fn && i < p_queue->count; ++i)
+    {
+        item_cleanup_fn(p_queue->p_entries[i].p_item, p_args);
+    }
+    if (NULL != p_queue->p_entries)
+    {
+        p_queue->free_fn(p_queue->p_entries);
+    }
+
+    p_queue->p_entries = NULL;
+    p_queue->count = 0;
+    p_queue->slot_capacity = 0;
+    p_queue->capacity = 0;
+    p_queue->cmp_fn = NULL;
+    p_queue->alloc_fn = NULL;
+    p_queue->free_fn = NULL;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_pdestroy */
+
+static int EZQ_API
+ezq_pbefore_unsafe(
+    const ezq_pqueue * const p_queue,
+    const struct ezq_pqueue_entry * const p_a,
+    const struct ezq_pqueue_entry * const p_b
+)
+{
+    assert(NULL != p_queue);
+    assert(NULL != p_a);
+    assert(NULL != p_b);
+
+    return NULL == p_queue->cmp_fn
+        ? p_a->priority < p_b->priority
+        : p_queue->cmp_fn(p_a->p_item, p_b->p_item) < 0;
+} /* ezq_pbefore_unsafe */
+
+static void EZQ_API
+ezq_psift_up_unsafe(ezq_pqueue * const p_queue, unsigned int index)
+{
+    struct ezq_pqueue_entry entry;
+    unsigned int parent = 0;
+
+    assert(NULL != p_queue);
+    assert(index < p_queue->count);
+
+    /* Move parents down into the hole rather than swapping at each level,
+     * and place the entry once its position is known.
+     * */
+    entry = p_queue->p_entries[index];
+    while (index > 0)
+    {
+        parent = EZQ_PHEAP_PARENT(index);
+        if (!ezq_pbefore_unsafe(p_queue, &entry, &p_queue->p_entries[parent]))
+        {
+            break;
+        }
+        p_queue->p_entries[index] = p_queue->p_entries[parent];
+        index = parent;
+    }
+    p_queue->p_entries[index] = entry;
+} /* ezq_psift_up_unsafe */
+
+static void EZQ_API
+ezq_psift_down_unsafe(ezq_pqueue * const p_queue, unsigned int index)
+{
+    struct ezq_pqueue_entry entry;
+    unsigned int first = 0;
+    unsigned int last = 0;
+    unsigned int best = 0;
+    unsigned int child = 0;
+
+    assert(NULL != p_queue);
+    assert(index < p_queue->count);
+
+    /* The children of an entry are adjacent, so finding the one to pop
+     * first touches a single run of the array.
+     * */
+    entry = p_queue->p_entries[index];
+    while (
+        p_queue->count > 1
+        && index <= EZQ_PHEAP_PARENT(p_queue->count - 1)
+    )
+    {
+        first = EZQ_PHEAP_FIRST_CHILD(index);
+        last = p_queue->count - first < EZQ_PHEAP_ARITY
+            ? p_queue->count : first + EZQ_PHEAP_ARITY;
+        best = first;
+        for (child = first + 1; child < last; ++child)
+        {
+            if (
+                ezq_pbefore_unsafe(
+                    p_queue,
+                    &p_queue->p_entries[child],
+                    &p_queue->p_entries[best]
+                )
+            )
+            {
+                best = child;
+            }
+        }
+        if (!ezq_pbefore_unsafe(p_queue, &p_queue->p_entries[best], &entry))
+        {
+            break;
+        }
+        p_queue->p_entries[index] = p_queue->p_entries[best];
+        index = best;
+    }
+    p_queue->p_entries[index] = entry;
+} /* ezq_psift_down_unsafe */
+
+static ezq_status EZQ_API
+ezq_preserve_unsafe(
+    ezq_pqueue * const p_queue,
+    const unsigned int min_capacity
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_pqueue_entry * p_new = NULL;
+    unsigned int new_capacity = 0;
+    size_t size = 0;
+    unsigned int i = 0;
+
+    assert(NULL != p_queue);
+    assert(min_capacity >= p_queue->count);
+
+    estat = EZQ_STATUS_SUCCESS;
+    if (min_capacity <= p_queue->slot_capacity)
+    {
+        goto done;
+    }
+
+    new_capacity = 0 == p_queue->slot_capacity
+        ? EZQ_PQUEUE_MIN_SLOTS : p_queue->slot_capacity;
+    while (new_capacity < min_capacity)
+    {
+        new_capacity = new_capacity > (unsigned int)-1 / 2
+            ? min_capacity : new_capacity * 2;
+    }
+
+    /* Guard against the size calculation wrapping on narrow targets. */
+    size = (size_t)new_capacity * sizeof(*p_new);
+    if (size / sizeof(*p_new) != new_capacity)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    p_new = (struct ezq_pqueue_entry *)p_queue->alloc_fn(size);
+    if (NULL == p_new)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    for (i = 0; i < p_queue->count; ++i)
+    {
+        p_new[i] = p_queue->p_entries[i];
+    }
+    if (NULL != p_queue->p_entries)
+    {
+        p_queue->free_fn(p_queue->p_entries);
+    }
+
+    p_queue->p_entries = p_new;
+    p_queue->slot_capacity = new_capacity;
+
+done:
+    return estat;
+} /* ezq_preserve_unsafe */
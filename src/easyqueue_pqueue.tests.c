@@ -0,0 +1,459 @@
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_pqueue.h"
+
+/* Number of items placed in the queues of the ordering tests. */
+#define TEST_ITEM_COUNT (100)
+
+unsigned int g_alloc_count; /* number of calls made to custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global allocation counters.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_count = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of calls made to it and allocates with
+ * \c malloc() .
+ *
+ * @param[in] size Number of bytes to allocate.
+ *
+ * @return The allocated address.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases with
+ * \c free() .
+ *
+ * @param[in] ptr Address to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Orders items pointing to \c long values from greatest to least.
+ *
+ * @param[in] p_a Address of the first value.
+ * @param[in] p_b Address of the second value.
+ *
+ * @return A negative value if \c p_a is greater than \c p_b , a positive
+ * value if it is less, otherwise \c 0 .
+ */
+static int
+custom_cmp_fn(const void *p_a, const void *p_b)
+{
+    const long a = *(const long *)p_a;
+    const long b = *(const long *)p_b;
+
+    return a > b ? -1 : a < b ? 1 : 0;
+}
+
+/*!
+ * @brief Pops every item of a queue whose items point to \c long values,
+ * asserting that each is popped in order.
+ *
+ * @param[in,out] p_queue Address of the queue to empty.
+ * @param[in] count Number of items expected in the queue.
+ * @param[in] descending Non-zero if values should be popped greatest first.
+ */
+static void
+assert_pops_in_order(
+    ezq_pqueue * const p_queue,
+    const unsigned int count,
+    const int descending
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long *p_prev = NULL;
+    long *p_item = NULL;
+    unsigned int i = 0;
+
+    for (i = 0; i < count; ++i)
+    {
+        estat = ezq_ppop(p_queue, (void **)&p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        if (NULL != p_prev)
+        {
+            TEST_ASSERT_TRUE(
+                descending ? *p_prev >= *p_item : *p_prev <= *p_item
+            );
+        }
+        p_prev = p_item;
+    }
+    estat = ezq_ppop(p_queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+}
+
+/*!
+ * @brief Tests that \c ezq_pinit initializes a queue without allocating.
+ */
+static void
+test__ezq_pinit__standard__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NULL(queue.p_entries);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.slot_capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_pcount(&queue, NULL));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_pinit__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_pinit fails when given no allocation function.
+ */
+static void
+test__ezq_pinit__no_alloc_fn__failure(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pinit(&queue, 0, NULL, NULL, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NO_ALLOC_FN, estat);
+} /* test__ezq_pinit__no_alloc_fn__failure */
+
+/*!
+ * @brief Tests that \c ezq_ppush places items such that they are popped in
+ * order of priority, growing the heap array as needed.
+ */
+static void
+test__ezq_ppush__priority_order__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[TEST_ITEM_COUNT];
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_ITEM_COUNT; ++i)
+    {
+        values[i] = (long)(i * 37 % TEST_ITEM_COUNT) - TEST_ITEM_COUNT / 2;
+        estat = ezq_ppush(&queue, &values[i], values[i]);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(TEST_ITEM_COUNT, ezq_pcount(&queue, NULL));
+    TEST_ASSERT_TRUE(queue.slot_capacity >= TEST_ITEM_COUNT);
+    assert_pops_in_order(&queue, TEST_ITEM_COUNT, 0);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+} /* test__ezq_ppush__priority_order__success */
+
+/*!
+ * @brief Tests that \c ezq_ppush orders items by the queue's comparator
+ * rather than by their priorities when it has one.
+ */
+static void
+test__ezq_ppush__comparator__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[TEST_ITEM_COUNT];
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(
+        &queue,
+        0,
+        custom_cmp_fn,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_ITEM_COUNT; ++i)
+    {
+        values[i] = (long)(i * 37 % TEST_ITEM_COUNT);
+        estat = ezq_ppush(&queue, &values[i], values[i]);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    assert_pops_in_order(&queue, TEST_ITEM_COUNT, 1);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_ppush__comparator__success */
+
+/*!
+ * @brief Tests that \c ezq_ppush fails when the queue is at capacity.
+ */
+static void
+test__ezq_ppush__capacity_full__failure(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long value = 0;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 1, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_ppush(&queue, &value, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ppush(&queue, &value, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_pcount(&queue, NULL));
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_ppush__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_ppush_n orders both a batch larger than the
+ * queue, which rebuilds the heap, and a smaller batch, which is placed an
+ * item at a time.
+ */
+static void
+test__ezq_ppush_n__heapify__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[TEST_ITEM_COUNT];
+    void *items[TEST_ITEM_COUNT];
+    unsigned int pushed = 0;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < TEST_ITEM_COUNT; ++i)
+    {
+        values[i] = (long)(i * 61 % TEST_ITEM_COUNT);
+        items[i] = &values[i];
+    }
+    estat = ezq_ppush(&queue, &values[0], values[0]);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_ppush_n(
+        &queue,
+        &items[1],
+        &values[1],
+        TEST_ITEM_COUNT - 11,
+        &estat
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(TEST_ITEM_COUNT - 11, pushed);
+    pushed = ezq_ppush_n(
+        &queue,
+        &items[TEST_ITEM_COUNT - 10],
+        &values[TEST_ITEM_COUNT - 10],
+        10,
+        &estat
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(10, pushed);
+    TEST_ASSERT_EQUAL_UINT32(TEST_ITEM_COUNT, ezq_pcount(&queue, NULL));
+    assert_pops_in_order(&queue, TEST_ITEM_COUNT, 0);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_ppush_n__heapify__success */
+
+/*!
+ * @brief Tests that \c ezq_ppush_n places only the items that fit when the
+ * batch would exceed the queue's capacity.
+ */
+static void
+test__ezq_ppush_n__capacity_full__failure(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[3] = { 3, 1, 2 };
+    void *items[3];
+    unsigned int pushed = 0;
+    long *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 2, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    items[0] = &values[0];
+    items[1] = &values[1];
+    items[2] = &values[2];
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    pushed = ezq_ppush_n(&queue, items, values, 3, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, pushed);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_ppop(&queue, (void **)&p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&values[1], p_item);
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_ppush_n__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_ppop fails on an empty queue.
+ */
+static void
+test__ezq_ppop__empty__failure(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ppop(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_NULL(p_item);
+} /* test__ezq_ppop__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_ppeek retrieves the item of lowest priority
+ * without removing it.
+ */
+static void
+test__ezq_ppeek__standard__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[2] = { 5, -5 };
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_ppush(&queue, &values[0], values[0]);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_ppush(&queue, &values[1], values[1]);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_ppeek(&queue, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&values[1], p_item);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(2, ezq_pcount(&queue, NULL));
+    estat = ezq_pdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_ppeek__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_pdestroy invokes the cleanup function on each
+ * remaining item and releases the heap array.
+ */
+static void
+test__ezq_pdestroy__non_null_cleanup_fn__success(void)
+{
+    ezq_pqueue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    long values[3] = { 0 };
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_pinit(&queue, 0, NULL, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < 3; ++i)
+    {
+        estat = ezq_ppush(&queue, &values[i], (long)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pdestroy(&queue, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(queue.p_entries);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.count);
+} /* test__ezq_pdestroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue priority queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_pinit */
+    RUN_TEST(test__ezq_pinit__standard__success);
+    RUN_TEST(test__ezq_pinit__no_alloc_fn__failure);
+
+    /* ezq_ppush */
+    RUN_TEST(test__ezq_ppush__priority_order__success);
+    RUN_TEST(test__ezq_ppush__comparator__success);
+    RUN_TEST(test__ezq_ppush__capacity_full__failure);
+
+    /* ezq_ppush_n */
+    RUN_TEST(test__ezq_ppush_n__heapify__success);
+    RUN_TEST(test__ezq_ppush_n__capacity_full__failure);
+
+    /* ezq_ppop */
+    RUN_TEST(test__ezq_ppop__empty__failure);
+
+    /* ezq_ppeek */
+    RUN_TEST(test__ezq_ppeek__standard__success);
+
+    /* ezq_pdestroy */
+    RUN_TEST(test__ezq_pdestroy__non_null_cleanup_fn__success);
+
+    (void)argc;
+    (void)argv;
+    return UNITY_END();
+} /* main */
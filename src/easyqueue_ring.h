@@ -0,0 +1,34 @@
+#ifndef EASYQUEUE_RING_H
+#define EASYQUEUE_RING_H
+
+#include <assert.h>
+
+/* The largest capacity a ring indexed by free-running unsigned int counters
+ * can be rounded up to; beyond this the difference between two counters
+ * could no longer tell a full ring from an empty one.
+ */
+#define EZQ_RING_MAX_CAPACITY (((unsigned int)-1 >> 1) + 1)
+
+/*!
+ * @brief Rounds \c value up to the next power of two.
+ *
+ * @param[in] value Non-zero value no greater than \c EZQ_RING_MAX_CAPACITY .
+ *
+ * @return The smallest power of two no less than \c value .
+ */
+static inline unsigned int
+ezq_ring_round_pow2(const unsigned int value)
+{
+    unsigned int pow2 = 1;
+
+    assert(value > 0 && value <= EZQ_RING_MAX_CAPACITY);
+
+    while (pow2 < value)
+    {
+        pow2 <<= 1;
+    }
+
+    return pow2;
+} /* ezq_ring_round_pow2 */
+
+#endif /* EASYQUEUE_RING_H */
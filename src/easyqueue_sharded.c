@@ -0,0 +1,289 @@
+#define _GNU_SOURCE
+#include <assert.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "easyqueue_sharded.h"
+
+/* Source of the thread slots handed out by ezq_sharded_home_unsafe. */
+static atomic_uint g_next_thread_slot;
+
+/* Slot of the calling thread, plus one, or zero until it is first needed. */
+static _Thread_local unsigned int g_thread_slot = 0;
+
+/*!
+ * @brief Gets the index of the calling thread's home shard.
+ *
+ * @param[in] p_sharded Address of the \c ezq_sharded to get the home shard
+ * of.
+ *
+ * @return The index of the shard of the CPU the calling thread is running
+ * on or, with \c EZQ_SHARDED_BY_THREAD or where the CPU is not known, of
+ * the shard matching the calling thread's slot.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static unsigned int EZQ_API
+ezq_sharded_home_unsafe(const ezq_sharded * const p_sharded);
+
+ezq_status EZQ_API
+ezq_sharded_init(
+    ezq_sharded * const p_sharded,
+    ezq_mpmc * const p_shards,
+    const unsigned int shard_count,
+    const unsigned int capacity,
+    const unsigned int flags,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_sharded || NULL == p_shards)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == shard_count)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    for (i = 0; i < shard_count; ++i)
+    {
+        estat = ezq_mpmc_init(&p_shards[i], capacity, alloc_fn, free_fn);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            while (i > 0)
+            {
+                (void)ezq_mpmc_destroy(&p_shards[--i], NULL, NULL);
+            }
+            goto done;
+        }
+    }
+
+    p_sharded->p_shards = p_shards;
+    p_sharded->shard_count = shard_count;
+    p_sharded->flags = flags;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_sharded_init */
+
+unsigned int EZQ_API
+ezq_sharded_home(
+    const ezq_sharded * const p_sharded,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int home = 0;
+
+    if (NULL == p_sharded)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == p_sharded->shard_count)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    home = ezq_sharded_home_unsafe(p_sharded);
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return home;
+} /* ezq_sharded_home */
+
+unsigned int EZQ_API
+ezq_sharded_count(
+    const ezq_sharded * const p_sharded,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_sharded)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    for (i = 0; i < p_sharded->shard_count; ++i)
+    {
+        count += ezq_mpmc_count(&p_sharded->p_shards[i], NULL);
+    }
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_sharded_count */
+
+ezq_status EZQ_API
+ezq_sharded_push(ezq_sharded * const p_sharded, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int shard = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_sharded || 0 == p_sharded->shard_count)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Only spill over into the other shards when the home shard is full,
+     * so that producers on different CPUs keep to their own cache lines.
+     * */
+    shard = ezq_sharded_home_unsafe(p_sharded);
+    for (i = 0; i < p_sharded->shard_count; ++i)
+    {
+        estat = ezq_mpmc_push(&p_sharded->p_shards[shard], p_item);
+        if (EZQ_STATUS_FULL != estat)
+        {
+            goto done;
+        }
+        if (++shard == p_sharded->shard_count)
+        {
+            shard = 0;
+        }
+    }
+
+done:
+    return estat;
+} /* ezq_sharded_push */
+
+ezq_status EZQ_API
+ezq_sharded_pop(ezq_sharded * const p_sharded, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int shard = 0;
+    unsigned int i = 0;
+
+    if (NULL == p_sharded || 0 == p_sharded->shard_count)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Sweeping on from each consumer's own home shard, rather than from
+     * the first shard, spreads consumers that find their shards empty over
+     * different victims.
+     * */
+    shard = ezq_sharded_home_unsafe(p_sharded);
+    for (i = 0; i < p_sharded->shard_count; ++i)
+    {
+        estat = ezq_mpmc_pop(&p_sharded->p_shards[shard], pp_item);
+        if (EZQ_STATUS_EMPTY != estat)
+        {
+            goto done;
+        }
+        if (++shard == p_sharded->shard_count)
+        {
+            shard = 0;
+        }
+    }
+
+done:
+    return estat;
+} /* ezq_sharded_pop */
+
+ezq_status EZQ_API
+ezq_sharded_destroy(
+    ezq_sharded * const p_sharded,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    if (NULL == p_sharded)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    for (i = 0; i < p_sharded->shard_count; ++i)
+    {
+        estat = ezq_mpmc_destroy(
+            &p_sharded->p_shards[i],
+            item_cleanup_fn,
+            p_args
+        );
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+
+    p_sharded->p_shards = NULL;
+    p_sharded->shard_count = 0;
+    p_sharded->flags = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_sharded_destroy */
+
+static unsigned int EZQ_API
+ezq_sharded_home_unsafe(const ezq_sharded * const p_sharded)
+{
+    int cpu = -1;
+
+    assert(NULL != p_sharded);
+    assert(p_sharded->shard_count > 0);
+
+#if defined(__linux__)
+    /* On most architectures sched_getcpu is answered from the vDSO, so
+     * this costs no system call.
+     * */
+    if (0 == (p_sharded->flags & EZQ_SHARDED_BY_THREAD))
+    {
+        cpu = sched_getcpu();
+    }
+#endif /* __linux__ */
+
+    /* Consecutive slots go to threads in the order they first use a
+     * sharded queue, so that up to shard_count threads get a shard each.
+     * */
+    if (cpu < 0 && 0 == g_thread_slot)
+    {
+        g_thread_slot = atomic_fetch_add_explicit(
+            &g_next_thread_slot,
+            1,
+            memory_order_relaxed
+        ) + 1;
+    }
+
+    return cpu >= 0
+        ? (unsigned int)cpu % p_sharded->shard_count
+        : (g_thread_slot - 1) % p_sharded->shard_count;
+} /* ezq_sharded_home_unsafe */
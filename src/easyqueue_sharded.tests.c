@@ -0,0 +1,604 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_sharded.h"
+
+#define TEST_SHARD_COUNT (4)
+#define TEST_THREAD_COUNT (4)
+#define TEST_TRANSFER_COUNT (100000u)
+
+unsigned int g_alloc_count; /* number of rings handed out */
+unsigned int g_alloc_limit; /* number of rings to hand out before failing */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/* number of times each value was popped from the queue by any thread */
+atomic_uchar g_taken[TEST_TRANSFER_COUNT + 1];
+
+/*!
+ * @brief Resets the global dummy allocation state.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_count = 0;
+    g_alloc_limit = 0xFFFFFFFFu;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Allocates memory with \c malloc until \c g_alloc_limit rings
+ * have been handed out.
+ *
+ * @param[in] size Number of bytes requested.
+ *
+ * @return The allocated memory, or \c NULL once the limit is reached.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    if (g_alloc_count >= g_alloc_limit)
+    {
+        return NULL;
+    }
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases \c ptr .
+ *
+ * @param[in] ptr Memory to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @struct home_args
+ * @brief Structure describing the work of a \c home_thread .
+ */
+struct home_args
+{
+    const ezq_sharded *p_sharded; /* queue to get the home shard of */
+    unsigned int home; /* home shard of the thread */
+};
+
+/*!
+ * @brief Gets the home shard of the calling thread.
+ *
+ * @param[in,out] p_arg Address of a \c home_args structure.
+ *
+ * @return \c NULL
+ */
+static void *
+home_thread(void *p_arg)
+{
+    struct home_args *p_args = p_arg;
+
+    p_args->home = ezq_sharded_home(p_args->p_sharded, NULL);
+
+    return NULL;
+}
+
+/*!
+ * @struct transfer_args
+ * @brief Structure describing the work of a \c producer_thread or
+ * \c consumer_thread .
+ */
+struct transfer_args
+{
+    ezq_sharded *p_sharded; /* queue to transfer through */
+    uintptr_t first; /* first value for a producer to push */
+    atomic_uint *p_popped; /* number of values popped by all consumers */
+};
+
+/*!
+ * @brief Pushes every \c TEST_THREAD_COUNT th value, starting from the
+ * passed first value, retrying while the queue is full.
+ *
+ * @param[in,out] p_arg Address of a \c transfer_args structure.
+ *
+ * @return \c NULL
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    struct transfer_args *p_args = p_arg;
+    uintptr_t i = 0;
+
+    for (i = p_args->first; i <= TEST_TRANSFER_COUNT; i += TEST_THREAD_COUNT)
+    {
+        while (EZQ_STATUS_SUCCESS != ezq_sharded_push(p_args->p_sharded,
+                                                      (void *)i))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Pops values from the queue until every value has been popped by
+ * one consumer or another.
+ *
+ * @param[in,out] p_arg Address of a \c transfer_args structure.
+ *
+ * @return \c NULL
+ */
+static void *
+consumer_thread(void *p_arg)
+{
+    struct transfer_args *p_args = p_arg;
+    void *p_item = NULL;
+
+    while (atomic_load(p_args->p_popped) < TEST_TRANSFER_COUNT)
+    {
+        if (EZQ_STATUS_SUCCESS == ezq_sharded_pop(p_args->p_sharded, &p_item))
+        {
+            atomic_fetch_add(&g_taken[(uintptr_t)p_item], 1);
+            atomic_fetch_add(p_args->p_popped, 1);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_sharded_init initializes every shard, leaving
+ * the queue empty.
+ */
+static void
+test__ezq_sharded_init__standard__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        3,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_sharded_count(&sharded, &estat));
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(ezq_sharded_home(&sharded, &estat) < TEST_SHARD_COUNT);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < TEST_SHARD_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT32(4, ezq_mpmc_capacity(&shards[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT(TEST_SHARD_COUNT, g_alloc_count);
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(TEST_SHARD_COUNT, g_free_count);
+} /* test__ezq_sharded_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_sharded_init fails when given no shards.
+ */
+static void
+test__ezq_sharded_init__zero_shards__failure(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[1];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        0,
+        4,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_sharded_init__zero_shards__failure */
+
+/*!
+ * @brief Tests that \c ezq_sharded_init releases the shards it already
+ * initialized when a later one cannot be allocated.
+ */
+static void
+test__ezq_sharded_init__alloc_failure__failure(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    g_alloc_limit = TEST_SHARD_COUNT - 1;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        4,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT(TEST_SHARD_COUNT - 1, g_alloc_count);
+    TEST_ASSERT_EQUAL_UINT(TEST_SHARD_COUNT - 1, g_free_count);
+} /* test__ezq_sharded_init__alloc_failure__failure */
+
+/*!
+ * @brief Tests that \c ezq_sharded_home gives each thread its own shard
+ * with \c EZQ_SHARDED_BY_THREAD , and keeps giving a thread the same one.
+ */
+static void
+test__ezq_sharded_home__by_thread__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[2];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t thread;
+    struct home_args args;
+    unsigned int home = 0;
+
+    /* Set any initial state. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        2,
+        4,
+        EZQ_SHARDED_BY_THREAD,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome.
+     * The next thread to use a sharded queue is handed the next slot, and
+     * so the other of the two shards.
+     * */
+    home = ezq_sharded_home(&sharded, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(home, ezq_sharded_home(&sharded, NULL));
+    args.p_sharded = &sharded;
+    args.home = home;
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        pthread_create(&thread, NULL, home_thread, &args)
+    );
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    TEST_ASSERT_EQUAL_UINT32(1 - home, args.home);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(home, ezq_sharded_home(&sharded, NULL));
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sharded_home__by_thread__success */
+
+/*!
+ * @brief Tests that \c ezq_sharded_push places items on the home shard
+ * until it is full, then on the shards after it, and fails once every shard
+ * is full.
+ */
+static void
+test__ezq_sharded_push__spill__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int home = 0;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        2,
+        EZQ_SHARDED_BY_THREAD,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    home = ezq_sharded_home(&sharded, NULL);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= 2; ++i)
+    {
+        estat = ezq_sharded_push(&sharded, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, ezq_mpmc_count(&shards[home], NULL));
+    TEST_ASSERT_EQUAL_UINT32(2, ezq_sharded_count(&sharded, NULL));
+
+    estat = ezq_sharded_push(&sharded, (void *)3);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        1,
+        ezq_mpmc_count(&shards[(home + 1) % TEST_SHARD_COUNT], NULL)
+    );
+
+    for (i = 4; i <= 2 * TEST_SHARD_COUNT; ++i)
+    {
+        estat = ezq_sharded_push(&sharded, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    estat = ezq_sharded_push(&sharded, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(
+        2 * TEST_SHARD_COUNT,
+        ezq_sharded_count(&sharded, NULL)
+    );
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sharded_push__spill__success */
+
+/*!
+ * @brief Tests that \c ezq_sharded_push refuses a \c NULL item.
+ */
+static void
+test__ezq_sharded_push__null_item__failure(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        4,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sharded_push(&sharded, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_sharded_count(&sharded, NULL));
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sharded_push__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_sharded_pop drains the home shard first, then
+ * the other shards in turn, and reports when every shard is empty.
+ */
+static void
+test__ezq_sharded_pop__sweep__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    unsigned int home = 0;
+    uintptr_t i = 0;
+
+    /* Set any initial state. Each shard holds the value of its distance
+     * after the home shard, plus one.
+     * */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        4,
+        EZQ_SHARDED_BY_THREAD,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    home = ezq_sharded_home(&sharded, NULL);
+    for (i = TEST_SHARD_COUNT; i >= 1; --i)
+    {
+        estat = ezq_mpmc_push(
+            &shards[(home + i - 1) % TEST_SHARD_COUNT],
+            (void *)i
+        );
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= TEST_SHARD_COUNT; ++i)
+    {
+        estat = ezq_sharded_pop(&sharded, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    p_item = (void *)0xFF;
+    estat = ezq_sharded_pop(&sharded, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xFF, p_item);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_sharded_count(&sharded, NULL));
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sharded_pop__sweep__success */
+
+/*!
+ * @brief Tests that every value pushed by concurrently running producers
+ * is popped exactly once by concurrently running consumers, with each
+ * thread using the shard of the CPU it runs on.
+ */
+static void
+test__ezq_sharded_pop__concurrent__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producers[TEST_THREAD_COUNT];
+    pthread_t consumers[TEST_THREAD_COUNT];
+    struct transfer_args args[TEST_THREAD_COUNT];
+    atomic_uint popped;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        64,
+        0,
+        malloc,
+        free
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    atomic_init(&popped, 0);
+    for (i = 0; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        atomic_init(&g_taken[i], 0);
+    }
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        args[i].p_sharded = &sharded;
+        args[i].first = i + 1;
+        args[i].p_popped = &popped;
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&consumers[i], NULL, consumer_thread, &args[i])
+        );
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&producers[i], NULL, producer_thread, &args[i])
+        );
+    }
+    for (i = 0; i < TEST_THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(consumers[i], NULL));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_sharded_count(&sharded, NULL));
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT8(1, atomic_load(&g_taken[i]));
+    }
+
+    estat = ezq_sharded_destroy(&sharded, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_sharded_pop__concurrent__success */
+
+/*!
+ * @brief Tests that \c ezq_sharded_destroy invokes the cleanup function on
+ * each remaining item of every shard and releases every ring.
+ */
+static void
+test__ezq_sharded_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_sharded sharded;
+    ezq_mpmc shards[TEST_SHARD_COUNT];
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_sharded_init(
+        &sharded,
+        shards,
+        TEST_SHARD_COUNT,
+        1,
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 3; ++i)
+    {
+        estat = ezq_sharded_push(&sharded, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_sharded_destroy(&sharded, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(TEST_SHARD_COUNT, g_free_count);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_sharded_count(&sharded, NULL));
+} /* test__ezq_sharded_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue sharded queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_sharded_init */
+    RUN_TEST(test__ezq_sharded_init__standard__success);
+    RUN_TEST(test__ezq_sharded_init__zero_shards__failure);
+    RUN_TEST(test__ezq_sharded_init__alloc_failure__failure);
+
+    /* ezq_sharded_home */
+    RUN_TEST(test__ezq_sharded_home__by_thread__success);
+
+    /* ezq_sharded_push */
+    RUN_TEST(test__ezq_sharded_push__spill__success);
+    RUN_TEST(test__ezq_sharded_push__null_item__failure);
+
+    /* ezq_sharded_pop */
+    RUN_TEST(test__ezq_sharded_pop__sweep__success);
+    RUN_TEST(test__ezq_sharded_pop__concurrent__success);
+
+    /* ezq_sharded_destroy */
+    RUN_TEST(test__ezq_sharded_destroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
@@ -0,0 +1,246 @@
+#include "easyqueue_spsc.h"
+#include "easyqueue_ring.h"
+
+ezq_status EZQ_API
+ezq_spsc_init(
+    ezq_spsc * const p_spsc,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int slot_capacity = 0;
+    size_t size = 0;
+    void ** p_slots = NULL;
+    unsigned int i = 0;
+
+    if (NULL == p_spsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == capacity || capacity > EZQ_RING_MAX_CAPACITY)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    if (NULL == alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    slot_capacity = ezq_ring_round_pow2(capacity);
+    size = (size_t)slot_capacity * sizeof(*p_slots);
+    if (size / sizeof(*p_slots) != slot_capacity)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    p_slots = alloc_fn(size);
+    if (NULL == p_slots)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < slot_capacity; ++i)
+    {
+        p_slots[i] = NULL;
+    }
+
+    p_spsc->p_slots = p_slots;
+    p_spsc->mask = slot_capacity - 1;
+    p_spsc->free_fn = free_fn;
+    atomic_init(&p_spsc->tail, 0);
+    p_spsc->cached_head = 0;
+    atomic_init(&p_spsc->head, 0);
+    p_spsc->cached_tail = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_spsc_init */
+
+unsigned int EZQ_API
+ezq_spsc_capacity(const ezq_spsc * const p_spsc)
+{
+    return NULL == p_spsc || NULL == p_spsc->p_slots ? 0 : p_spsc->mask + 1;
+} /* ezq_spsc_capacity */
+
+unsigned int EZQ_API
+ezq_spsc_count(const ezq_spsc * const p_spsc, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+    unsigned int count = 0;
+
+    if (NULL == p_spsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* Reading the head first means the tail read afterwards can only be
+     * newer, so the difference is never negative; it may however exceed
+     * the capacity if the consumer moved on in between.
+     * */
+    head = atomic_load_explicit(&p_spsc->head, memory_order_acquire);
+    tail = atomic_load_explicit(&p_spsc->tail, memory_order_acquire);
+    count = tail - head;
+    if (NULL != p_spsc->p_slots && count > p_spsc->mask + 1)
+    {
+        count = p_spsc->mask + 1;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_spsc_count */
+
+ezq_status EZQ_API
+ezq_spsc_push(ezq_spsc * const p_spsc, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int tail = 0;
+
+    if (NULL == p_spsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Only the producer writes the tail, so it can be read relaxed. The
+     * consumer's head is only read (with acquire ordering, so that its
+     * reads of the freed slots have completed) once the cached copy says
+     * the ring is full.
+     * */
+    tail = atomic_load_explicit(&p_spsc->tail, memory_order_relaxed);
+    if (tail - p_spsc->cached_head > p_spsc->mask)
+    {
+        p_spsc->cached_head = atomic_load_explicit(
+            &p_spsc->head,
+            memory_order_acquire
+        );
+        if (tail - p_spsc->cached_head > p_spsc->mask)
+        {
+            estat = EZQ_STATUS_FULL;
+            goto done;
+        }
+    }
+
+    p_spsc->p_slots[tail & p_spsc->mask] = p_item;
+    atomic_store_explicit(&p_spsc->tail, tail + 1, memory_order_release);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_spsc_push */
+
+ezq_status EZQ_API
+ezq_spsc_pop(ezq_spsc * const p_spsc, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+
+    if (NULL == p_spsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Mirrors ezq_spsc_push: the producer's tail is only re-read once the
+     * cached copy says the ring is empty.
+     * */
+    head = atomic_load_explicit(&p_spsc->head, memory_order_relaxed);
+    if (head == p_spsc->cached_tail)
+    {
+        p_spsc->cached_tail = atomic_load_explicit(
+            &p_spsc->tail,
+            memory_order_acquire
+        );
+        if (head == p_spsc->cached_tail)
+        {
+            estat = EZQ_STATUS_EMPTY;
+            goto done;
+        }
+    }
+
+    *pp_item = p_spsc->p_slots[head & p_spsc->mask];
+    atomic_store_explicit(&p_spsc->head, head + 1, memory_order_release);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_spsc_pop */
+
+ezq_status EZQ_API
+ezq_spsc_destroy(
+    ezq_spsc * const p_spsc,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+
+    if (NULL == p_spsc)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    if (NULL != p_spsc->p_slots)
+    {
+        head = atomic_load_explicit(&p_spsc->head, memory_order_acquire);
+        tail = atomic_load_explicit(&p_spsc->tail, memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            if (NULL != item_cleanup_fn)
+            {
+                item_cleanup_fn(p_spsc->p_slots[head & p_spsc->mask], p_args);
+            }
+        }
+
+        p_spsc->free_fn(p_spsc->p_slots);
+    }
+
+    p_spsc->p_slots = NULL;
+    p_spsc->mask = 0;
+    p_spsc->free_fn = NULL;
+    atomic_store_explicit(&p_spsc->tail, 0, memory_order_relaxed);
+    p_spsc->cached_head = 0;
+    atomic_store_explicit(&p_spsc->head, 0, memory_order_relaxed);
+    p_spsc->cached_tail = 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_spsc_destroy */
@@ -0,0 +1,402 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_spsc.h"
+
+#define TEST_SLOT_CAPACITY (8)
+#define TEST_TRANSFER_COUNT (100000u)
+
+void *g_slots[TEST_SLOT_CAPACITY]; /* ring handed out by custom_alloc_fn */
+size_t g_alloc_size; /* size last requested from custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global dummy allocation state.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    unsigned int i = 0;
+
+    for (i = 0; i < TEST_SLOT_CAPACITY; ++i)
+    {
+        g_slots[i] = (void *)0xAA;
+    }
+    g_alloc_size = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Returns the global dummy ring if it is large enough.
+ *
+ * @param[in] size Number of bytes requested.
+ *
+ * @return The address of the global dummy ring, or \c NULL if \c size
+ * exceeds its size.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    g_alloc_size = size;
+    return size <= sizeof(g_slots) ? g_slots : NULL;
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] ptr UNUSED
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    (void)ptr;
+    ++g_free_count;
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Pushes \c TEST_TRANSFER_COUNT sequentially numbered items onto the
+ * passed queue, yielding and retrying whenever it is full.
+ *
+ * @param[in,out] p_arg Address of an \c ezq_spsc to push onto.
+ *
+ * @return \c NULL
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    ezq_spsc *p_spsc = p_arg;
+    uintptr_t i = 0;
+
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        while (EZQ_STATUS_SUCCESS != ezq_spsc_push(p_spsc, (void *)i))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_spsc_init rounds the capacity up to a power of
+ * two and allocates a ring of that many empty slots.
+ */
+static void
+test__ezq_spsc_init__standard__success(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int i = 0;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY - 1,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(g_slots, spsc.p_slots);
+    TEST_ASSERT_EQUAL_UINT(sizeof(g_slots), g_alloc_size);
+    TEST_ASSERT_EQUAL_UINT32(TEST_SLOT_CAPACITY, ezq_spsc_capacity(&spsc));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_spsc_count(&spsc, NULL));
+    for (i = 0; i < TEST_SLOT_CAPACITY; ++i)
+    {
+        TEST_ASSERT_NULL(g_slots[i]);
+    }
+} /* test__ezq_spsc_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_spsc_init fails when asked for a capacity of
+ * \c 0 .
+ */
+static void
+test__ezq_spsc_init__zero_capacity__failure(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_init(&spsc, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(spsc.p_slots);
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_size);
+} /* test__ezq_spsc_init__zero_capacity__failure */
+
+/*!
+ * @brief Tests that \c ezq_spsc_init fails when the ring cannot be
+ * allocated.
+ */
+static void
+test__ezq_spsc_init__alloc_fail__failure(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY + 1,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+    TEST_ASSERT_NULL(spsc.p_slots);
+} /* test__ezq_spsc_init__alloc_fail__failure */
+
+/*!
+ * @brief Tests that items pushed with \c ezq_spsc_push are retrieved in
+ * order by \c ezq_spsc_pop , including once the ring has wrapped around.
+ */
+static void
+test__ezq_spsc_push_pop__wrapped__success(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    for (i = 1; i <= TEST_SLOT_CAPACITY * 3; ++i)
+    {
+        estat = ezq_spsc_push(&spsc, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_UINT32(1, ezq_spsc_count(&spsc, NULL));
+
+        estat = ezq_spsc_pop(&spsc, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_spsc_count(&spsc, NULL));
+} /* test__ezq_spsc_push_pop__wrapped__success */
+
+/*!
+ * @brief Tests that \c ezq_spsc_push fails once the ring is full.
+ */
+static void
+test__ezq_spsc_push__full__failure(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= TEST_SLOT_CAPACITY; ++i)
+    {
+        estat = ezq_spsc_push(&spsc, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_push(&spsc, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+    TEST_ASSERT_EQUAL_UINT32(
+        TEST_SLOT_CAPACITY,
+        ezq_spsc_count(&spsc, NULL)
+    );
+    TEST_ASSERT_EQUAL_PTR((void *)1, g_slots[0]);
+} /* test__ezq_spsc_push__full__failure */
+
+/*!
+ * @brief Tests that \c ezq_spsc_push fails when passed a \c NULL item.
+ */
+static void
+test__ezq_spsc_push__null_item__failure(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_push(&spsc, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+} /* test__ezq_spsc_push__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_spsc_pop fails when the queue is empty.
+ */
+static void
+test__ezq_spsc_pop__empty__failure(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = (void *)0xFF;
+
+    /* Set any initial state. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_pop(&spsc, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xFF, p_item);
+} /* test__ezq_spsc_pop__empty__failure */
+
+/*!
+ * @brief Tests that every item pushed by a producer thread is popped, in
+ * order, by a concurrently running consumer.
+ */
+static void
+test__ezq_spsc_pop__concurrent_producer__success(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producer;
+    void *p_item = NULL;
+    uintptr_t expected = 1;
+
+    /* Set any initial state. */
+    estat = ezq_spsc_init(&spsc, 1024, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        pthread_create(&producer, NULL, producer_thread, &spsc)
+    );
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    while (expected <= TEST_TRANSFER_COUNT)
+    {
+        if (EZQ_STATUS_SUCCESS == ezq_spsc_pop(&spsc, &p_item))
+        {
+            TEST_ASSERT_EQUAL_PTR((void *)expected, p_item);
+            ++expected;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(producer, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_spsc_count(&spsc, NULL));
+
+    estat = ezq_spsc_destroy(&spsc, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_spsc_pop__concurrent_producer__success */
+
+/*!
+ * @brief Tests that \c ezq_spsc_destroy invokes the cleanup function on
+ * each remaining item and releases the ring.
+ */
+static void
+test__ezq_spsc_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_spsc spsc = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_spsc_init(
+        &spsc,
+        TEST_SLOT_CAPACITY,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_SUCCESS,
+        ezq_spsc_push(&spsc, (void *)0xFF)
+    );
+    TEST_ASSERT_EQUAL_UINT8(
+        EZQ_STATUS_SUCCESS,
+        ezq_spsc_push(&spsc, (void *)0xFE)
+    );
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_destroy(&spsc, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(2, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+    TEST_ASSERT_NULL(spsc.p_slots);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_spsc_capacity(&spsc));
+} /* test__ezq_spsc_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Test that \c ezq_spsc_destroy fails when passed an \c ezq_spsc
+ * pointer that is \c NULL .
+ */
+static void
+test__ezq_spsc_destroy__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_spsc_destroy(NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_spsc_destroy__null_queue__failure */
+
+/*!
+ * @brief Runs all of the Easyqueue SPSC unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_spsc_init */
+    RUN_TEST(test__ezq_spsc_init__standard__success);
+    RUN_TEST(test__ezq_spsc_init__zero_capacity__failure);
+    RUN_TEST(test__ezq_spsc_init__alloc_fail__failure);
+
+    /* ezq_spsc_push / ezq_spsc_pop */
+    RUN_TEST(test__ezq_spsc_push_pop__wrapped__success);
+    RUN_TEST(test__ezq_spsc_push__full__failure);
+    RUN_TEST(test__ezq_spsc_push__null_item__failure);
+    RUN_TEST(test__ezq_spsc_pop__empty__failure);
+    RUN_TEST(test__ezq_spsc_pop__concurrent_producer__success);
+
+    /* ezq_spsc_destroy */
+    RUN_TEST(test__ezq_spsc_destroy__non_null_cleanup_fn__success);
+    RUN_TEST(test__ezq_spsc_destroy__null_queue__failure);
+
+    return UNITY_END();
+} /* main */
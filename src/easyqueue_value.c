@@ -0,0 +1,473 @@
+#include <assert.h>
+#include "easyqueue_value.h"
+
+#ifndef NULL
+ #define NULL ((void *)0)
+#endif /* NULL */
+
+/* A type whose alignment satisfies any element type. */
+union ezq_valign
+{
+    long l;
+    double d;
+    long double ld;
+    void *p;
+    void (*fn)(void);
+};
+
+/* Offset of the first element of a segment, past its aligned header. */
+#define EZQ_VSEGMENT_DATA_OFFSET \
+    ((sizeof(struct ezq_vsegment) + sizeof(union ezq_valign) - 1) \
+    / sizeof(union ezq_valign) * sizeof(union ezq_valign))
+
+/* Gets the address of the element at index i of a segment. */
+#define EZQ_VSEGMENT_ELEM(p_queue, p_seg, i) \
+    ((unsigned char *)(p_seg) + EZQ_VSEGMENT_DATA_OFFSET \
+    + (size_t)(i) * (p_queue)->elem_size)
+
+/* Gets the address of the element offset places behind the ring's front. */
+#define EZQ_VRING_ELEM(p_queue, offset) \
+    ((p_queue)->p_ring + (size_t)( \
+        (p_queue)->front_index + (offset) >= EZQ_FIXED_BUFFER_CAPACITY \
+        ? (p_queue)->front_index + (offset) - EZQ_FIXED_BUFFER_CAPACITY \
+        : (p_queue)->front_index + (offset) \
+    ) * (p_queue)->elem_size)
+
+/*!
+ * @brief Copies \c size bytes from \c p_src to \c p_dst .
+ *
+ * @param[out] p_dst Address to copy to.
+ * @param[in] p_src Address to copy from.
+ * @param[in] size Number of bytes to copy.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_vcopy(void * const p_dst, const void * const p_src, const size_t size);
+
+/*!
+ * @brief Appends an empty segment to the queue's list of segments, reusing
+ * the spare segment if there is one and allocating one otherwise.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue to extend.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if a segment was appended, otherwise
+ * \c EZQ_STATUS_ALLOC_FAILURE .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_vsegment_append(ezq_vqueue * const p_queue);
+
+/*!
+ * @brief Unlinks the empty front segment of the queue, keeping it as the
+ * spare segment if there is none and releasing it otherwise.
+ *
+ * @param[in,out] p_queue Address of an \c ezq_vqueue to retire the front
+ * segment of.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_vsegment_retire(ezq_vqueue * const p_queue);
+
+ezq_status EZQ_API
+ezq_vinit(
+    ezq_vqueue * const p_queue,
+    const size_t elem_size,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void * p_ring = NULL;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+    if (
+        0 == elem_size
+        || elem_size > (
+            (size_t)-1 - EZQ_VSEGMENT_DATA_OFFSET
+        ) / EZQ_LIST_NODE_CAPACITY
+        || elem_size > (size_t)-1 / EZQ_FIXED_BUFFER_CAPACITY
+    )
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    p_ring = alloc_fn(elem_size * EZQ_FIXED_BUFFER_CAPACITY);
+    if (NULL == p_ring)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+
+    p_queue->p_ring = (unsigned char *)p_ring;
+    p_queue->front_index = 0;
+    p_queue->count = 0;
+    p_queue->p_head = NULL;
+    p_queue->p_tail = NULL;
+    p_queue->p_spare = NULL;
+    p_queue->spilled = 0;
+    p_queue->capacity = capacity;
+    p_queue->elem_size = elem_size;
+    p_queue->alloc_fn = alloc_fn;
+    p_queue->free_fn = free_fn;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vinit */
+
+ezq_status EZQ_API
+ezq_vpush(ezq_vqueue * const p_queue, const void * const p_src)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_vsegment * p_tail = NULL;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_src)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+    if (
+        p_queue->capacity > 0
+        && p_queue->count + p_queue->spilled >= p_queue->capacity
+    )
+    {
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    /* Copy the element into the ring if it has room and nothing has spilled
+     * past it; otherwise copy it into the rear segment, appending a new one
+     * first if the rear segment is full.
+     * */
+    if (0 == p_queue->spilled && p_queue->count < EZQ_FIXED_BUFFER_CAPACITY)
+    {
+        ezq_vcopy(
+            EZQ_VRING_ELEM(p_queue, p_queue->count),
+            p_src,
+            p_queue->elem_size
+        );
+        ++p_queue->count;
+    }
+    else
+    {
+        p_tail = p_queue->p_tail;
+        if (
+            NULL == p_tail
+            || p_tail->front_index + p_tail->count >= EZQ_LIST_NODE_CAPACITY
+        )
+        {
+            estat = ezq_vsegment_append(p_queue);
+            if (EZQ_STATUS_SUCCESS != estat)
+            {
+                goto done;
+            }
+            p_tail = p_queue->p_tail;
+        }
+
+        ezq_vcopy(
+            EZQ_VSEGMENT_ELEM(
+                p_queue,
+                p_tail,
+                p_tail->front_index + p_tail->count
+            ),
+            p_src,
+            p_queue->elem_size
+        );
+        ++p_tail->count;
+        ++p_queue->spilled;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vpush */
+
+ezq_status EZQ_API
+ezq_vpop(ezq_vqueue * const p_queue, void * const p_dst)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_vsegment * p_head = NULL;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_dst)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    ezq_vcopy(p_dst, EZQ_VRING_ELEM(p_queue, 0), p_queue->elem_size);
+    p_queue->front_index = p_queue->front_index + 1 < EZQ_FIXED_BUFFER_CAPACITY
+        ? p_queue->front_index + 1 : 0;
+    --p_queue->count;
+
+    /* Move the front element of the segments to the back of the ring, so
+     * that the front element is always in the ring.
+     * */
+    if (p_queue->spilled > 0)
+    {
+        p_head = p_queue->p_head;
+        ezq_vcopy(
+            EZQ_VRING_ELEM(p_queue, p_queue->count),
+            EZQ_VSEGMENT_ELEM(p_queue, p_head, p_head->front_index),
+            p_queue->elem_size
+        );
+        ++p_queue->count;
+        ++p_head->front_index;
+        --p_head->count;
+        --p_queue->spilled;
+        if (0 == p_head->count)
+        {
+            ezq_vsegment_retire(p_queue);
+        }
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vpop */
+
+ezq_status EZQ_API
+ezq_vpeek(const ezq_vqueue * const p_queue, void ** const pp_elem)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_elem)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+    if (p_queue->count < 1)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    *pp_elem = p_queue->p_ring + (size_t)p_queue->front_index
+        * p_queue->elem_size;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vpeek */
+
+unsigned int EZQ_API
+ezq_vcount(const ezq_vqueue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    count = p_queue->count + p_queue->spilled;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_vcount */
+
+ezq_status EZQ_API
+ezq_vdestroy(
+    ezq_vqueue * const p_queue,
+    void (*elem_cleanup_fn)(void *p_elem, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_vsegment * p_seg = NULL;
+    unsigned int i = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_queue->free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    if (NULL != elem_cleanup_fn)
+    {
+        for (i = 0; i < p_queue->count; ++i)
+        {
+            elem_cleanup_fn(EZQ_VRING_ELEM(p_queue, i), p_args);
+        }
+    }
+
+    /* Release every segment, cleaning up the elements still in it. */
+    while (NULL != p_queue->p_head)
+    {
+        p_seg = p_queue->p_head;
+        p_queue->p_head = p_seg->p_next;
+        for (i = 0; NULL != elem_cleanup_fn && i < p_seg->count; ++i)
+        {
+            elem_cleanup_fn(
+                EZQ_VSEGMENT_ELEM(p_queue, p_seg, p_seg->front_index + i),
+                p_args
+            );
+        }
+        p_queue->free_fn(p_seg);
+    }
+    if (NULL != p_queue->p_spare)
+    {
+        p_queue->free_fn(p_queue->p_spare);
+    }
+    p_queue->free_fn(p_queue->p_ring);
+
+    p_queue->p_ring = NULL;
+    p_queue->front_index = 0;
+    p_queue->count = 0;
+    p_queue->p_tail = NULL;
+    p_queue->p_spare = NULL;
+    p_queue->spilled = 0;
+    p_queue->capacity = 0;
+    p_queue->elem_size = 0;
+    p_queue->alloc_fn = NULL;
+    p_queue->free_fn = NULL;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vdestroy */
+
+static void EZQ_API
+ezq_vcopy(void * const p_dst, const void * const p_src, const size_t size)
+{
+    unsigned char * p_out = (unsigned char *)p_dst;
+    const unsigned char * p_in = (const unsigned char *)p_src;
+    size_t i = 0;
+
+    assert(NULL != p_dst);
+    assert(NULL != p_src);
+
+    for (i = 0; i < size; ++i)
+    {
+        p_out[i] = p_in[i];
+    }
+} /* ezq_vcopy */
+
+static ezq_status EZQ_API
+ezq_vsegment_append(ezq_vqueue * const p_queue)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_vsegment * p_seg = NULL;
+
+    assert(NULL != p_queue);
+
+    p_seg = p_queue->p_spare;
+    if (NULL != p_seg)
+    {
+        p_queue->p_spare = NULL;
+    }
+    else
+    {
+        p_seg = (struct ezq_vsegment *)p_queue->alloc_fn(
+            EZQ_VSEGMENT_DATA_OFFSET
+            + p_queue->elem_size * EZQ_LIST_NODE_CAPACITY
+        );
+        if (NULL == p_seg)
+        {
+            estat = EZQ_STATUS_ALLOC_FAILURE;
+            goto done;
+        }
+    }
+
+    p_seg->p_next = NULL;
+    p_seg->front_index = 0;
+    p_seg->count = 0;
+    if (NULL == p_queue->p_tail)
+    {
+        p_queue->p_head = p_seg;
+    }
+    else
+    {
+        p_queue->p_tail->p_next = p_seg;
+    }
+    p_queue->p_tail = p_seg;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_vsegment_append */
+
+static void EZQ_API
+ezq_vsegment_retire(ezq_vqueue * const p_queue)
+{
+    struct ezq_vsegment * p_seg = NULL;
+
+    assert(NULL != p_queue);
+    assert(NULL != p_queue->p_head);
+    assert(0 == p_queue->p_head->count);
+
+    p_seg = p_queue->p_head;
+    p_queue->p_head = p_seg->p_next;
+    if (NULL == p_queue->p_head)
+    {
+        p_queue->p_tail = NULL;
+    }
+
+    if (NULL == p_queue->p_spare)
+    {
+        p_queue->p_spare = p_seg;
+    }
+    else
+    {
+        p_queue->free_fn(p_seg);
+    }
+} /* ezq_vsegment_retire */
@@ -0,0 +1,362 @@
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_value.h"
+
+/* Small by-value element of the kind an event queue carries. */
+struct test_event
+{
+    unsigned int id;
+    unsigned char payload[20];
+};
+
+size_t g_alloc_size; /* size last requested from custom_alloc_fn */
+unsigned int g_alloc_count; /* number of calls made to custom_alloc_fn */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global allocation counters.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_size = 0;
+    g_alloc_count = 0;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of calls made to it and allocates with
+ * \c malloc() .
+ *
+ * @param[in] size Number of bytes to allocate.
+ *
+ * @return The allocated address.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    g_alloc_size = size;
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases with
+ * \c free() .
+ *
+ * @param[in] ptr Address to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_elem UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_elem, void *p_args)
+{
+    (void)p_elem;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Builds a \c test_event whose fields are derived from \c id .
+ *
+ * @param[in] id Identifier of the event.
+ *
+ * @return The event.
+ */
+static struct test_event
+make_event(const unsigned int id)
+{
+    struct test_event event;
+    unsigned int i = 0;
+
+    event.id = id;
+    for (i = 0; i < sizeof(event.payload); ++i)
+    {
+        event.payload[i] = (unsigned char)(id + i);
+    }
+    return event;
+}
+
+/*!
+ * @brief Tests that \c ezq_vinit allocates a ring of
+ * \c EZQ_FIXED_BUFFER_CAPACITY elements.
+ */
+static void
+test__ezq_vinit__standard__success(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vinit(
+        &queue,
+        sizeof(struct test_event),
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_NOT_NULL(queue.p_ring);
+    TEST_ASSERT_EQUAL_UINT(
+        sizeof(struct test_event) * EZQ_FIXED_BUFFER_CAPACITY,
+        g_alloc_size
+    );
+    TEST_ASSERT_EQUAL_UINT(sizeof(struct test_event), queue.elem_size);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_vcount(&queue, NULL));
+
+    estat = ezq_vdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+} /* test__ezq_vinit__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_vinit fails when given an element size of
+ * \c 0 .
+ */
+static void
+test__ezq_vinit__zero_elem_size__failure(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vinit(&queue, 0, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(queue.p_ring);
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_vinit__zero_elem_size__failure */
+
+/*!
+ * @brief Tests that elements pushed past the ring into several segments
+ * are popped by value in order, and that emptied segments are retired.
+ */
+static void
+test__ezq_vpush_vpop__spilled__success(void)
+{
+    const unsigned int TEST_COUNT =
+        EZQ_FIXED_BUFFER_CAPACITY + EZQ_LIST_NODE_CAPACITY + 1;
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_event event;
+    struct test_event expected;
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_vinit(
+        &queue,
+        sizeof(struct test_event),
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the functions being tested and verify the expected outcome. */
+    for (i = 0; i < TEST_COUNT; ++i)
+    {
+        event = make_event(i);
+        estat = ezq_vpush(&queue, &event);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(TEST_COUNT, ezq_vcount(&queue, NULL));
+    TEST_ASSERT_EQUAL_UINT32(EZQ_FIXED_BUFFER_CAPACITY, queue.count);
+    TEST_ASSERT_EQUAL_UINT32(EZQ_LIST_NODE_CAPACITY + 1, queue.spilled);
+    TEST_ASSERT_EQUAL_UINT(3, g_alloc_count);
+    TEST_ASSERT_NOT_NULL(queue.p_head);
+    TEST_ASSERT_NOT_NULL(queue.p_head->p_next);
+
+    for (i = 0; i < TEST_COUNT; ++i)
+    {
+        estat = ezq_vpop(&queue, &event);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        expected = make_event(i);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &event, sizeof(event));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_vcount(&queue, NULL));
+    TEST_ASSERT_NULL(queue.p_head);
+    TEST_ASSERT_NULL(queue.p_tail);
+    TEST_ASSERT_NOT_NULL(queue.p_spare);
+    TEST_ASSERT_EQUAL_UINT(1, g_free_count);
+
+    estat = ezq_vdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_free_count);
+} /* test__ezq_vpush_vpop__spilled__success */
+
+/*!
+ * @brief Tests that \c ezq_vpush fails once the queue's capacity is
+ * reached.
+ */
+static void
+test__ezq_vpush__capacity_full__failure(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_event event = make_event(1);
+
+    /* Set any initial state. */
+    estat = ezq_vinit(
+        &queue,
+        sizeof(struct test_event),
+        1,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_vpush(&queue, &event);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vpush(&queue, &event);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_vcount(&queue, NULL));
+
+    estat = ezq_vdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_vpush__capacity_full__failure */
+
+/*!
+ * @brief Tests that \c ezq_vpeek gives the address of the front element
+ * in place, so that changes made through it are seen by \c ezq_vpop .
+ */
+static void
+test__ezq_vpeek__in_place__success(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_event event = make_event(1);
+    void *p_elem = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_vinit(
+        &queue,
+        sizeof(struct test_event),
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_vpush(&queue, &event);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vpeek(&queue, &p_elem);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(queue.p_ring, p_elem);
+    TEST_ASSERT_EQUAL_UINT32(1, ((struct test_event *)p_elem)->id);
+    ((struct test_event *)p_elem)->id = 2;
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_vcount(&queue, NULL));
+    estat = ezq_vpop(&queue, &event);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(2, event.id);
+
+    estat = ezq_vdestroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_vpeek__in_place__success */
+
+/*!
+ * @brief Tests that \c ezq_vpeek fails when the queue is empty.
+ */
+static void
+test__ezq_vpeek__empty__failure(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_elem = (void *)0xAA;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vpeek(&queue, &p_elem);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR(0xAA, p_elem);
+} /* test__ezq_vpeek__empty__failure */
+
+/*!
+ * @brief Tests that \c ezq_vdestroy invokes the cleanup function on each
+ * remaining element, in the ring and in segments, and releases all memory.
+ */
+static void
+test__ezq_vdestroy__non_null_cleanup_fn__success(void)
+{
+    ezq_vqueue queue = { 0 };
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct test_event event = make_event(1);
+    unsigned int i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_vinit(
+        &queue,
+        sizeof(struct test_event),
+        0,
+        custom_alloc_fn,
+        custom_free_fn
+    );
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 0; i < EZQ_FIXED_BUFFER_CAPACITY + 1; ++i)
+    {
+        estat = ezq_vpush(&queue, &event);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_vdestroy(&queue, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(EZQ_FIXED_BUFFER_CAPACITY + 1, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(g_alloc_count, g_free_count);
+    TEST_ASSERT_NULL(queue.p_ring);
+    TEST_ASSERT_NULL(queue.p_head);
+} /* test__ezq_vdestroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue by-value queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_vinit */
+    RUN_TEST(test__ezq_vinit__standard__success);
+    RUN_TEST(test__ezq_vinit__zero_elem_size__failure);
+
+    /* ezq_vpush / ezq_vpop */
+    RUN_TEST(test__ezq_vpush_vpop__spilled__success);
+    RUN_TEST(test__ezq_vpush__capacity_full__failure);
+
+    /* ezq_vpeek */
+    RUN_TEST(test__ezq_vpeek__in_place__success);
+    RUN_TEST(test__ezq_vpeek__empty__failure);
+
+    /* ezq_vdestroy */
+    RUN_TEST(test__ezq_vdestroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
@@ -0,0 +1,540 @@
+#define _GNU_SOURCE
+#include <assert.h>
+#include <sched.h>
+#include <time.h>
+#if defined(__linux__)
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif /* __linux__ */
+#include "easyqueue_wait.h"
+
+#define EZQ_NS_PER_SEC (1000000000ULL)
+
+/*!
+ * @brief Initializes an \c ezq_waiters structure such that no threads are
+ * waiting on it.
+ *
+ * @param[in,out] p_waiters Address of the \c ezq_waiters to initialize.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_waiters_init(struct ezq_waiters * const p_waiters);
+
+/*!
+ * @brief Parks the calling thread on \c p_waiters until it is woken, the
+ * sequence number of \c p_waiters no longer equals \c seq , or the
+ * monotonic clock reaches \c deadline .
+ *
+ * @param[in,out] p_waiters Address of the \c ezq_waiters to park on.
+ * @param[in] seq Sequence number read before the queue was last found not
+ * to be ready.
+ * @param[in] deadline Monotonic time in nanoseconds at which to stop
+ * waiting, or \c EZQ_WAIT_FOREVER .
+ *
+ * @return \c EZQ_STATUS_TIMEOUT if \c deadline had passed, otherwise
+ * \c EZQ_STATUS_SUCCESS (which may be spurious).
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_waiters_park(
+    struct ezq_waiters * const p_waiters,
+    const unsigned int seq,
+    const uint64_t deadline
+);
+
+/*!
+ * @brief Advances the sequence number of \c p_waiters and, only if a thread
+ * is parked on it, wakes one such thread.
+ *
+ * @param[in,out] p_waiters Address of the \c ezq_waiters to signal.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static void EZQ_API
+ezq_waiters_wake(struct ezq_waiters * const p_waiters);
+
+/*!
+ * @brief Makes a single locked attempt to push \c p_item onto, or (if
+ * \c pp_item is non- \c NULL ) pop an item off of, the queue, signalling the
+ * threads waiting on the opposite side if it succeeds. A push that makes
+ * the queue non-empty also signals the attached notifier, if any.
+ *
+ * @param[in,out] p_queue Address of the \c ezq_wait_queue to access.
+ * @param[in] p_item Item to push, when popping this is ignored.
+ * @param[out] pp_item Address in which to store a popped item, or \c NULL
+ * to push.
+ *
+ * @return The status of the underlying push or pop.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_wait_attempt(
+    ezq_wait_queue * const p_queue,
+    void * const p_item,
+    void ** const pp_item
+);
+
+/*!
+ * @brief Repeats \c ezq_wait_attempt() until it reports anything other than
+ * \c not_ready , spinning for up to the adaptive spin count of
+ * \c p_waiters and then parking on it until \c timeout_ns expires.
+ *
+ * @param[in,out] p_queue Address of the \c ezq_wait_queue to access.
+ * @param[in,out] p_waiters Waiters to park on while the queue is not ready.
+ * @param[in] not_ready Status reported while the queue is not ready.
+ * @param[in] p_item Item to push, when popping this is ignored.
+ * @param[out] pp_item Address in which to store a popped item, or \c NULL
+ * to push.
+ * @param[in] timeout_ns Maximum number of nanoseconds to wait.
+ *
+ * @return The status of the final attempt, or \c EZQ_STATUS_TIMEOUT .
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_wait_for(
+    ezq_wait_queue * const p_queue,
+    struct ezq_waiters * const p_waiters,
+    const ezq_status not_ready,
+    void * const p_item,
+    void ** const pp_item,
+    const uint64_t timeout_ns
+);
+
+/*!
+ * @brief Gets the current time of the monotonic clock.
+ *
+ * @return Nanoseconds elapsed since an arbitrary fixed point.
+ */
+static uint64_t EZQ_API
+ezq_wait_now(void);
+
+/*!
+ * @brief Hints to the processor that the calling thread is spinning.
+ */
+static inline void
+ezq_wait_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+} /* ezq_wait_relax */
+
+ezq_status EZQ_API
+ezq_wait_init(
+    ezq_wait_queue * const p_queue,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    estat = ezq_init(&p_queue->queue, capacity, alloc_fn, free_fn);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+    if (0 != pthread_mutex_init(&p_queue->lock, NULL))
+    {
+        (void)ezq_destroy(&p_queue->queue, NULL, NULL);
+        estat = EZQ_STATUS_UNKNOWN;
+        goto done;
+    }
+    p_queue->p_notifier = NULL;
+    ezq_waiters_init(&p_queue->not_empty);
+    ezq_waiters_init(&p_queue->not_full);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wait_init */
+
+unsigned int EZQ_API
+ezq_wait_count(ezq_wait_queue * const p_queue, ezq_status * const p_status)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    (void)pthread_mutex_lock(&p_queue->lock);
+    count = ezq_count(&p_queue->queue, &estat);
+    (void)pthread_mutex_unlock(&p_queue->lock);
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_wait_count */
+
+ezq_status EZQ_API
+ezq_wait_set_notifier(
+    ezq_wait_queue * const p_queue,
+    ezq_notifier * const p_notifier
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    (void)pthread_mutex_lock(&p_queue->lock);
+    p_queue->p_notifier = p_notifier;
+    count = ezq_count(&p_queue->queue, NULL);
+    (void)pthread_mutex_unlock(&p_queue->lock);
+
+    estat = EZQ_STATUS_SUCCESS;
+    if (NULL != p_notifier && count > 0)
+    {
+        estat = ezq_notifier_signal(p_notifier);
+    }
+
+done:
+    return estat;
+} /* ezq_wait_set_notifier */
+
+ezq_status EZQ_API
+ezq_push_wait(
+    ezq_wait_queue * const p_queue,
+    void * const p_item,
+    const uint64_t timeout_ns
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    estat = ezq_wait_for(
+        p_queue,
+        &p_queue->not_full,
+        EZQ_STATUS_FULL,
+        p_item,
+        NULL,
+        timeout_ns
+    );
+
+done:
+    return estat;
+} /* ezq_push_wait */
+
+ezq_status EZQ_API
+ezq_pop_wait(
+    ezq_wait_queue * const p_queue,
+    void ** const pp_item,
+    const uint64_t timeout_ns
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    estat = ezq_wait_for(
+        p_queue,
+        &p_queue->not_empty,
+        EZQ_STATUS_EMPTY,
+        NULL,
+        pp_item,
+        timeout_ns
+    );
+
+done:
+    return estat;
+} /* ezq_pop_wait */
+
+ezq_status EZQ_API
+ezq_wait_destroy(
+    ezq_wait_queue * const p_queue,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    if (NULL == p_queue)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    estat = ezq_destroy(&p_queue->queue, item_cleanup_fn, p_args);
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+    (void)pthread_mutex_destroy(&p_queue->lock);
+
+done:
+    return estat;
+} /* ezq_wait_destroy */
+
+static void EZQ_API
+ezq_waiters_init(struct ezq_waiters * const p_waiters)
+{
+    assert(NULL != p_waiters);
+
+    atomic_init(&p_waiters->seq, 0);
+    atomic_init(&p_waiters->parked, 0);
+    atomic_init(&p_waiters->spin, EZQ_WAIT_SPIN_LIMIT);
+} /* ezq_waiters_init */
+
+static ezq_status EZQ_API
+ezq_waiters_park(
+    struct ezq_waiters * const p_waiters,
+    const unsigned int seq,
+    const uint64_t deadline
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t now = 0;
+#if defined(__linux__)
+    struct timespec timeout = { 0 };
+#endif /* __linux__ */
+
+    assert(NULL != p_waiters);
+
+    if (EZQ_WAIT_FOREVER != deadline)
+    {
+        now = ezq_wait_now();
+        if (now >= deadline)
+        {
+            estat = EZQ_STATUS_TIMEOUT;
+            goto done;
+        }
+    }
+
+    /* Advertising this thread before parking pairs with the sequence
+     * number being advanced before the count is read in ezq_waiters_wake():
+     * either the waker sees this thread and wakes it, or the kernel sees
+     * the new sequence number and does not park it.
+     * */
+    (void)atomic_fetch_add(&p_waiters->parked, 1);
+#if defined(__linux__)
+    if (EZQ_WAIT_FOREVER != deadline)
+    {
+        timeout.tv_sec = (time_t)((deadline - now) / EZQ_NS_PER_SEC);
+        timeout.tv_nsec = (long)((deadline - now) % EZQ_NS_PER_SEC);
+    }
+    (void)syscall(
+        SYS_futex,
+        (void *)&p_waiters->seq,
+        FUTEX_WAIT_PRIVATE,
+        seq,
+        EZQ_WAIT_FOREVER != deadline ? &timeout : NULL,
+        NULL,
+        0
+    );
+#else
+    /* Without futexes, yielding the processor is the closest equivalent. */
+    (void)seq;
+    (void)sched_yield();
+#endif /* __linux__ */
+    (void)atomic_fetch_sub(&p_waiters->parked, 1);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_waiters_park */
+
+static void EZQ_API
+ezq_waiters_wake(struct ezq_waiters * const p_waiters)
+{
+    assert(NULL != p_waiters);
+
+    (void)atomic_fetch_add(&p_waiters->seq, 1);
+    if (0 == atomic_load(&p_waiters->parked))
+    {
+        return;
+    }
+#if defined(__linux__)
+    (void)syscall(
+        SYS_futex,
+        (void *)&p_waiters->seq,
+        FUTEX_WAKE_PRIVATE,
+        1,
+        NULL,
+        NULL,
+        0
+    );
+#endif /* __linux__ */
+} /* ezq_waiters_wake */
+
+static ezq_status EZQ_API
+ezq_wait_attempt(
+    ezq_wait_queue * const p_queue,
+    void * const p_item,
+    void ** const pp_item
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    ezq_notifier * p_notifier = NULL;
+
+    assert(NULL != p_queue);
+
+    (void)pthread_mutex_lock(&p_queue->lock);
+    if (NULL != pp_item)
+    {
+        estat = ezq_pop(&p_queue->queue, pp_item);
+    }
+    else
+    {
+        /* Only a push onto an empty queue needs to reach the notifier. */
+        if (0 == ezq_count(&p_queue->queue, NULL))
+        {
+            p_notifier = p_queue->p_notifier;
+        }
+        estat = ezq_push(&p_queue->queue, p_item);
+    }
+    (void)pthread_mutex_unlock(&p_queue->lock);
+
+    if (EZQ_STATUS_SUCCESS == estat)
+    {
+        ezq_waiters_wake(NULL == pp_item
+            ? &p_queue->not_empty
+            : &p_queue->not_full);
+        if (NULL != p_notifier)
+        {
+            (void)ezq_notifier_signal(p_notifier);
+        }
+    }
+
+    return estat;
+} /* ezq_wait_attempt */
+
+static ezq_status EZQ_API
+ezq_wait_for(
+    ezq_wait_queue * const p_queue,
+    struct ezq_waiters * const p_waiters,
+    const ezq_status not_ready,
+    void * const p_item,
+    void ** const pp_item,
+    const uint64_t timeout_ns
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t deadline = EZQ_WAIT_FOREVER;
+    unsigned int seq = 0;
+    unsigned int spin = 0;
+    unsigned int spins = 0;
+    int parked = 0;
+
+    assert(NULL != p_queue);
+    assert(NULL != p_waiters);
+
+    /* Reading the sequence number before each attempt ensures that a change
+     * made after a failed attempt is never slept through.
+     * */
+    seq = atomic_load(&p_waiters->seq);
+    estat = ezq_wait_attempt(p_queue, p_item, pp_item);
+    if (not_ready != estat || 0 == timeout_ns)
+    {
+        goto done;
+    }
+
+    if (EZQ_WAIT_FOREVER != timeout_ns)
+    {
+        deadline = ezq_wait_now();
+        deadline = timeout_ns < EZQ_WAIT_FOREVER - deadline
+            ? deadline + timeout_ns
+            : EZQ_WAIT_FOREVER;
+    }
+
+    spin = atomic_load_explicit(&p_waiters->spin, memory_order_relaxed);
+    for (;;)
+    {
+        if (spins < spin)
+        {
+            ++spins;
+            ezq_wait_relax();
+        }
+        else
+        {
+            estat = ezq_waiters_park(p_waiters, seq, deadline);
+            if (EZQ_STATUS_TIMEOUT == estat)
+            {
+                break;
+            }
+            parked = 1;
+        }
+
+        seq = atomic_load(&p_waiters->seq);
+        estat = ezq_wait_attempt(p_queue, p_item, pp_item);
+        if (not_ready != estat)
+        {
+            break;
+        }
+    }
+
+    /* Spin for longer next time if spinning paid off, and for less time if
+     * this thread had to park anyway.
+     * */
+    if (!parked && EZQ_STATUS_SUCCESS == estat)
+    {
+        spin = spin < EZQ_WAIT_SPIN_LIMIT / 2 ? spin * 2 : EZQ_WAIT_SPIN_LIMIT;
+    }
+    else if (parked)
+    {
+        spin = spin > 1 ? spin / 2 : 1;
+    }
+    atomic_store_explicit(&p_waiters->spin, spin, memory_order_relaxed);
+
+done:
+    return estat;
+} /* ezq_wait_for */
+
+static uint64_t EZQ_API
+ezq_wait_now(void)
+{
+    struct timespec now = { 0 };
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * EZQ_NS_PER_SEC + (uint64_t)now.tv_nsec;
+} /* ezq_wait_now */
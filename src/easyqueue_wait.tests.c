@@ -0,0 +1,480 @@
+#define _GNU_SOURCE
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unity/unity.h>
+#include "easyqueue_wait.h"
+
+#define TEST_CAPACITY (4)
+#define TEST_TIMEOUT_NS (2000000u)
+#define TEST_TRANSFER_COUNT (20000u)
+
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/*!
+ * @brief Resets the global cleanup counter.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Gets the current time of the monotonic clock.
+ *
+ * @return Nanoseconds elapsed since an arbitrary fixed point.
+ */
+static uint64_t
+now_ns(void)
+{
+    struct timespec now = { 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/*!
+ * @brief Checks whether the passed descriptor is readable without waiting.
+ *
+ * @param[in] fd Descriptor to check.
+ *
+ * @return Non-zero if \c fd is readable.
+ */
+static int
+is_readable(const int fd)
+{
+    struct pollfd pfd = { 0 };
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    return 1 == poll(&pfd, 1, 0) && (pfd.revents & POLLIN);
+}
+
+/*!
+ * @brief Pushes the values \c 1 through \c TEST_TRANSFER_COUNT onto the
+ * passed queue, waiting whenever the queue is full.
+ *
+ * @param[in,out] p_arg Address of an \c ezq_wait_queue to push onto.
+ *
+ * @return \c NULL , or the address of the value that failed to be pushed.
+ */
+static void *
+producer_thread(void *p_arg)
+{
+    ezq_wait_queue *p_queue = p_arg;
+    uintptr_t next = 0;
+
+    for (next = 1; next <= TEST_TRANSFER_COUNT; ++next)
+    {
+        if (EZQ_STATUS_SUCCESS
+            != ezq_push_wait(p_queue, (void *)next, EZQ_WAIT_FOREVER))
+        {
+            return (void *)next;
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_wait_init initializes an empty queue with no
+ * parked threads.
+ */
+static void
+test__ezq_wait_init__standard__success(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wait_count(&queue, NULL));
+    TEST_ASSERT_EQUAL_UINT32(TEST_CAPACITY, queue.queue.capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_empty.parked));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_full.parked));
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_WAIT_SPIN_LIMIT,
+        atomic_load(&queue.not_empty.spin)
+    );
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wait_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_wait_init fails when given a \c NULL queue.
+ */
+static void
+test__ezq_wait_init__null_queue__failure(void)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wait_init(NULL, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_QUEUE, estat);
+} /* test__ezq_wait_init__null_queue__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop_wait with a timeout of \c 0 reports an
+ * empty queue without waiting.
+ */
+static void
+test__ezq_pop_wait__zero_timeout__failure(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = (void *)0xAA;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_pop_wait(&queue, &p_item, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xAA, p_item);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_empty.seq));
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_WAIT_SPIN_LIMIT,
+        atomic_load(&queue.not_empty.spin)
+    );
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_pop_wait__zero_timeout__failure */
+
+/*!
+ * @brief Tests that \c ezq_pop_wait gives up once the queue has stayed
+ * empty for the whole timeout, and shortens its spin afterwards.
+ */
+static void
+test__ezq_pop_wait__timeout__failure(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = (void *)0xAA;
+    uint64_t start = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    start = now_ns();
+    estat = ezq_pop_wait(&queue, &p_item, TEST_TIMEOUT_NS);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_TIMEOUT, estat);
+    TEST_ASSERT_TRUE(now_ns() - start >= TEST_TIMEOUT_NS);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_empty.parked));
+    TEST_ASSERT_EQUAL_UINT32(
+        EZQ_WAIT_SPIN_LIMIT > 1 ? EZQ_WAIT_SPIN_LIMIT / 2 : 1,
+        atomic_load(&queue.not_empty.spin)
+    );
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xAA, p_item);
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_pop_wait__timeout__failure */
+
+/*!
+ * @brief Tests that every item pushed by a producer thread that waits
+ * while the queue is full is retrieved in order by a consumer that waits
+ * while the queue is empty.
+ */
+static void
+test__ezq_pop_wait__concurrent_producer__success(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t producer;
+    void *p_result = (void *)0xAA;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_INT(
+        0,
+        pthread_create(&producer, NULL, producer_thread, &queue)
+    );
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        estat = ezq_pop_wait(&queue, &p_item, EZQ_WAIT_FOREVER);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(producer, &p_result));
+    TEST_ASSERT_NULL(p_result);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wait_count(&queue, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_empty.parked));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_full.parked));
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_pop_wait__concurrent_producer__success */
+
+/*!
+ * @brief Tests that \c ezq_push_wait with a timeout of \c 0 reports a full
+ * queue without waiting.
+ */
+static void
+test__ezq_push_wait__zero_timeout__failure(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= TEST_CAPACITY; ++i)
+    {
+        estat = ezq_push_wait(&queue, (void *)i, 0);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_wait(&queue, (void *)0xFF, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_FULL, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(TEST_CAPACITY, ezq_wait_count(&queue, NULL));
+    TEST_ASSERT_EQUAL_UINT32(
+        TEST_CAPACITY,
+        atomic_load(&queue.not_empty.seq)
+    );
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_push_wait__zero_timeout__failure */
+
+/*!
+ * @brief Tests that \c ezq_push_wait gives up once the queue has stayed
+ * full for the whole timeout.
+ */
+static void
+test__ezq_push_wait__timeout__failure(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uint64_t start = 0;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= TEST_CAPACITY; ++i)
+    {
+        estat = ezq_push_wait(&queue, (void *)i, 0);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    start = now_ns();
+    estat = ezq_push_wait(&queue, (void *)0xFF, TEST_TIMEOUT_NS);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_TIMEOUT, estat);
+    TEST_ASSERT_TRUE(now_ns() - start >= TEST_TIMEOUT_NS);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&queue.not_full.parked));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(TEST_CAPACITY, ezq_wait_count(&queue, NULL));
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_push_wait__timeout__failure */
+
+/*!
+ * @brief Tests that \c ezq_push_wait fails when given a \c NULL item.
+ */
+static void
+test__ezq_push_wait__null_item__failure(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_push_wait(&queue, NULL, EZQ_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wait_count(&queue, NULL));
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_push_wait__null_item__failure */
+
+/*!
+ * @brief Tests that an attached notifier is signalled once by a burst of
+ * pushes onto an empty queue, and again once the queue has been drained and
+ * refilled.
+ */
+static void
+test__ezq_wait_set_notifier__burst__success(void)
+{
+    ezq_wait_queue queue;
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wait_set_notifier(&queue, &notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR(&notifier, queue.p_notifier);
+    TEST_ASSERT_FALSE(is_readable(ezq_notifier_fd(&notifier)));
+
+    for (i = 1; i <= TEST_CAPACITY; ++i)
+    {
+        estat = ezq_push_wait(&queue, (void *)i, 0);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_TRUE(is_readable(ezq_notifier_fd(&notifier)));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&notifier.armed));
+
+    estat = ezq_notifier_ack(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    while (EZQ_STATUS_SUCCESS == ezq_pop_wait(&queue, &p_item, 0))
+    {
+    }
+    TEST_ASSERT_FALSE(is_readable(ezq_notifier_fd(&notifier)));
+
+    estat = ezq_push_wait(&queue, (void *)0xFF, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(is_readable(ezq_notifier_fd(&notifier)));
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wait_set_notifier__burst__success */
+
+/*!
+ * @brief Tests that attaching a notifier to a non-empty queue signals it
+ * immediately.
+ */
+static void
+test__ezq_wait_set_notifier__non_empty__success(void)
+{
+    ezq_wait_queue queue;
+    ezq_notifier notifier;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_notifier_init(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_push_wait(&queue, (void *)0xFF, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wait_set_notifier(&queue, &notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_TRUE(is_readable(ezq_notifier_fd(&notifier)));
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_wait_count(&queue, NULL));
+
+    estat = ezq_wait_destroy(&queue, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_notifier_destroy(&notifier);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wait_set_notifier__non_empty__success */
+
+/*!
+ * @brief Tests that \c ezq_wait_destroy invokes the cleanup function on
+ * each remaining item.
+ */
+static void
+test__ezq_wait_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_wait_queue queue;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_wait_init(&queue, TEST_CAPACITY, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_push_wait(&queue, (void *)0xFF, 0);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wait_destroy(&queue, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(1, g_cleanup_count);
+} /* test__ezq_wait_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue waiting queue unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_wait_init */
+    RUN_TEST(test__ezq_wait_init__standard__success);
+    RUN_TEST(test__ezq_wait_init__null_queue__failure);
+
+    /* ezq_pop_wait */
+    RUN_TEST(test__ezq_pop_wait__zero_timeout__failure);
+    RUN_TEST(test__ezq_pop_wait__timeout__failure);
+    RUN_TEST(test__ezq_pop_wait__concurrent_producer__success);
+
+    /* ezq_push_wait */
+    RUN_TEST(test__ezq_push_wait__zero_timeout__failure);
+    RUN_TEST(test__ezq_push_wait__timeout__failure);
+    RUN_TEST(test__ezq_push_wait__null_item__failure);
+
+    /* ezq_wait_set_notifier */
+    RUN_TEST(test__ezq_wait_set_notifier__burst__success);
+    RUN_TEST(test__ezq_wait_set_notifier__non_empty__success);
+
+    /* ezq_wait_destroy */
+    RUN_TEST(test__ezq_wait_destroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */
@@ -0,0 +1,563 @@
+#include "easyqueue_wsdeque.h"
+#include "easyqueue_ring.h"
+
+/*!
+ * @brief Allocates an array of \c slot_capacity empty slots.
+ *
+ * @param[in] alloc_fn Function used to allocate the array.
+ * @param[in] slot_capacity Number of slots in the array. Must be a power of
+ * two.
+ * @param[out] pp_array Address in which to store the allocated array.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the array is allocated, otherwise an
+ * error-specific \c ezq_status value.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds.
+ */
+static ezq_status EZQ_API
+ezq_wsdeque_alloc(
+    void *(*alloc_fn)(const size_t size),
+    const unsigned int slot_capacity,
+    struct ezq_wsdeque_array ** const pp_array
+);
+
+/*!
+ * @brief Replaces the deque's array with one of twice its capacity holding
+ * the same items, retiring the old array.
+ *
+ * @param[in,out] p_deque Address of the \c ezq_wsdeque whose array to grow.
+ * @param[in] p_array The deque's current array.
+ * @param[in] top Index of the oldest item to keep.
+ * @param[in] bottom Index one past the newest item to keep.
+ * @param[out] pp_grown Address in which to store the new array.
+ *
+ * @return \c EZQ_STATUS_SUCCESS if the array is grown, \c EZQ_STATUS_FULL if
+ * it cannot grow any further, otherwise an error-specific \c ezq_status
+ * value.
+ *
+ * @note This function performs no safety checks (e.g. checks for
+ * \c NULL ) on its passed arguments in release builds, and may only be
+ * called by the deque's owner.
+ */
+static ezq_status EZQ_API
+ezq_wsdeque_grow(
+    ezq_wsdeque * const p_deque,
+    struct ezq_wsdeque_array * const p_array,
+    const unsigned int top,
+    const unsigned int bottom,
+    struct ezq_wsdeque_array ** const pp_grown
+);
+
+ezq_status EZQ_API
+ezq_wsdeque_init(
+    ezq_wsdeque * const p_deque,
+    const unsigned int capacity,
+    void *(*alloc_fn)(const size_t size),
+    void (*free_fn)(void * const ptr)
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (0 == capacity || capacity > EZQ_RING_MAX_CAPACITY)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+    if (NULL == alloc_fn)
+    {
+        estat = EZQ_STATUS_NO_ALLOC_FN;
+        goto done;
+    }
+    if (NULL == free_fn)
+    {
+        estat = EZQ_STATUS_NO_FREE_FN;
+        goto done;
+    }
+
+    estat = ezq_wsdeque_alloc(
+        alloc_fn,
+        ezq_ring_round_pow2(capacity),
+        &p_array
+    );
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+    p_array->p_retired = NULL;
+
+    p_deque->alloc_fn = alloc_fn;
+    p_deque->free_fn = free_fn;
+    atomic_init(&p_deque->bottom, 0);
+    atomic_init(&p_deque->p_array, p_array);
+    atomic_init(&p_deque->top, 0);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wsdeque_init */
+
+unsigned int EZQ_API
+ezq_wsdeque_capacity(const ezq_wsdeque * const p_deque)
+{
+    struct ezq_wsdeque_array * p_array = NULL;
+
+    if (NULL != p_deque)
+    {
+        p_array = atomic_load_explicit(
+            &p_deque->p_array,
+            memory_order_acquire
+        );
+    }
+
+    return NULL == p_array ? 0 : p_array->mask + 1;
+} /* ezq_wsdeque_capacity */
+
+unsigned int EZQ_API
+ezq_wsdeque_count(
+    const ezq_wsdeque * const p_deque,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int top = 0;
+    unsigned int bottom = 0;
+    unsigned int count = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    /* The owner briefly moves the bottom below the top while popping from
+     * an empty deque, so a negative difference counts as empty.
+     * */
+    top = atomic_load_explicit(&p_deque->top, memory_order_acquire);
+    bottom = atomic_load_explicit(&p_deque->bottom, memory_order_acquire);
+    count = (int)(bottom - top) > 0 ? bottom - top : 0;
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return count;
+} /* ezq_wsdeque_count */
+
+ezq_status EZQ_API
+ezq_wsdeque_push(ezq_wsdeque * const p_deque, void * const p_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+    unsigned int bottom = 0;
+    unsigned int top = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == p_item)
+    {
+        estat = EZQ_STATUS_NULL_ITEM;
+        goto done;
+    }
+
+    /* Only the owner writes the bottom and the array, so both can be read
+     * relaxed. The acquire load of the top ensures thieves have finished
+     * reading any slot about to be reused.
+     * */
+    bottom = atomic_load_explicit(&p_deque->bottom, memory_order_relaxed);
+    top = atomic_load_explicit(&p_deque->top, memory_order_acquire);
+    p_array = atomic_load_explicit(&p_deque->p_array, memory_order_relaxed);
+    if (bottom - top > p_array->mask)
+    {
+        estat = ezq_wsdeque_grow(p_deque, p_array, top, bottom, &p_array);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            goto done;
+        }
+    }
+
+    /* The release store publishes the item before thieves can see the new
+     * bottom.
+     * */
+    atomic_store_explicit(
+        &p_array->slots[bottom & p_array->mask],
+        p_item,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(&p_deque->bottom, bottom + 1, memory_order_release);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wsdeque_push */
+
+ezq_status EZQ_API
+ezq_wsdeque_pop(ezq_wsdeque * const p_deque, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+    void * p_item = NULL;
+    unsigned int bottom = 0;
+    unsigned int top = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Reserve the bottom item before looking at the top. The sequentially
+     * consistent fence pairs with the one in ezq_wsdeque_steal, so that
+     * either the owner sees a thief's claim on the item or the thief sees
+     * the reservation; only when a single item remains can both claim it.
+     * */
+    bottom = atomic_load_explicit(&p_deque->bottom, memory_order_relaxed) - 1;
+    p_array = atomic_load_explicit(&p_deque->p_array, memory_order_relaxed);
+    atomic_store_explicit(&p_deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&p_deque->top, memory_order_relaxed);
+
+    if ((int)(bottom - top) < 0)
+    {
+        atomic_store_explicit(
+            &p_deque->bottom,
+            bottom + 1,
+            memory_order_relaxed
+        );
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    p_item = atomic_load_explicit(
+        &p_array->slots[bottom & p_array->mask],
+        memory_order_relaxed
+    );
+    estat = EZQ_STATUS_SUCCESS;
+    if (bottom == top)
+    {
+        /* Race any thieves for the last item by claiming it from the top,
+         * leaving the deque empty either way.
+         * */
+        if (
+            !atomic_compare_exchange_strong_explicit(
+                &p_deque->top,
+                &top,
+                top + 1,
+                memory_order_seq_cst,
+                memory_order_relaxed
+            )
+        )
+        {
+            estat = EZQ_STATUS_EMPTY;
+        }
+        atomic_store_explicit(
+            &p_deque->bottom,
+            bottom + 1,
+            memory_order_relaxed
+        );
+    }
+
+    if (EZQ_STATUS_SUCCESS == estat)
+    {
+        *pp_item = p_item;
+    }
+
+done:
+    return estat;
+} /* ezq_wsdeque_pop */
+
+ezq_status EZQ_API
+ezq_wsdeque_steal(ezq_wsdeque * const p_deque, void ** const pp_item)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+    void * p_item = NULL;
+    unsigned int top = 0;
+    unsigned int bottom = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_item)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* The acquire load of the bottom pairs with the release store in
+     * ezq_wsdeque_push, making visible both the item and any array it was
+     * placed in. The item is read before it is claimed, as the owner may
+     * reuse its slot as soon as the top moves past it.
+     * */
+    top = atomic_load_explicit(&p_deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&p_deque->bottom, memory_order_acquire);
+    if ((int)(bottom - top) <= 0)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+
+    p_array = atomic_load_explicit(&p_deque->p_array, memory_order_acquire);
+    p_item = atomic_load_explicit(
+        &p_array->slots[top & p_array->mask],
+        memory_order_relaxed
+    );
+    if (
+        !atomic_compare_exchange_strong_explicit(
+            &p_deque->top,
+            &top,
+            top + 1,
+            memory_order_seq_cst,
+            memory_order_relaxed
+        )
+    )
+    {
+        estat = EZQ_STATUS_BUSY;
+        goto done;
+    }
+
+    *pp_item = p_item;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wsdeque_steal */
+
+unsigned int EZQ_API
+ezq_wsdeque_steal_half(
+    ezq_wsdeque * const p_deque,
+    void ** const pp_items,
+    const unsigned int max,
+    ezq_status * const p_status
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    unsigned int count = 0;
+    unsigned int limit = 0;
+    unsigned int stolen = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+    if (NULL == pp_items && max > 0)
+    {
+        estat = EZQ_STATUS_NULL_OUT;
+        goto done;
+    }
+
+    /* Claiming the whole run with one compare-and-swap on the top would
+     * let the owner pop an item inside the run without noticing, so the
+     * run is sized once and then stolen an item at a time.
+     * */
+    count = ezq_wsdeque_count(p_deque, NULL);
+    if (0 == count)
+    {
+        estat = EZQ_STATUS_EMPTY;
+        goto done;
+    }
+    limit = count - count / 2;
+    if (limit > max)
+    {
+        limit = max;
+    }
+
+    estat = EZQ_STATUS_SUCCESS;
+    while (stolen < limit)
+    {
+        estat = ezq_wsdeque_steal(p_deque, &pp_items[stolen]);
+        if (EZQ_STATUS_SUCCESS != estat)
+        {
+            break;
+        }
+        ++stolen;
+    }
+
+done:
+    if (NULL != p_status)
+    {
+        *p_status = estat;
+    }
+    return stolen;
+} /* ezq_wsdeque_steal_half */
+
+ezq_status EZQ_API
+ezq_wsdeque_destroy(
+    ezq_wsdeque * const p_deque,
+    void (*item_cleanup_fn)(void *p_item, void *p_args),
+    void * const p_args
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+    struct ezq_wsdeque_array * p_retired = NULL;
+    unsigned int top = 0;
+    unsigned int bottom = 0;
+
+    if (NULL == p_deque)
+    {
+        estat = EZQ_STATUS_NULL_QUEUE;
+        goto done;
+    }
+
+    p_array = atomic_load_explicit(&p_deque->p_array, memory_order_acquire);
+    if (NULL != p_array)
+    {
+        top = atomic_load_explicit(&p_deque->top, memory_order_acquire);
+        bottom = atomic_load_explicit(&p_deque->bottom, memory_order_acquire);
+        for (; (int)(bottom - top) > 0; ++top)
+        {
+            if (NULL != item_cleanup_fn)
+            {
+                item_cleanup_fn(
+                    atomic_load_explicit(
+                        &p_array->slots[top & p_array->mask],
+                        memory_order_relaxed
+                    ),
+                    p_args
+                );
+            }
+        }
+
+        while (NULL != p_array)
+        {
+            p_retired = p_array->p_retired;
+            p_deque->free_fn(p_array);
+            p_array = p_retired;
+        }
+    }
+
+    p_deque->alloc_fn = NULL;
+    p_deque->free_fn = NULL;
+    atomic_store_explicit(&p_deque->bottom, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_deque->p_array, NULL, memory_order_relaxed);
+    atomic_store_explicit(&p_deque->top, 0, memory_order_relaxed);
+
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wsdeque_destroy */
+
+static ezq_status EZQ_API
+ezq_wsdeque_alloc(
+    void *(*alloc_fn)(const size_t size),
+    const unsigned int slot_capacity,
+    struct ezq_wsdeque_array ** const pp_array
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_array = NULL;
+    size_t size = 0;
+    unsigned int i = 0;
+
+    assert(NULL != alloc_fn);
+    assert(slot_capacity > 0);
+    assert(0 == (slot_capacity & (slot_capacity - 1)));
+    assert(NULL != pp_array);
+
+    size = (size_t)slot_capacity * sizeof(p_array->slots[0]);
+    if (size / sizeof(p_array->slots[0]) != slot_capacity
+        || size + sizeof(*p_array) < size)
+    {
+        estat = EZQ_STATUS_INVALID_CAPACITY;
+        goto done;
+    }
+
+    p_array = alloc_fn(size + sizeof(*p_array));
+    if (NULL == p_array)
+    {
+        estat = EZQ_STATUS_ALLOC_FAILURE;
+        goto done;
+    }
+    p_array->mask = slot_capacity - 1;
+    for (i = 0; i < slot_capacity; ++i)
+    {
+        atomic_init(&p_array->slots[i], NULL);
+    }
+
+    *pp_array = p_array;
+    estat = EZQ_STATUS_SUCCESS;
+
+done:
+    return estat;
+} /* ezq_wsdeque_alloc */
+
+static ezq_status EZQ_API
+ezq_wsdeque_grow(
+    ezq_wsdeque * const p_deque,
+    struct ezq_wsdeque_array * const p_array,
+    const unsigned int top,
+    const unsigned int bottom,
+    struct ezq_wsdeque_array ** const pp_grown
+)
+{
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    struct ezq_wsdeque_array * p_grown = NULL;
+    unsigned int i = 0;
+
+    assert(NULL != p_deque);
+    assert(NULL != p_array);
+    assert(NULL != pp_grown);
+
+    if (p_array->mask >= EZQ_RING_MAX_CAPACITY - 1)
+    {
+        estat = EZQ_STATUS_FULL;
+        goto done;
+    }
+
+    estat = ezq_wsdeque_alloc(
+        p_deque->alloc_fn,
+        (p_array->mask + 1) * 2,
+        &p_grown
+    );
+    if (EZQ_STATUS_SUCCESS != estat)
+    {
+        goto done;
+    }
+
+    /* Thieves that already loaded the old array may still read from it,
+     * so it is retired rather than released, and the items keep their
+     * indices so that either array yields the same item for a given top.
+     * */
+    for (i = top; i != bottom; ++i)
+    {
+        atomic_init(
+            &p_grown->slots[i & p_grown->mask],
+            atomic_load_explicit(
+                &p_array->slots[i & p_array->mask],
+                memory_order_relaxed
+            )
+        );
+    }
+    p_grown->p_retired = p_array;
+    atomic_store_explicit(&p_deque->p_array, p_grown, memory_order_release);
+
+    *pp_grown = p_grown;
+
+done:
+    return estat;
+} /* ezq_wsdeque_grow */
@@ -0,0 +1,576 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity/unity.h>
+#include "easyqueue_wsdeque.h"
+
+#define TEST_THIEF_COUNT (3)
+#define TEST_TRANSFER_COUNT (100000u)
+
+unsigned int g_alloc_count; /* number of arrays handed out */
+unsigned int g_alloc_limit; /* number of arrays to hand out before failing */
+unsigned int g_free_count; /* number of calls made to custom_free_fn */
+unsigned int g_cleanup_count; /* number of calls made to custom_cleanup_fn */
+
+/* number of times each value was taken from the deque by any thread */
+atomic_uchar g_taken[TEST_TRANSFER_COUNT + 1];
+
+/*!
+ * @brief Resets the global dummy allocation state.
+ *
+ * @note This function's implementation (regardless of what it actually does)
+ * is required by the Unity test framework.
+ */
+void setUp(void)
+{
+    g_alloc_count = 0;
+    g_alloc_limit = 0xFFFFFFFFu;
+    g_free_count = 0;
+    g_cleanup_count = 0;
+}
+
+void tearDown(void) { } /* UNUSED; required definition for Unity tests */
+
+/*!
+ * @brief Allocates memory with \c malloc until \c g_alloc_limit arrays
+ * have been handed out.
+ *
+ * @param[in] size Number of bytes requested.
+ *
+ * @return The allocated memory, or \c NULL once the limit is reached.
+ */
+static void *
+custom_alloc_fn(const size_t size)
+{
+    if (g_alloc_count >= g_alloc_limit)
+    {
+        return NULL;
+    }
+    ++g_alloc_count;
+    return malloc(size);
+}
+
+/*!
+ * @brief Counts the number of calls made to it and releases \c ptr .
+ *
+ * @param[in] ptr Memory to release.
+ */
+static void
+custom_free_fn(void * const ptr)
+{
+    ++g_free_count;
+    free(ptr);
+}
+
+/*!
+ * @brief Counts the number of calls made to it.
+ *
+ * @param[in] p_item UNUSED
+ * @param[in] p_args UNUSED
+ */
+static void
+custom_cleanup_fn(void *p_item, void *p_args)
+{
+    (void)p_item;
+    (void)p_args;
+    ++g_cleanup_count;
+}
+
+/*!
+ * @brief Records that the passed value was taken from the deque.
+ *
+ * @param[in] p_item Value taken from the deque.
+ */
+static void
+record_taken(void *p_item)
+{
+    atomic_fetch_add(&g_taken[(uintptr_t)p_item], 1);
+}
+
+/*!
+ * @struct thief_args
+ * @brief Structure describing the work of a \c thief_thread .
+ */
+struct thief_args
+{
+    ezq_wsdeque *p_deque; /* deque to steal from */
+    atomic_int *p_done; /* non-zero once the owner has finished */
+};
+
+/*!
+ * @brief Steals items from the passed deque, alternating between single
+ * steals and steals of half the deque, until the owner has finished and the
+ * deque is empty.
+ *
+ * @param[in,out] p_arg Address of a \c thief_args structure.
+ *
+ * @return \c NULL
+ */
+static void *
+thief_thread(void *p_arg)
+{
+    struct thief_args *p_args = p_arg;
+    void *items[8] = { NULL };
+    unsigned int stolen = 0;
+    unsigned int round = 0;
+    unsigned int i = 0;
+
+    for (;;)
+    {
+        if (++round % 2)
+        {
+            stolen = EZQ_STATUS_SUCCESS
+                == ezq_wsdeque_steal(p_args->p_deque, &items[0]) ? 1 : 0;
+        }
+        else
+        {
+            stolen = ezq_wsdeque_steal_half(p_args->p_deque, items, 8, NULL);
+        }
+        for (i = 0; i < stolen; ++i)
+        {
+            record_taken(items[i]);
+        }
+        if (0 == stolen)
+        {
+            if (atomic_load(p_args->p_done)
+                && 0 == ezq_wsdeque_count(p_args->p_deque, NULL))
+            {
+                break;
+            }
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_init rounds the capacity up to a power
+ * of two and leaves the deque empty.
+ */
+static void
+test__ezq_wsdeque_init__standard__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wsdeque_init(&deque, 3, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(4, ezq_wsdeque_capacity(&deque));
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_count(&deque, NULL));
+    TEST_ASSERT_EQUAL_UINT(1, g_alloc_count);
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_init__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_init fails when asked for a capacity of
+ * \c 0 .
+ */
+static void
+test__ezq_wsdeque_init__zero_capacity__failure(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wsdeque_init(&deque, 0, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_INVALID_CAPACITY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT(0, g_alloc_count);
+} /* test__ezq_wsdeque_init__zero_capacity__failure */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_pop retrieves the most recently pushed
+ * item first and reports when the deque is empty.
+ */
+static void
+test__ezq_wsdeque_pop__lifo__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 4, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 4; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 4; i >= 1; --i)
+    {
+        estat = ezq_wsdeque_pop(&deque, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    p_item = (void *)0xFF;
+    estat = ezq_wsdeque_pop(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_PTR((void *)0xFF, p_item);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_count(&deque, NULL));
+    TEST_ASSERT_EQUAL_UINT32(4, ezq_wsdeque_capacity(&deque));
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_pop__lifo__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_push grows a full, wrapped array while
+ * keeping every item in place for both ends of the deque.
+ */
+static void
+test__ezq_wsdeque_push__grow__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. One item is stolen so that the items wrap
+     * around the end of the array before it grows.
+     * */
+    estat = ezq_wsdeque_init(&deque, 2, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_wsdeque_push(&deque, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_wsdeque_steal(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= 5; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, ezq_wsdeque_capacity(&deque));
+    TEST_ASSERT_EQUAL_UINT32(5, ezq_wsdeque_count(&deque, NULL));
+    TEST_ASSERT_EQUAL_UINT(3, g_alloc_count);
+
+    estat = ezq_wsdeque_steal(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR((void *)1, p_item);
+    for (i = 5; i >= 2; --i)
+    {
+        estat = ezq_wsdeque_pop(&deque, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+
+    /* Validate that nothing else was unexpectedly modified. The outgrown
+     * arrays are only released along with the deque.
+     * */
+    TEST_ASSERT_EQUAL_UINT(0, g_free_count);
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_free_count);
+} /* test__ezq_wsdeque_push__grow__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_push fails without placing the item
+ * when a full array cannot be grown.
+ */
+static void
+test__ezq_wsdeque_push__alloc_failure__failure(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 1, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    estat = ezq_wsdeque_push(&deque, (void *)0xFF);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    g_alloc_limit = g_alloc_count;
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wsdeque_push(&deque, (void *)0xFE);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_ALLOC_FAILURE, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_wsdeque_count(&deque, NULL));
+    TEST_ASSERT_EQUAL_UINT32(1, ezq_wsdeque_capacity(&deque));
+    estat = ezq_wsdeque_pop(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_PTR((void *)0xFF, p_item);
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_push__alloc_failure__failure */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_push refuses a \c NULL item.
+ */
+static void
+test__ezq_wsdeque_push__null_item__failure(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 4, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wsdeque_push(&deque, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_NULL_ITEM, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_count(&deque, NULL));
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_push__null_item__failure */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_steal retrieves the oldest item first
+ * and reports when the deque is empty.
+ */
+static void
+test__ezq_wsdeque_steal__fifo__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 4, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 3; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    for (i = 1; i <= 3; ++i)
+    {
+        estat = ezq_wsdeque_steal(&deque, &p_item);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        TEST_ASSERT_EQUAL_PTR((void *)i, p_item);
+    }
+    estat = ezq_wsdeque_steal(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    estat = ezq_wsdeque_pop(&deque, &p_item);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_count(&deque, NULL));
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_steal__fifo__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_steal_half takes the older half of the
+ * items, rounded up, and no more than the passed maximum.
+ */
+static void
+test__ezq_wsdeque_steal_half__standard__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[8] = { NULL };
+    unsigned int stolen = 0;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 8, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 7; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    stolen = ezq_wsdeque_steal_half(&deque, items, 8, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(4, stolen);
+    for (i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(i + 1), items[i]);
+    }
+
+    stolen = ezq_wsdeque_steal_half(&deque, items, 1, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT32(1, stolen);
+    TEST_ASSERT_EQUAL_PTR((void *)5, items[0]);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_EQUAL_UINT32(2, ezq_wsdeque_count(&deque, NULL));
+    TEST_ASSERT_EQUAL_PTR((void *)2, items[1]);
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_steal_half__standard__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_steal_half steals nothing from an empty
+ * deque.
+ */
+static void
+test__ezq_wsdeque_steal_half__empty__failure(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    void *items[2] = { NULL };
+    unsigned int stolen = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 4, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    stolen = ezq_wsdeque_steal_half(&deque, items, 2, &estat);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_EMPTY, estat);
+    TEST_ASSERT_EQUAL_UINT32(0, stolen);
+
+    /* Validate that nothing else was unexpectedly modified. */
+    TEST_ASSERT_NULL(items[0]);
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_steal_half__empty__failure */
+
+/*!
+ * @brief Tests that every item pushed by the owner is taken exactly once,
+ * either by the owner's own pops or by concurrently running thieves, while
+ * the deque's array grows from a single slot.
+ */
+static void
+test__ezq_wsdeque_steal__concurrent_thieves__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    pthread_t thieves[TEST_THIEF_COUNT];
+    struct thief_args args;
+    atomic_int done;
+    void *p_item = NULL;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 1, malloc, free);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    atomic_init(&done, 0);
+    for (i = 0; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        atomic_init(&g_taken[i], 0);
+    }
+    args.p_deque = &deque;
+    args.p_done = &done;
+    for (i = 0; i < TEST_THIEF_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(
+            0,
+            pthread_create(&thieves[i], NULL, thief_thread, &args)
+        );
+    }
+
+    /* Invoke the functions being tested and verify the expected outcome.
+     * The owner pops one item for every three it pushes, so that it races
+     * the thieves for the last item as well as growing the array.
+     * */
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+        if (0 == i % 3
+            && EZQ_STATUS_SUCCESS == ezq_wsdeque_pop(&deque, &p_item))
+        {
+            record_taken(p_item);
+        }
+    }
+    while (EZQ_STATUS_SUCCESS == ezq_wsdeque_pop(&deque, &p_item))
+    {
+        record_taken(p_item);
+    }
+    atomic_store(&done, 1);
+    for (i = 0; i < TEST_THIEF_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(thieves[i], NULL));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_count(&deque, NULL));
+    for (i = 1; i <= TEST_TRANSFER_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT8(1, atomic_load(&g_taken[i]));
+    }
+
+    estat = ezq_wsdeque_destroy(&deque, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+} /* test__ezq_wsdeque_steal__concurrent_thieves__success */
+
+/*!
+ * @brief Tests that \c ezq_wsdeque_destroy invokes the cleanup function on
+ * each remaining item and releases every array.
+ */
+static void
+test__ezq_wsdeque_destroy__non_null_cleanup_fn__success(void)
+{
+    ezq_wsdeque deque;
+    ezq_status estat = EZQ_STATUS_UNKNOWN;
+    uintptr_t i = 0;
+
+    /* Set any initial state. */
+    estat = ezq_wsdeque_init(&deque, 2, custom_alloc_fn, custom_free_fn);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    for (i = 1; i <= 3; ++i)
+    {
+        estat = ezq_wsdeque_push(&deque, (void *)i);
+        TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    }
+
+    /* Invoke the function being tested and verify the expected outcome. */
+    estat = ezq_wsdeque_destroy(&deque, custom_cleanup_fn, NULL);
+    TEST_ASSERT_EQUAL_UINT8(EZQ_STATUS_SUCCESS, estat);
+    TEST_ASSERT_EQUAL_UINT(3, g_cleanup_count);
+    TEST_ASSERT_EQUAL_UINT(2, g_free_count);
+    TEST_ASSERT_EQUAL_UINT32(0, ezq_wsdeque_capacity(&deque));
+} /* test__ezq_wsdeque_destroy__non_null_cleanup_fn__success */
+
+/*!
+ * @brief Runs all of the Easyqueue work-stealing deque unit tests.
+ *
+ * @param[in] argc UNUSED
+ * @param[in] argv UNUSED
+ *
+ * @return \c 0 if all tests are successful, otherwise the number of tests
+ * that failed.
+ */
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    /* ezq_wsdeque_init */
+    RUN_TEST(test__ezq_wsdeque_init__standard__success);
+    RUN_TEST(test__ezq_wsdeque_init__zero_capacity__failure);
+
+    /* ezq_wsdeque_push / ezq_wsdeque_pop */
+    RUN_TEST(test__ezq_wsdeque_pop__lifo__success);
+    RUN_TEST(test__ezq_wsdeque_push__grow__success);
+    RUN_TEST(test__ezq_wsdeque_push__alloc_failure__failure);
+    RUN_TEST(test__ezq_wsdeque_push__null_item__failure);
+
+    /* ezq_wsdeque_steal / ezq_wsdeque_steal_half */
+    RUN_TEST(test__ezq_wsdeque_steal__fifo__success);
+    RUN_TEST(test__ezq_wsdeque_steal_half__standard__success);
+    RUN_TEST(test__ezq_wsdeque_steal_half__empty__failure);
+    RUN_TEST(test__ezq_wsdeque_steal__concurrent_thieves__success);
+
+    /* ezq_wsdeque_destroy */
+    RUN_TEST(test__ezq_wsdeque_destroy__non_null_cleanup_fn__success);
+
+    return UNITY_END();
+} /* main */